@@ -4,6 +4,9 @@
 //  This module provides functions for creating a data model suitable for representing a JSON file. The base type
 //  JlDataObject* represents a data object tree. It may contain a single data type such as a string or number, or
 //  a dictionary or list which contains other data objects.
+//  A tree from a parse with JL_PARSE_FLAGS_LAZY, JL_PARSE_FLAGS_RAW_NUMBERS, or JL_PARSE_FLAGS_RAW_STRINGS is changed
+//  by the getters below the first time each value is read, even though they take const objects. Reading such a tree
+//  from more than one thread at a time is not safe.
 //
 //  This is free and unencumbered software released into the public domain - November 2019 waterjuice.org
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -93,6 +96,34 @@ JL_STATUS
         char const*     String
     );
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlSetObjectStringTakeOwnership
+//
+//  Sets the value of a string object using a string that was allocated with JlAlloc. The object takes ownership of
+//  String rather than making a copy of it, it will be freed along with the object. If this fails then String is
+//  still owned by the caller.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlSetObjectStringTakeOwnership
+    (
+        JlDataObject*   StringObject,
+        char*           String
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlSetObjectStringReference
+//
+//  Sets the value of a string object to point at String without copying it. String is not freed with the object, the
+//  caller must keep it valid and unchanged for as long as the object holds it. This is used for in-situ parsing where
+//  the strings are left in the caller's JSON buffer.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlSetObjectStringReference
+    (
+        JlDataObject*   StringObject,
+        char const*     String
+    );
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  JlSetObjectNumberU64
 //
@@ -179,6 +210,35 @@ JL_STATUS
         JlDataObject*   NewObject
     );
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlAttachObjectToDictionaryObjectTakeKey
+//
+//  Same as JlAttachObjectToDictionaryObject except KeyName must have been allocated with JlAlloc. The dictionary takes
+//  ownership of KeyName rather than making a copy of it. If this fails then KeyName is still owned by the caller.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlAttachObjectToDictionaryObjectTakeKey
+    (
+        JlDataObject*   DictionaryObject,
+        char*           KeyName,
+        JlDataObject*   NewObject
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlAttachObjectToDictionaryObjectReferenceKey
+//
+//  Same as JlAttachObjectToDictionaryObject except the dictionary points at KeyName rather than making a copy of it.
+//  KeyName is not freed with the dictionary, the caller must keep it valid and unchanged for as long as the item is in
+//  the dictionary.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlAttachObjectToDictionaryObjectReferenceKey
+    (
+        JlDataObject*   DictionaryObject,
+        char const*     KeyName,
+        JlDataObject*   NewObject
+    );
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  JlDetachObjectFromDictionaryObject
 //
@@ -218,7 +278,8 @@ size_t
 //  JlGetObjectString
 //
 //  Gets the string from a String object. This returns the pointer of the internal string and must not be modified.
-//  Returns JL_STATUS_WRONG_TYPE if the object is not a string object
+//  Returns JL_STATUS_WRONG_TYPE if the object is not a string object. A string from a parse with
+//  JL_PARSE_FLAGS_RAW_STRINGS is unescaped the first time it is read, which can return JL_STATUS_OUT_OF_MEMORY.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 JL_STATUS
     JlGetObjectString
@@ -269,7 +330,10 @@ JL_STATUS
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  JlSetObjectNumberString
 //
-//  Sets the value of a number object from a string
+//  Sets the value of a number object from a string. The string must be a decimal number (with optional sign, decimal
+//  point, and exponent), a hex number starting 0x, or inf, +inf, -inf, or nan. Decimal numbers are stored as unsigned
+//  or signed integers if written as plain integers that fit, otherwise as the nearest double. Hex numbers must fit in
+//  a uint64_t.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 JL_STATUS
     JlSetObjectNumberString
@@ -313,6 +377,22 @@ JL_NUM_TYPE
         JlDataObject const*     NumberObject
     );
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlGetObjectNumberText
+//
+//  Gets the original text of a number object from a parse with JL_PARSE_FLAGS_RAW_NUMBERS. The text points into the
+//  buffer that was parsed and is not zero terminated. Returns JL_STATUS_NOT_FOUND if the number has no text, because
+//  it was not parsed that way, its text was not kept, or it has been set since. Returns JL_STATUS_WRONG_TYPE if the
+//  object is not a number.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlGetObjectNumberText
+    (
+        JlDataObject const*     NumberObject,
+        char const**            pText,
+        size_t*                 pTextLength
+    );
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  JlGetObjectListNextItem
 //
@@ -0,0 +1,385 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JsonLib
+//
+//  This module provides a reusable JSON parser object. The one shot functions JlParseJson, JlParseJsonEx, and
+//  JlParseJsonBuffer set up a parser for each call. When parsing a large number of documents a JlParser can be
+//  created once (per thread) and used for each of them. The parser keeps its parse stack and scratch buffers between
+//  documents so that after the first few parses the only allocations made are for the returned object tree.
+//  A parser can also be given a document in pieces as it arrives (for example from a socket) with JlParserFeed and
+//  JlParserFinish, without needing to collect the whole document into one buffer first.
+//  A buffer holding a series of documents, such as NDJSON, can be parsed one document at a time with
+//  JlParserParseNextDocument.
+//
+//  This is free and unencumbered software released into the public domain - November 2019 waterjuice.org
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  IMPORTS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "JlStatus.h"
+#include "JlDataModel.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TYPES
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The flags control the parsing. If no flags are set then strict Json1 parsing is done.
+// JL_PARSE_FLAGS_LAZY, JL_PARSE_FLAGS_RAW_NUMBERS, and JL_PARSE_FLAGS_RAW_STRINGS only apply to the functions that
+// parse a whole buffer into a tree: JlParserParse, JlParserParseInSitu, JlParserParseKeys, JlParserParseNextDocument,
+// and JlParserParseWithBudget. They are ignored by JlParserFeed and JlParserParseEvents. A tree parsed with any of
+// them is finished off as it is read: the getters in JlDataModel.h change the objects the first time they are used,
+// even though they take const objects. Such a tree must not be read by more than one thread at a time.
+typedef uint64_t JL_PARSE_FLAGS;
+#define JL_PARSE_FLAGS_NONE                     ((JL_PARSE_FLAGS) 0x0 )
+#define JL_PARSE_FLAGS_JSON5                    ((JL_PARSE_FLAGS) 0x1 )
+// Lists and dictionaries below the root are not parsed until they are first used. See JlParseJsonLazy in JsonLib.h.
+#define JL_PARSE_FLAGS_LAZY                     ((JL_PARSE_FLAGS) 0x2 )
+// Plain decimal numbers keep their text from the input and are only converted when their value is first read. They
+// are written out exactly as they were in the input. The input buffer must not be changed or freed while the tree is
+// in use. Numbers with an exponent or a leading zero, Json5 forms such as hex, and numbers in lazily parsed lists and
+// dictionaries are converted as normal.
+#define JL_PARSE_FLAGS_RAW_NUMBERS              ((JL_PARSE_FLAGS) 0x4 )
+// Strings are checked but not unescaped, each keeps its span of the input and is only unescaped when it is first read
+// with JlGetObjectString. A string that has not been read is written out by JlOutputJson as it was in the input when
+// the output flags allow it. The input buffer must not be changed or freed while the tree is in use. Strings in
+// lazily parsed lists and dictionaries are unescaped as normal. This has no effect on JlParserParseInSitu, which
+// already leaves strings in the buffer.
+#define JL_PARSE_FLAGS_RAW_STRINGS              ((JL_PARSE_FLAGS) 0x8 )
+
+// Maximum number of paths that can be given to JlParserSetProjection
+#define JL_MAX_PROJECTION_PATHS                 64
+
+// Limits on what a single document may build, set with JlParserSetLimits. A limit of 0 means there is no limit.
+typedef struct
+{
+    size_t          MaxBytes;               // Approximate memory allocated for the object tree
+    size_t          MaxValues;              // Values of all types, including lists and dictionaries
+    size_t          MaxStringLength;        // Bytes in a string or key name once escapes are processed
+    size_t          MaxItems;               // Values in any one list or dictionary
+} JlParseLimits;
+
+typedef struct JlParser JlParser;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JL_PARSE_EVENT_FUNCTION
+//
+//  Called for events that have no value: the start and end of dictionaries and lists, and null. Offset is the position
+//  in the input of the bracket or null keyword.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef
+JL_STATUS
+    (*JL_PARSE_EVENT_FUNCTION)
+    (
+        void*           Context,
+        size_t          Offset
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JL_PARSE_TEXT_EVENT_FUNCTION
+//
+//  Called for dictionary keys, strings, and numbers. Text is TextLength bytes and is also zero terminated. For keys
+//  and strings the escape sequences have been processed (\u0000 becomes the two bytes 0xc0 0x80 as in the rest of
+//  JsonLib). For numbers Text is the number as written in the JSON (without any leading + allowed by Json5). Text is
+//  only valid for the duration of the call. Offset is the position in the input of the start of the token.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef
+JL_STATUS
+    (*JL_PARSE_TEXT_EVENT_FUNCTION)
+    (
+        void*           Context,
+        char const*     Text,
+        size_t          TextLength,
+        size_t          Offset
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JL_PARSE_BOOL_EVENT_FUNCTION
+//
+//  Called for true and false. Offset is the position in the input of the keyword.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef
+JL_STATUS
+    (*JL_PARSE_BOOL_EVENT_FUNCTION)
+    (
+        void*           Context,
+        bool            Value,
+        size_t          Offset
+    );
+
+// Set of functions called by JlParserParseEvents as the JSON is read. Any of them may be NULL if the event is not
+// wanted. If a function returns anything other than JL_STATUS_SUCCESS then parsing stops and that status is returned.
+typedef struct
+{
+    JL_PARSE_EVENT_FUNCTION         OnBeginDictionary;
+    JL_PARSE_EVENT_FUNCTION         OnEndDictionary;
+    JL_PARSE_EVENT_FUNCTION         OnBeginList;
+    JL_PARSE_EVENT_FUNCTION         OnEndList;
+    JL_PARSE_TEXT_EVENT_FUNCTION    OnKey;
+    JL_PARSE_TEXT_EVENT_FUNCTION    OnString;
+    JL_PARSE_TEXT_EVENT_FUNCTION    OnNumber;
+    JL_PARSE_BOOL_EVENT_FUNCTION    OnBool;
+    JL_PARSE_EVENT_FUNCTION         OnNull;
+} JlParseCallbacks;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserCreate
+//
+//  Creates a parser that can be used repeatedly with JlParserParse. The parser owns its parse stack and the scratch
+//  buffers used for unescaping strings and numbers, these are kept between parses so that once they have grown to
+//  fit the data being parsed no further allocations are made other than for the returned object tree.
+//  A parser must only be used by one thread at a time. Free with JlParserFree.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserCreate
+    (
+        JL_PARSE_FLAGS  ParseFlags,
+        JlParser**      pParser
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserFree
+//
+//  Frees a parser created with JlParserCreate. *pParser will be set to NULL. Any partially parsed document from
+//  JlParserFeed is discarded.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserFree
+    (
+        JlParser**      pParser
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserParse
+//
+//  Parses JSON in a buffer of JsonBufferLength bytes using Parser and returns a JlDataObject representing it. The
+//  buffer does not need to be zero terminated. This behaves the same as JlParseJsonBuffer except that the parsing is
+//  done with the parser's buffers. Whether JSON5 is accepted is set by the flags the parser was created with.
+//  If an error occurs (other than JL_STATUS_INVALID_PARAMETER) then *pErrorAtPos will be set with the position
+//  within JsonBuffer where the error occurred. pErrorAtPos is an OPTIONAL parameter.
+//  Any partially fed document from JlParserFeed is discarded.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserParse
+    (
+        JlParser*       Parser,
+        char const*     JsonBuffer,
+        size_t          JsonBufferLength,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos         // OPTIONAL
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserParseInSitu
+//
+//  Same as JlParserParse except that JsonBuffer is writable and is used to hold the strings of the returned tree. Each
+//  quoted string and key name is unescaped in place and zero terminated where its closing quote was, and the tree
+//  points at it instead of allocating a copy. JsonBuffer must stay valid and must not be changed until the tree has
+//  been freed with JlFreeObjectTree. The contents of JsonBuffer are undefined after a failed parse.
+//  Json5 bare key names are still allocated.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserParseInSitu
+    (
+        JlParser*       Parser,
+        char*           JsonBuffer,
+        size_t          JsonBufferLength,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos         // OPTIONAL
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserSetProjection
+//
+//  Sets the values that JlParserParse and JlParserParseInSitu put in the returned tree. Paths is an array of NumPaths
+//  JSON Pointers (RFC 6901), for example "/user/id". A reference token of * matches every key of a dictionary or
+//  every item of a list, so "/items/*/price" keeps the price of each item. The empty pointer "" keeps everything.
+//  A value is kept if a path ends at it, along with everything below it, and the lists and dictionaries leading to it
+//  are kept holding only what the paths reach. Everything else is moved over by matching brackets and quotes: no
+//  objects are created, strings are not unescaped, and numbers are not converted. Within skipped values only
+//  unmatched brackets, unterminated strings, and nesting that is too deep are found, and repeated keys are not found.
+//  Up to JL_MAX_PROJECTION_PATHS paths can be set. The projection stays set for each parse until it is replaced.
+//  Setting NumPaths to 0 removes it. Returns JL_STATUS_INVALID_PARAMETER if any path is not a valid JSON Pointer, in
+//  which case the parser is left with no projection. Feeding and event parsing are not affected.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserSetProjection
+    (
+        JlParser*           Parser,
+        char const* const*  Paths,              // OPTIONAL if NumPaths is 0
+        size_t              NumPaths
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserSetLimits
+//
+//  Sets limits on the size of each document parsed, replacing any set before. They guard against input crafted to
+//  use a lot of memory, such as a huge list of zeros. Parsing stops with JL_STATUS_LIMIT_EXCEEDED, and the error
+//  position set to the value that went over the limit, as soon as one is passed so the rest of the input is not
+//  read. The values are counted as they are found, so this applies to all parsing with the parser including feeding
+//  and events. MaxBytes only counts the objects and strings of the tree being built, and is approximate as the size
+//  of an object depends on the platform. Lists and dictionaries left unparsed by JL_PARSE_FLAGS_LAZY count as one
+//  value each and are not limited when they are parsed later. Passing NULL for Limits removes them.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserSetLimits
+    (
+        JlParser*               Parser,
+        JlParseLimits const*    Limits          // OPTIONAL
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserParseKeys
+//
+//  Parses only as much of the JSON in JsonBuffer as is needed to find the NumKeyNames keys in KeyNames in the root
+//  dictionary, and returns a dictionary holding just those keys and their values. Parsing stops straight after the
+//  value of the last of them to appear: the rest of the document is not read or checked, and *pAmountConsumed is set
+//  to the number of bytes that were read. The values of other keys before then are skipped over as for
+//  JlParserSetProjection. If some of the keys are not there then the whole document is read and *pAmountConsumed is
+//  set to JsonBufferLength. If the root is not a dictionary then none of the keys can be found.
+//  The key names are matched exactly, they are not JSON Pointers. Between 1 and JL_MAX_PROJECTION_PATHS keys may be
+//  given. Any projection set with JlParserSetProjection is not used for this parse.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserParseKeys
+    (
+        JlParser*           Parser,
+        char const*         JsonBuffer,
+        size_t              JsonBufferLength,
+        char const* const*  KeyNames,
+        size_t              NumKeyNames,
+        JlDataObject**      pRootObject,
+        size_t*             pAmountConsumed,    // OPTIONAL
+        size_t*             pErrorAtPos         // OPTIONAL
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserParseNextDocument
+//
+//  Parses one document from a buffer holding a series of them, such as NDJSON (one document per line) or documents
+//  simply placed one after another. Parsing starts at *pOffset, which should be 0 for the first call, and on success
+//  *pOffset is moved to just after the document so the next call parses the one after it. The parser's buffers are
+//  reused for each document, as are its flags and any projection set with JlParserSetProjection.
+//  Returns JL_STATUS_END_OF_DATA, with *pRootObject set to NULL and *pOffset set to JsonBufferLength, when there is
+//  nothing but white space (and Json5 comments) left. On any other error *pOffset is not changed and *pErrorAtPos is
+//  set with the position of the error within JsonBuffer. A last document that is incomplete returns
+//  JL_STATUS_INVALID_DATA. To skip a bad line of NDJSON, move *pOffset past the next newline and carry on.
+//  As documents are read from the one buffer, a document that is split over two reads of a file must be completed
+//  before calling this (for NDJSON, pass the buffer only up to its last newline).
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserParseNextDocument
+    (
+        JlParser*       Parser,
+        char const*     JsonBuffer,
+        size_t          JsonBufferLength,
+        size_t*         pOffset,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos         // OPTIONAL
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserParseWithBudget
+//
+//  Parses JSON in a buffer the same as JlParserParse, but a piece at a time so that a large document does not hold up
+//  the caller for long. Each call parses about ByteBudget more bytes and then returns JL_STATUS_IN_PROGRESS, with the
+//  state kept in the parser. Calling again with the same JsonBuffer and JsonBufferLength carries on from where it
+//  stopped. The buffer must not be changed until the document is complete. Once it is, the object tree or error is
+//  returned as JlParserParse would. A single value (such as a long string) is always parsed in one go, and a lazy
+//  list or dictionary is moved over in one go, so a call can go past the budget by the length of that value.
+//  Calling with a different buffer starts a new document, discarding the unfinished one, as does any other parse call
+//  or JlParserReset.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserParseWithBudget
+    (
+        JlParser*       Parser,
+        char const*     JsonBuffer,
+        size_t          JsonBufferLength,
+        size_t          ByteBudget,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos         // OPTIONAL
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserReset
+//
+//  Discards any partially parsed document and input held from JlParserFeed so the parser is ready for a new
+//  document. This does not need to be called after JlParserFinish or JlParserParse.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserReset
+    (
+        JlParser*       Parser
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserFeed
+//
+//  Gives the next ChunkLength bytes of a JSON document to the parser. The document can be split at any point, including
+//  in the middle of a string, number, escape sequence, or comment. As much as possible is parsed straight from Chunk,
+//  only an incomplete token at the end of the chunk is copied and held until the next call. Chunk does not need to
+//  remain valid after the call returns. Call JlParserFinish after the last chunk to get the object tree.
+//  If the data is found to be invalid the error is returned and will continue to be returned by further calls to
+//  JlParserFeed and JlParserFinish until the parser is reset. *pErrorAtPos will be set with the position of the error
+//  counted from the start of the first chunk. pErrorAtPos is an OPTIONAL parameter.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserFeed
+    (
+        JlParser*       Parser,
+        char const*     Chunk,
+        size_t          ChunkLength,
+        size_t*         pErrorAtPos         // OPTIONAL
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserFinish
+//
+//  Completes a document given to the parser with JlParserFeed and returns a JlDataObject representing it. This
+//  returns the same result as JlParserParse would have done with the whole document in one buffer. If no chunks were
+//  fed then this is the same as parsing an empty buffer.
+//  If an error occurs (other than JL_STATUS_INVALID_PARAMETER) then *pErrorAtPos will be set with the position
+//  of the error counted from the start of the first chunk. pErrorAtPos is an OPTIONAL parameter.
+//  The parser is reset afterwards and can be used for another document.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserFinish
+    (
+        JlParser*       Parser,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos         // OPTIONAL
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserParseEvents
+//
+//  Parses JSON in a buffer of JsonBufferLength bytes using Parser, calling the functions in Callbacks for each item
+//  as it is read instead of building a JlDataObject tree. No memory is allocated for the values, the only memory used
+//  is the parser's stack and scratch buffers, so this can be used on documents of any size. Context is passed to each
+//  callback.
+//  The events are the same for Json1 and Json5 (as set by the parser's flags). As no tree is kept, repeated keys in a
+//  dictionary are not detected and are reported like any other key.
+//  If an error occurs (other than JL_STATUS_INVALID_PARAMETER) then *pErrorAtPos will be set with the position
+//  within JsonBuffer where the error occurred. Events will already have been sent for the data before the error.
+//  pErrorAtPos is an OPTIONAL parameter.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserParseEvents
+    (
+        JlParser*                   Parser,
+        char const*                 JsonBuffer,
+        size_t                      JsonBufferLength,
+        JlParseCallbacks const*     Callbacks,
+        void*                       Context,            // OPTIONAL
+        size_t*                     pErrorAtPos         // OPTIONAL
+    );
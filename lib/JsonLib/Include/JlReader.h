@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JsonLib
+//
+//  This module provides a pull interface for reading JSON one token at a time. Rather than building a JlDataObject
+//  tree, or calling back for each item, the caller asks for the next token with JlReaderNext. This suits code that
+//  expects the fields of a document in a known order. Whole values that are not wanted can be passed over with
+//  JlReaderSkipValue. No memory is allocated while reading other than the reader's scratch buffers.
+//
+//  This is free and unencumbered software released into the public domain - November 2019 waterjuice.org
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  IMPORTS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "JlStatus.h"
+#include "JlParser.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TYPES
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef enum
+{
+    JL_TOKEN_TYPE_NONE = 0,
+    JL_TOKEN_TYPE_BEGIN_DICTIONARY = 1,
+    JL_TOKEN_TYPE_END_DICTIONARY = 2,
+    JL_TOKEN_TYPE_BEGIN_LIST = 3,
+    JL_TOKEN_TYPE_END_LIST = 4,
+    JL_TOKEN_TYPE_KEY = 5,
+    JL_TOKEN_TYPE_STRING = 6,
+    JL_TOKEN_TYPE_NUMBER = 7,
+    JL_TOKEN_TYPE_BOOL = 8,
+    JL_TOKEN_TYPE_NULL = 9,
+} JL_TOKEN_TYPE;
+
+// A token returned by JlReaderNext. Text is set for keys, strings, and numbers, it is zero terminated and is only
+// valid until the next call to the reader. Depth is 0 for the root value. The begin and end tokens of a list or
+// dictionary have the depth of the list or dictionary, the keys and values within it are one deeper.
+typedef struct
+{
+    JL_TOKEN_TYPE   Type;
+    char const*     Text;
+    size_t          TextLength;
+    bool            BoolValue;
+    uint32_t        Depth;
+    size_t          Offset;                 // Position of the token in the input
+} JlToken;
+
+typedef struct JlReader JlReader;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlReaderCreate
+//
+//  Creates a reader. Whether JSON5 is accepted is set by ParseFlags. Use JlReaderStart to set the JSON to read. The
+//  reader can be used for any number of documents. Free with JlReaderFree.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlReaderCreate
+    (
+        JL_PARSE_FLAGS  ParseFlags,
+        JlReader**      pReader
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlReaderFree
+//
+//  Frees a reader created with JlReaderCreate. *pReader will be set to NULL.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlReaderFree
+    (
+        JlReader**      pReader
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlReaderStart
+//
+//  Sets the reader to read the JSON in a buffer of JsonBufferLength bytes. The buffer does not need to be zero
+//  terminated and must remain valid while it is being read. Any document previously being read is abandoned.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlReaderStart
+    (
+        JlReader*       Reader,
+        char const*     JsonBuffer,
+        size_t          JsonBufferLength
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlReaderNext
+//
+//  Reads the next token from the document into *pToken. Returns JL_STATUS_END_OF_DATA once the whole document has
+//  been read. If the document is invalid, including ending before it is complete, then an error is returned and
+//  *pErrorAtPos is set to the position of the error. Once an error has been returned it will be returned again by
+//  any further calls. pErrorAtPos is an OPTIONAL parameter.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlReaderNext
+    (
+        JlReader*       Reader,
+        JlToken*        pToken,
+        size_t*         pErrorAtPos         // OPTIONAL
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlReaderSkipValue
+//
+//  Skips over the next value, including everything within it if it is a list or dictionary. If the next token is a
+//  key then the key and its value are skipped. If the last token returned by JlReaderNext was the start of a list or
+//  dictionary then the rest of that list or dictionary is skipped, up to and including its end token.
+//  The value is moved over by matching brackets and quotes without unescaping strings or converting numbers, so
+//  nothing within it is checked other than that its strings end and its brackets balance.
+//  Returns JL_STATUS_NOT_FOUND if there is no value to skip because the next token is the end of a list or
+//  dictionary. That token will be the next one returned by JlReaderNext.
+//  pErrorAtPos is an OPTIONAL parameter.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlReaderSkipValue
+    (
+        JlReader*       Reader,
+        size_t*         pErrorAtPos         // OPTIONAL
+    );
@@ -32,4 +32,9 @@ typedef enum
     JL_STATUS_STRING_NOT_TERMINATED = -15,
     JL_STATUS_JSON_NESTING_TOO_DEEP = -16,
     JL_STATUS_COUNT_FIELD_TOO_SMALL = -17,
+    JL_STATUS_NEED_MORE_DATA = -18,         // Used within the parser for input that ends part way through a token.
+                                            // JlParserFeed waits for the next chunk instead, so it is never returned
+    JL_STATUS_FILE_ERROR = -19,             // JlParseJsonFile could not open or map the file
+    JL_STATUS_IN_PROGRESS = -20,            // JlParserParseWithBudget has not finished the document yet
+    JL_STATUS_LIMIT_EXCEEDED = -21,         // A document went over a limit set with JlParserSetLimits
 } JL_STATUS;
@@ -29,6 +29,8 @@
 #include "JlMarshallTypes.h"
 #include "JlDataModel.h"
 #include "JlDataModelHelpers.h"
+#include "JlParser.h"
+#include "JlReader.h"
 
 #ifdef JL_INCLUDE_H
    #include JL_INCLUDE_H
@@ -80,6 +82,35 @@ typedef uint64_t JL_OUTPUT_FLAGS;
     | JL_OUTPUT_FLAGS_J5_ALLOW_HEX \
     )
 
+// One piece of a document held in several separate buffers, see JlParseJsonIov. This has the same layout as the POSIX
+// struct iovec so an array of those can be passed as well.
+typedef struct
+{
+    void const*     Base;
+    size_t          Length;
+} JlIoVec;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JL_NDJSON_DOCUMENT_FUNCTION
+//
+//  Called by JlParseNdjsonParallel for each document. Offset is the position in the input of the start of the
+//  document. If the document failed to parse then ParseStatus is the error, ErrorAtPos is the position in the input
+//  where the error occurred, and *pRootObject is NULL. Otherwise *pRootObject is the parsed document, which is freed
+//  after the function returns unless the function takes it by setting *pRootObject to NULL (it must then be freed
+//  with JlFreeObjectTree). If the function returns anything other than JL_STATUS_SUCCESS then parsing stops and that
+//  status is returned from JlParseNdjsonParallel.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef
+JL_STATUS
+    (*JL_NDJSON_DOCUMENT_FUNCTION)
+    (
+        void*           Context,
+        size_t          Offset,
+        JL_STATUS       ParseStatus,
+        size_t          ErrorAtPos,
+        JlDataObject**  pRootObject
+    );
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  PUBLIC FUNCTIONS
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -117,6 +148,257 @@ JL_STATUS
         size_t*         pErrorAtPos
     );
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParseJsonBuffer
+//
+//  Parses JSON in a buffer of JsonBufferLength bytes and returns a JlDataObject representing it. The buffer does not
+//  need to be zero terminated and no bytes beyond JsonBufferLength will be read.
+//  If an error occurs (other than JL_STATUS_INVALID_PARAMETER) then *pErrorAtPos will be set with the position
+//  within JsonBuffer where the error occurred. pErrorAtPos is an OPTIONAL parameter.
+//  If IsJson5 is true then JSON 5 parsing will be done, otherwise strict JSON 1 parsing.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParseJsonBuffer
+    (
+        char const*     JsonBuffer,
+        size_t          JsonBufferLength,
+        bool            IsJson5,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParseJsonIov
+//
+//  Parses a JSON document held in NumSegments separate buffers, taken in order, and returns a JlDataObject
+//  representing it. The document is parsed straight from each buffer without first joining them into one. Only a
+//  token that runs over the end of a buffer is copied so that it can be completed from the next one. The result is
+//  the same as JlParseJsonBuffer with the buffers joined together.
+//  If an error occurs (other than JL_STATUS_INVALID_PARAMETER) then *pErrorAtPos will be set with the position
+//  of the error counted from the start of the first buffer. pErrorAtPos is an OPTIONAL parameter.
+//  If IsJson5 is true then JSON 5 parsing will be done, otherwise strict JSON 1 parsing.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParseJsonIov
+    (
+        JlIoVec const*  Segments,
+        size_t          NumSegments,
+        bool            IsJson5,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos         // OPTIONAL
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParseJsonFile
+//
+//  Parses JSON in the file Filename and returns a JlDataObject representing it. The file is mapped into memory and
+//  parsed where it is rather than being read into a buffer first, and can be larger than 2 GB where the address space
+//  allows. Returns JL_STATUS_FILE_ERROR if the file can not be opened or mapped.
+//  If an error occurs (other than JL_STATUS_INVALID_PARAMETER) then *pErrorAtPos will be set with the position
+//  within the file where the error occurred. pErrorAtPos is an OPTIONAL parameter.
+//  If IsJson5 is true then JSON 5 parsing will be done, otherwise strict JSON 1 parsing.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParseJsonFile
+    (
+        char const*     Filename,
+        bool            IsJson5,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos         // OPTIONAL
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParseJsonInSitu
+//
+//  Parses JSON in a writable buffer of JsonBufferLength bytes and returns a JlDataObject representing it. The strings
+//  and key names are unescaped in place within JsonBuffer and the returned tree points at them rather than holding
+//  copies, which saves an allocation for every string. JsonBuffer must stay valid and must not be changed until the
+//  tree has been freed. See JlParserParseInSitu in JlParser.h for details.
+//  If an error occurs (other than JL_STATUS_INVALID_PARAMETER) then *pErrorAtPos will be set with the position
+//  within JsonBuffer where the error occurred. pErrorAtPos is an OPTIONAL parameter.
+//  If IsJson5 is true then JSON 5 parsing will be done, otherwise strict JSON 1 parsing.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParseJsonInSitu
+    (
+        char*           JsonBuffer,
+        size_t          JsonBufferLength,
+        bool            IsJson5,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParseJsonLazy
+//
+//  Parses JSON in a buffer of JsonBufferLength bytes and returns a JlDataObject representing it, without parsing the
+//  lists and dictionaries below the root. Each of these is only checked for matching brackets and its position is
+//  recorded. It is parsed into real objects the first time it is used (for example by JlGetObjectListNextItem,
+//  JlGetObjectDictionaryNextItem, JlGetObjectFromDictionaryByKey, or JlGetListCount), and the lists and dictionaries
+//  inside it are left unparsed in the same way. This makes reading a few values from a large document much faster.
+//  JsonBuffer must stay valid and must not be changed until the tree has been freed. As reading the tree can change
+//  it, a lazy tree must not be read by more than one thread at a time.
+//  Errors at the root level are reported here, with *pErrorAtPos set as for JlParseJsonBuffer. Within the lists and
+//  dictionaries below it only unmatched brackets, unterminated strings, and nesting that is too deep are found here.
+//  Other errors are returned by the function that first uses the list or dictionary, which is then left unparsed.
+//  If IsJson5 is true then JSON 5 parsing will be done, otherwise strict JSON 1 parsing.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParseJsonLazy
+    (
+        char const*     JsonBuffer,
+        size_t          JsonBufferLength,
+        bool            IsJson5,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParseJsonProjection
+//
+//  Parses JSON in a buffer of JsonBufferLength bytes and returns a JlDataObject holding only the values on the
+//  NumPaths JSON Pointer paths in Paths (for example "/user/id" or "/items/*/price"), along with the lists and
+//  dictionaries that lead to them. Everything else is skipped over without being parsed, which is much faster when
+//  only a small part of each document is needed. See JlParserSetProjection in JlParser.h for the details.
+//  If an error occurs (other than JL_STATUS_INVALID_PARAMETER) then *pErrorAtPos will be set with the position
+//  within JsonBuffer where the error occurred. pErrorAtPos is an OPTIONAL parameter.
+//  If IsJson5 is true then JSON 5 parsing will be done, otherwise strict JSON 1 parsing.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParseJsonProjection
+    (
+        char const*         JsonBuffer,
+        size_t              JsonBufferLength,
+        bool                IsJson5,
+        char const* const*  Paths,
+        size_t              NumPaths,
+        JlDataObject**      pRootObject,
+        size_t*             pErrorAtPos
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParseJsonKeys
+//
+//  Parses JSON in a buffer of JsonBufferLength bytes only as far as is needed to find the NumKeyNames keys in
+//  KeyNames in the root dictionary, and returns a dictionary holding just those keys and their values. This is for
+//  reading a few fields (such as a message type) that appear near the start of a large document: parsing stops after
+//  the last of the keys is read, without reading or checking the rest. *pAmountConsumed is set to the number of bytes
+//  read, which is JsonBufferLength if some of the keys were not found. See JlParserParseKeys in JlParser.h.
+//  If an error occurs (other than JL_STATUS_INVALID_PARAMETER) then *pErrorAtPos will be set with the position
+//  within JsonBuffer where the error occurred. pAmountConsumed and pErrorAtPos are OPTIONAL parameters.
+//  If IsJson5 is true then JSON 5 parsing will be done, otherwise strict JSON 1 parsing.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParseJsonKeys
+    (
+        char const*         JsonBuffer,
+        size_t              JsonBufferLength,
+        bool                IsJson5,
+        char const* const*  KeyNames,
+        size_t              NumKeyNames,
+        JlDataObject**      pRootObject,
+        size_t*             pAmountConsumed,
+        size_t*             pErrorAtPos
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParseJsonEvents
+//
+//  Parses JSON in a buffer of JsonBufferLength bytes calling the functions in Callbacks for each item as it is read.
+//  No JlDataObject tree is built. See JlParserParseEvents in JlParser.h for details.
+//  If an error occurs (other than JL_STATUS_INVALID_PARAMETER) then *pErrorAtPos will be set with the position
+//  within JsonBuffer where the error occurred. pErrorAtPos is an OPTIONAL parameter.
+//  If IsJson5 is true then JSON 5 parsing will be done, otherwise strict JSON 1 parsing.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParseJsonEvents
+    (
+        char const*                 JsonBuffer,
+        size_t                      JsonBufferLength,
+        bool                        IsJson5,
+        JlParseCallbacks const*     Callbacks,
+        void*                       Context,
+        size_t*                     pErrorAtPos
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParseNdjsonParallel
+//
+//  Parses a buffer of NDJSON (one document per line) using NumThreads threads, or one per processor if NumThreads is
+//  0. The buffer is split into chunks at newlines and each thread parses whole chunks with its own JlParser, so the
+//  threads do not share any parse state. OnDocument is called for each document, including any that fail to parse.
+//  If InOrder is true then OnDocument is called in the order the documents appear in the buffer, otherwise it is
+//  called as soon as each document is parsed. Either way OnDocument is never called by two threads at the same time,
+//  so it does not need to be thread safe, though it may be called from any of the threads.
+//  Documents must not span the newline at the end of a chunk, which is always true for NDJSON. The calling thread is
+//  used as one of the threads, and all the threads have finished when this returns.
+//  If IsJson5 is true then JSON 5 parsing will be done, otherwise strict JSON 1 parsing.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParseNdjsonParallel
+    (
+        char const*                     JsonBuffer,
+        size_t                          JsonBufferLength,
+        bool                            IsJson5,
+        uint32_t                        NumThreads,
+        bool                            InOrder,
+        JL_NDJSON_DOCUMENT_FUNCTION     OnDocument,
+        void*                           Context
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParseJsonParallel
+//
+//  Same as JlParseJsonBuffer, and gives the same result, but if the root is a list and the buffer is large then the
+//  elements are parsed on NumThreads threads, or one per processor if NumThreads is 0. The buffer is split between
+//  the threads at commas that appear to be between elements of the root list. If a split turns out to be wrong,
+//  for example the comma was inside a string, or the JSON is invalid, then the document is parsed again on the
+//  calling thread as JlParseJsonBuffer would. Documents of less than about 2 MB are always parsed on the calling
+//  thread.
+//  If an error occurs (other than JL_STATUS_INVALID_PARAMETER) then *pErrorAtPos will be set with the position
+//  within JsonBuffer where the error occurred. pErrorAtPos is an OPTIONAL parameter.
+//  If IsJson5 is true then JSON 5 parsing will be done, otherwise strict JSON 1 parsing.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParseJsonParallel
+    (
+        char const*     JsonBuffer,
+        size_t          JsonBufferLength,
+        bool            IsJson5,
+        uint32_t        NumThreads,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlValidateJson
+//
+//  Checks that a buffer of JsonBufferLength bytes contains valid JSON without building anything. No memory is
+//  allocated, the parse state is kept on the stack. This is a parse stack entry for each nesting level the parser
+//  allows, about 5.5 KB of stack on a 64 bit build. The JSON is checked with the same rules as JlParseJsonBuffer,
+//  and errors are reported at the same position, except for dictionary keys as no dictionaries are built:
+//      Repeated keys are not detected. JlParseJsonBuffer returns JL_STATUS_DICTIONARY_ITEM_REPEATED for these.
+//      An empty key returns JL_STATUS_INVALID_DATA. JlParseJsonBuffer returns JL_STATUS_INVALID_PARAMETER, which
+//      comes from adding the value to the dictionary.
+//  Returns one of the following:
+//      JL_STATUS_SUCCESS - The JSON is valid.
+//      JL_STATUS_INVALID_PARAMETER - JsonBuffer is NULL.
+//      JL_STATUS_END_OF_DATA - There is no value in the buffer, or it ends part way through a list or dictionary.
+//      JL_STATUS_INVALID_DATA - The JSON is invalid.
+//      JL_STATUS_JSON_NESTING_TOO_DEEP - Lists and dictionaries are nested deeper than the parser allows.
+//  For any error other than JL_STATUS_INVALID_PARAMETER *pErrorAtPos will be set with the position within JsonBuffer
+//  where the error occurred. pErrorAtPos is an OPTIONAL parameter.
+//  If IsJson5 is true then JSON 5 is accepted, otherwise strict JSON 1.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlValidateJson
+    (
+        char const*     JsonBuffer,
+        size_t          JsonBufferLength,
+        bool            IsJson5,
+        size_t*         pErrorAtPos         // OPTIONAL
+    );
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  JlFreeObjectTree
 //
@@ -300,6 +582,25 @@ JL_STATUS
         size_t*                     pErrorAtPos                     // [out] [OPTIONAL]
     );
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlJsonBufferToStruct
+//
+//  Same as JlJsonToStructEx except the JSON is provided as a buffer of JsonBufferLength bytes which does not need to
+//  be zero terminated. No bytes beyond JsonBufferLength will be read.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlJsonBufferToStruct
+    (
+        char const*                 JsonBuffer,                     // [in]
+        size_t                      JsonBufferLength,               // [in]
+        JlMarshallElement const*    StructDescription,              // [in]
+        size_t                      StructDescriptionCount,         // [in]
+        bool                        IgnoreExistingValuesInStruct,   // [in]
+        bool                        AllowJson5,                     // [in]
+        void*                       Structure,                      // [in,out]
+        size_t*                     pErrorAtPos                     // [out] [OPTIONAL]
+    );
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  JlStructToJson
 //
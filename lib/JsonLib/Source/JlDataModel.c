@@ -16,47 +16,27 @@
 #include "JsonLib.h"
 #include "JlLinkedLists.h"
 #include "JlMemory.h"
+#include "JlNumberString.h"
+#include "JlLazy.h"
+#include "JlParseSlice.h"
+#include "JlPlainString.h"
+#include "JlScan.h"
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
-#include <stdio.h>
 #include <string.h>
-#include <float.h>
-#include <math.h>
-
-#ifndef _MSC_VER
-    #include <inttypes.h>
-#endif
-
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//  DEFINES
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-#ifdef _MSC_VER
-    #define PRIu64 "llu"
-    #define PRId64 "lld"
-    #define PRIx64 "llx"
-    #define isnan _isnan
-#endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  TYPES
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct JlNumber
+// How AttachObjectToDictionary stores the key name
+typedef enum
 {
-    JL_NUM_TYPE     Type;
-    union
-    {
-        // JL_NUM_TYPE_UNSIGNED
-        uint64_t    u64;
-        // JL_NUM_TYPE_SIGNED
-        int64_t     s64;
-        // JL_NUM_TYPE_FLOAT
-        double      f64;
-    };
-    bool            IsHex;      // Only relevant when Type is JL_NUM_TYPE_UNSIGNED
-};
+    KEY_STORAGE_COPY = 0,
+    KEY_STORAGE_TAKE = 1,
+    KEY_STORAGE_REFERENCE = 2,
+} KEY_STORAGE;
 
 struct JlListItem
 {
@@ -79,6 +59,8 @@ struct JlDictionaryItem
     JlDictionary*       ParentDictionary;
     char*               KeyName;
     JlDataObject*       Object;
+    bool                KeyNameIsReference;     // KeyName is not owned by the dictionary and is not freed
+    JL_PLAIN_STRING     KeyNamePlain;           // Quotes that KeyName can be output between without escaping
 };
 
 struct JlDictionary
@@ -87,18 +69,38 @@ struct JlDictionary
     JlDictionaryItem*   DictionaryTail;
 };
 
+// The unparsed input of a list or dictionary from a lazy parse, or of a string from a JL_PARSE_FLAGS_RAW_STRINGS parse
+typedef struct
+{
+    char const*     Json;
+    size_t          JsonLength;
+    bool            IsJson5;
+    bool            HasEscapes;     // Strings only, false if the string can be copied without unescaping
+} JlLazySpan;
+
 struct JlDataObject
 {
     JL_DATA_TYPE    Type;
+    bool            StringIsReference;  // String is not owned by the object and is not freed
+    bool            IsLazy;     // List, dictionary, or string has not been parsed yet, the span is in Lazy
+    uint16_t        NumberTextLength;   // Length of NumberText, which is kept only for short numbers
     size_t          Tag;        // Used for tracking original Json character position
 
     union
     {
         // JL_DATA_TYPE_STRING
-        char*           String;
+        struct
+        {
+            char*           String;
+            JL_PLAIN_STRING StringPlain;    // Quotes that String can be output between without escaping
+        };
 
-        // JL_DATA_TYPE_NUMBER
-        JlNumber        Number;
+        // JL_DATA_TYPE_NUMBER. Number.Type is JL_NUM_TYPE_NONE until NumberText has been converted.
+        struct
+        {
+            JlNumber        Number;
+            char const*     NumberText;     // Original text from a JL_PARSE_FLAGS_RAW_NUMBERS parse, until changed
+        };
 
         // JL_DATA_TYPE_BOOL
         bool            Boolean;
@@ -108,17 +110,12 @@ struct JlDataObject
 
         // JL_DATA_TYPE_DICTIONARY
         JlDictionary    Dictionary;
+
+        // JL_DATA_TYPE_LIST, JL_DATA_TYPE_DICTIONARY, or JL_DATA_TYPE_STRING when IsLazy is set
+        JlLazySpan      Lazy;
     };
 };
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//  MACROS
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-#ifdef _MSC_VER
-    #define strcasecmp stricmp
-#endif
-
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  PRIVATE FUNCTIONS
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -214,7 +211,10 @@ JlDataObject*
             }
 
             // Now free the DictionaryItem Key string
-            JlFree( item->KeyName );
+            if( !item->KeyNameIsReference )
+            {
+                JlFree( item->KeyName );
+            }
 
             // Now free the DictionaryItem (not the object)
             JlFree( item );
@@ -228,6 +228,277 @@ JlDataObject*
     return retObject;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  GetPlainString
+//
+//  Returns which quotes String can be output between without escaping. This is worked out when a string is set so
+//  that the output does not need to check it a character at a time.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_PLAIN_STRING
+    GetPlainString
+    (
+        char const*     String,
+        size_t          StringLength
+    )
+{
+    JL_PLAIN_STRING plain = JL_PLAIN_STRING_NONE;
+
+    if( JlScanPlainAscii( String, StringLength, '\"' ) == StringLength )
+    {
+        plain = JL_PLAIN_STRING_DOUBLE_QUOTED;
+        if( NULL == memchr( String, '\'', StringLength ) )
+        {
+            plain |= JL_PLAIN_STRING_SINGLE_QUOTED;
+        }
+    }
+
+    return plain;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ClearLazySpan
+//
+//  Removes the lazy span from a list, dictionary, or string object, leaving it as an empty list or dictionary, or a
+//  NULL string.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+void
+    ClearLazySpan
+    (
+        JlDataObject*   ContainerObject
+    )
+{
+    memset( &ContainerObject->Lazy, 0, sizeof(ContainerObject->Lazy) );
+    memset( &ContainerObject->List, 0, sizeof(ContainerObject->List) );
+    memset( &ContainerObject->Dictionary, 0, sizeof(ContainerObject->Dictionary) );
+    ContainerObject->IsLazy = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ReleaseObjectString
+//
+//  Removes the string from a string object, freeing it unless it is a reference to memory the object does not own.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+void
+    ReleaseObjectString
+    (
+        JlDataObject*   StringObject
+    )
+{
+    if( StringObject->IsLazy )
+    {
+        // The span is in the caller's input, so there is nothing to free
+        ClearLazySpan( StringObject );
+    }
+    else if(    NULL != StringObject->String
+             && !StringObject->StringIsReference )
+    {
+        JlFree( StringObject->String );
+    }
+    StringObject->String = NULL;
+    StringObject->StringIsReference = false;
+    StringObject->StringPlain = JL_PLAIN_STRING_NONE;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  MaterializeLazyObject
+//
+//  If ContainerObject is a list or dictionary from a lazy parse that has not been parsed yet, then this parses its span
+//  and moves the resulting children into it. Otherwise this does nothing. This is called by the functions that read
+//  a list or dictionary, so although they take a const object the object is changed the first time it is read.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    MaterializeLazyObject
+    (
+        JlDataObject const*     ContainerObject
+    )
+{
+    JL_STATUS jlStatus = JL_STATUS_SUCCESS;
+
+    if(     ContainerObject->IsLazy
+        &&  JL_DATA_TYPE_STRING != ContainerObject->Type )
+    {
+        JlDataObject* object = (JlDataObject*)ContainerObject;
+        JlDataObject* parsedObject = NULL;
+
+        jlStatus = JlParseLazySpan( object->Lazy.Json, object->Lazy.JsonLength, object->Lazy.IsJson5, object->Tag, &parsedObject );
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            ClearLazySpan( object );
+
+            // Move the children across. Each item records the list or dictionary it is in, so these are updated.
+            if( JL_DATA_TYPE_LIST == object->Type )
+            {
+                object->List = parsedObject->List;
+                memset( &parsedObject->List, 0, sizeof(parsedObject->List) );
+                for( JlListItem* item=object->List.ListHead; item!=NULL; item=item->Next )
+                {
+                    item->ParentList = &object->List;
+                }
+            }
+            else
+            {
+                object->Dictionary = parsedObject->Dictionary;
+                memset( &parsedObject->Dictionary, 0, sizeof(parsedObject->Dictionary) );
+                for( JlDictionaryItem* item=object->Dictionary.DictionaryHead; item!=NULL; item=item->Next )
+                {
+                    item->ParentDictionary = &object->Dictionary;
+                }
+            }
+
+            (void) JlFreeObjectTree( &parsedObject );
+        }
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  UnescapeLazyString
+//
+//  If StringObject is a string from a JL_PARSE_FLAGS_RAW_STRINGS parse that has not been read yet, then this unescapes
+//  its span into a string owned by the object. Otherwise this does nothing. As with MaterializeLazyObject the object
+//  is changed the first time it is read even though it is const.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    UnescapeLazyString
+    (
+        JlDataObject const*     StringObject
+    )
+{
+    JL_STATUS jlStatus = JL_STATUS_SUCCESS;
+
+    if(     StringObject->IsLazy
+        &&  JL_DATA_TYPE_STRING == StringObject->Type )
+    {
+        JlDataObject* object = (JlDataObject*)StringObject;
+        char* string = NULL;
+
+        jlStatus = JlUnescapeStringSpan(
+            object->Lazy.Json, object->Lazy.JsonLength, object->Lazy.IsJson5, object->Lazy.HasEscapes, &string );
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            ClearLazySpan( object );
+            object->String = string;
+            object->StringIsReference = false;
+            if( NULL != string )
+            {
+                object->StringPlain = GetPlainString( string, strlen( string ) );
+            }
+        }
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ConvertNumberText
+//
+//  If NumberObject is a number from a JL_PARSE_FLAGS_RAW_NUMBERS parse that has not been read yet, then this converts
+//  its text. The text is kept so that it can still be output as it was. This is called by the functions that read a
+//  number, so although they take a const object the object is changed the first time it is read.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+void
+    ConvertNumberText
+    (
+        JlDataObject const*     NumberObject
+    )
+{
+    if(     JL_DATA_TYPE_NUMBER == NumberObject->Type
+        &&  JL_NUM_TYPE_NONE == NumberObject->Number.Type
+        &&  NULL != NumberObject->NumberText )
+    {
+        JlDataObject* object = (JlDataObject*)NumberObject;
+
+        // The parser only keeps the text of numbers that can be seen to convert, so this does not fail
+        (void) JlNumberStringToNumber( object->NumberText, object->NumberTextLength, &object->Number );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  AttachObjectToDictionary
+//
+//  Adds an object to a dictionary object with specified key. KeyStorage sets how the key is held by the dictionary
+//  item: KEY_STORAGE_COPY makes a copy of KeyName, KEY_STORAGE_TAKE takes KeyName which must have been allocated with
+//  JlAlloc (only if this succeeds), and KEY_STORAGE_REFERENCE points at KeyName without ever freeing it.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    AttachObjectToDictionary
+    (
+        JlDataObject*   DictionaryObject,
+        char const*     KeyName,
+        KEY_STORAGE     KeyStorage,
+        JlDataObject*   NewObject
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != DictionaryObject
+        &&  NULL != KeyName
+        &&  0 != KeyName[0]
+        &&  NULL != NewObject )
+    {
+        jlStatus = MaterializeLazyObject( DictionaryObject );
+        if( JL_STATUS_SUCCESS != jlStatus )
+        {
+            // Lazy dictionary could not be parsed
+        }
+        else if( JL_DATA_TYPE_DICTIONARY == DictionaryObject->Type )
+        {
+            // Check key does not already exist
+            if( NULL == FindDictionaryItem( &DictionaryObject->Dictionary, KeyName ) )
+            {
+                // Create dictionary item container for object
+                JlDictionaryItem* dictionaryItem = JlNew( JlDictionaryItem );
+                if( NULL != dictionaryItem )
+                {
+                    dictionaryItem->Next = NULL;
+                    dictionaryItem->Object = NewObject;
+                    dictionaryItem->ParentDictionary = &DictionaryObject->Dictionary;
+                    dictionaryItem->KeyNameIsReference = ( KEY_STORAGE_REFERENCE == KeyStorage );
+                    dictionaryItem->KeyName = ( KEY_STORAGE_COPY == KeyStorage ) ? JlStrDup( KeyName ) : (char*)KeyName;
+                    if( NULL != dictionaryItem->KeyName )
+                    {
+                        dictionaryItem->KeyNamePlain = GetPlainString( KeyName, strlen( KeyName ) );
+                        JlLinkedListAddToEnd( DictionaryObject->Dictionary.DictionaryHead, DictionaryObject->Dictionary.DictionaryTail, dictionaryItem );
+                        jlStatus = JL_STATUS_SUCCESS;
+                    }
+                    else
+                    {
+                        jlStatus = JL_STATUS_OUT_OF_MEMORY;
+                        JlFree( dictionaryItem );
+                        dictionaryItem = NULL;
+                    }
+                }
+                else
+                {
+                    jlStatus = JL_STATUS_OUT_OF_MEMORY;
+                }
+            }
+            else
+            {
+                jlStatus = JL_STATUS_DICTIONARY_ITEM_REPEATED;
+            }
+        }
+        else
+        {
+            jlStatus = JL_STATUS_WRONG_TYPE;
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  PUBLIC FUNCTIONS
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -315,12 +586,8 @@ JL_STATUS
     {
         if( JL_DATA_TYPE_STRING == StringObject->Type )
         {
-            if( NULL != StringObject->String )
-            {
-                // Remove existing string
-                JlFree( StringObject->String );
-                StringObject->String = NULL;
-            }
+            // Remove existing string
+            ReleaseObjectString( StringObject );
 
             size_t length = 0;
             if( NULL != String )
@@ -334,6 +601,7 @@ JL_STATUS
                 StringObject->String = JlStrDup( String );
                 if( NULL != StringObject->String )
                 {
+                    StringObject->StringPlain = GetPlainString( String, length );
                     jlStatus = JL_STATUS_SUCCESS;
                 }
                 else
@@ -360,6 +628,100 @@ JL_STATUS
     return jlStatus;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlSetObjectStringTakeOwnership
+//
+//  Sets the value of a string object using a string that was allocated with JlAlloc. The object takes ownership of
+//  String rather than making a copy of it, it will be freed along with the object. If this fails then String is
+//  still owned by the caller.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlSetObjectStringTakeOwnership
+    (
+        JlDataObject*   StringObject,
+        char*           String
+    )
+{
+    JL_STATUS jlStatus;
+
+    if( NULL != StringObject )
+    {
+        if( JL_DATA_TYPE_STRING == StringObject->Type )
+        {
+            // Remove existing string
+            ReleaseObjectString( StringObject );
+
+            if( NULL != String )
+            {
+                if( 0 != String[0] )
+                {
+                    StringObject->String = String;
+                    StringObject->StringPlain = GetPlainString( String, strlen( String ) );
+                }
+                else
+                {
+                    // Empty strings are not stored, same as JlSetObjectString.
+                    JlFree( String );
+                }
+            }
+            jlStatus = JL_STATUS_SUCCESS;
+        }
+        else
+        {
+            jlStatus = JL_STATUS_WRONG_TYPE;
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlSetObjectStringReference
+//
+//  Sets the value of a string object to point at String without copying it. String is not freed with the object.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlSetObjectStringReference
+    (
+        JlDataObject*   StringObject,
+        char const*     String
+    )
+{
+    JL_STATUS jlStatus;
+
+    if( NULL != StringObject )
+    {
+        if( JL_DATA_TYPE_STRING == StringObject->Type )
+        {
+            // Remove existing string
+            ReleaseObjectString( StringObject );
+
+            if(     NULL != String
+                &&  0 != String[0] )
+            {
+                StringObject->String = (char*)String;
+                StringObject->StringIsReference = true;
+                StringObject->StringPlain = GetPlainString( String, strlen( String ) );
+            }
+            jlStatus = JL_STATUS_SUCCESS;
+        }
+        else
+        {
+            jlStatus = JL_STATUS_WRONG_TYPE;
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  JlSetObjectNumberU64
 //
@@ -381,6 +743,8 @@ JL_STATUS
             NumberObject->Number.Type = JL_NUM_TYPE_UNSIGNED;
             NumberObject->Number.IsHex = false;
             NumberObject->Number.u64 = NumberU64;
+            NumberObject->NumberText = NULL;
+            NumberObject->NumberTextLength = 0;
             jlStatus = JL_STATUS_SUCCESS;
         }
         else
@@ -417,6 +781,8 @@ JL_STATUS
             NumberObject->Number.Type = JL_NUM_TYPE_UNSIGNED;
             NumberObject->Number.IsHex = true;
             NumberObject->Number.u64 = NumberU64;
+            NumberObject->NumberText = NULL;
+            NumberObject->NumberTextLength = 0;
             jlStatus = JL_STATUS_SUCCESS;
         }
         else
@@ -452,6 +818,8 @@ JL_STATUS
         {
             NumberObject->Number.Type = JL_NUM_TYPE_SIGNED;
             NumberObject->Number.s64 = NumberS64;
+            NumberObject->NumberText = NULL;
+            NumberObject->NumberTextLength = 0;
             jlStatus = JL_STATUS_SUCCESS;
         }
         else
@@ -487,6 +855,8 @@ JL_STATUS
         {
             NumberObject->Number.Type = JL_NUM_TYPE_FLOAT;
             NumberObject->Number.f64 = NumberF64;
+            NumberObject->NumberText = NULL;
+            NumberObject->NumberTextLength = 0;
             jlStatus = JL_STATUS_SUCCESS;
         }
         else
@@ -505,7 +875,10 @@ JL_STATUS
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  JlSetObjectNumberString
 //
-//  Sets the value of a number object from a string
+//  Sets the value of a number object from a string. The string must be a decimal number (with optional sign, decimal
+//  point, and exponent), a hex number starting 0x, or inf, +inf, -inf, or nan. Decimal numbers are stored as unsigned
+//  or signed integers if written as plain integers that fit, otherwise as the nearest double. Hex numbers must fit in
+//  a uint64_t.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 JL_STATUS
     JlSetObjectNumberString
@@ -515,102 +888,29 @@ JL_STATUS
     )
 {
     JL_STATUS jlStatus;
-    int converted;
-    char newString [32] = "";
 
     if(     NULL != NumberObject
         &&  NULL != NumberString )
     {
-        jlStatus = JL_STATUS_INVALID_DATA;
-
-        if( JL_STATUS_SUCCESS != jlStatus )
-        {
-            // Try to convert the number as u64 first
-            uint64_t u64 = 0;
-            if( '0' == NumberString[0] && ( 'x' == NumberString[1] || 'X' == NumberString[1] ) )
-            {
-                // Hex
-                converted = sscanf( NumberString, "%"PRIx64"", &u64 );
-                if( 1 == converted )
-                {
-                    // Note: We don't check the exact string match in hex mode because the source
-                    // string may be padded eg: 0x0001
-                    jlStatus = JlSetObjectNumberHex( NumberObject, u64 );
-                }
-            }
-            else
-            {
-                // Decimal
-                converted = sscanf( NumberString, "%"PRIu64"", &u64 );
-                if( 1 == converted )
-                {
-                    sprintf( newString, "%"PRIu64"", u64 );
-                    if( strcmp( NumberString, newString ) == 0 )
-                    {
-                        jlStatus = JlSetObjectNumberU64( NumberObject, u64 );
-                    }
-                }
-            }
-        }
-
-        if( JL_STATUS_SUCCESS != jlStatus )
+        JlNumber number = { JL_NUM_TYPE_NONE };
+        jlStatus = JlNumberStringToNumber( NumberString, strlen( NumberString ), &number );
+        if( JL_STATUS_SUCCESS == jlStatus )
         {
-            // Try to convert the number as a signed 64 bit number
-            int64_t s64 = 0;
-            converted = sscanf( NumberString, "%"PRId64"", &s64 );
-            if( 1 == converted )
+            if( JL_NUM_TYPE_UNSIGNED == number.Type && number.IsHex )
             {
-                sprintf( newString, "%"PRId64"", s64 );
-                if( strcmp( NumberString, newString ) == 0 )
-                {
-                    jlStatus = JlSetObjectNumberS64( NumberObject, s64 );
-                }
+                jlStatus = JlSetObjectNumberHex( NumberObject, number.u64 );
             }
-
-        }
-
-        if( JL_STATUS_SUCCESS != jlStatus )
-        {
-            // Try to convert the number as a float
-            double f64 = 0.0;
-            converted = sscanf( NumberString, "%lg", &f64 );
-            if( 1 == converted )
+            else if( JL_NUM_TYPE_UNSIGNED == number.Type )
             {
-                double a_inf = DBL_MAX * 2.0;
-                double a_ninf = DBL_MAX * -2.0;
-
-                if(     0.0 != f64
-                    &&  !isnan( f64 )
-                    &&  a_inf != f64
-                    &&  a_ninf != f64 )
-                {
-                    jlStatus = JlSetObjectNumberF64( NumberObject, f64 );
-                }
+                jlStatus = JlSetObjectNumberU64( NumberObject, number.u64 );
             }
-        }
-
-        if( JL_STATUS_SUCCESS != jlStatus )
-        {
-            // Try to convert as inf, +inf, -inf, or nan
-            if( strcasecmp( NumberString, "inf" ) == 0 || strcasecmp( NumberString, "+inf" ) == 0 )
+            else if( JL_NUM_TYPE_SIGNED == number.Type )
             {
-                double a_inf = DBL_MAX * 2.0;
-                jlStatus = JlSetObjectNumberF64( NumberObject, a_inf );
+                jlStatus = JlSetObjectNumberS64( NumberObject, number.s64 );
             }
-            else if( strcasecmp( NumberString, "-inf" ) == 0 )
+            else
             {
-                double a_ninf = DBL_MAX * -2.0;
-                jlStatus = JlSetObjectNumberF64( NumberObject, a_ninf );
-            }
-            else if( strcasecmp( NumberString, "nan" ) == 0 )
-            {
-                union
-                {
-                    uint64_t    bits;
-                    double      f64;
-                } a_nan = { 0x7fffffffffffffffULL };      // Set all bits except sign to make a NaN
-
-                jlStatus = JlSetObjectNumberF64( NumberObject, a_nan.f64 );
+                jlStatus = JlSetObjectNumberF64( NumberObject, number.f64 );
             }
         }
     }
@@ -673,7 +973,12 @@ JL_STATUS
     if(     NULL != ListObject
         &&  NULL != NewObject )
     {
-        if( JL_DATA_TYPE_LIST == ListObject->Type )
+        jlStatus = MaterializeLazyObject( ListObject );
+        if( JL_STATUS_SUCCESS != jlStatus )
+        {
+            // Lazy list could not be parsed
+        }
+        else if( JL_DATA_TYPE_LIST == ListObject->Type )
         {
             // Create list item container for object
             JlListItem* listItem = JlNew( JlListItem );
@@ -714,65 +1019,47 @@ JL_STATUS
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 JL_STATUS
     JlAttachObjectToDictionaryObject
-    (
-        JlDataObject*   DictionaryObject,
-        char const*     KeyName,
-        JlDataObject*   NewObject
-    )
-{
-    JL_STATUS jlStatus;
-
-    if(     NULL != DictionaryObject
-        &&  NULL != KeyName
-        &&  0 != KeyName[0]
-        &&  NULL != NewObject )
-    {
-        if( JL_DATA_TYPE_DICTIONARY == DictionaryObject->Type )
-        {
-            // Check key does not already exist
-            if( NULL == FindDictionaryItem( &DictionaryObject->Dictionary, KeyName ) )
-            {
-                // Create dictionary item container for object
-                JlDictionaryItem* dictionaryItem = JlNew( JlDictionaryItem );
-                if( NULL != dictionaryItem )
-                {
-                    dictionaryItem->Next = NULL;
-                    dictionaryItem->Object = NewObject;
-                    dictionaryItem->ParentDictionary = &DictionaryObject->Dictionary;
-                    dictionaryItem->KeyName = JlStrDup( KeyName );
-                    if( NULL != dictionaryItem->KeyName )
-                    {
-                        JlLinkedListAddToEnd( DictionaryObject->Dictionary.DictionaryHead, DictionaryObject->Dictionary.DictionaryTail, dictionaryItem );
-                        jlStatus = JL_STATUS_SUCCESS;
-                    }
-                    else
-                    {
-                        jlStatus = JL_STATUS_OUT_OF_MEMORY;
-                        JlFree( dictionaryItem );
-                        dictionaryItem = NULL;
-                    }
-                }
-                else
-                {
-                    jlStatus = JL_STATUS_OUT_OF_MEMORY;
-                }
-            }
-            else
-            {
-                jlStatus = JL_STATUS_DICTIONARY_ITEM_REPEATED;
-            }
-        }
-        else
-        {
-            jlStatus = JL_STATUS_WRONG_TYPE;
-        }
-    }
-    else
-    {
-        jlStatus = JL_STATUS_INVALID_PARAMETER;
-    }
+    (
+        JlDataObject*   DictionaryObject,
+        char const*     KeyName,
+        JlDataObject*   NewObject
+    )
+{
+    return AttachObjectToDictionary( DictionaryObject, KeyName, KEY_STORAGE_COPY, NewObject );
+}
 
-    return jlStatus;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlAttachObjectToDictionaryObjectTakeKey
+//
+//  Same as JlAttachObjectToDictionaryObject except KeyName must have been allocated with JlAlloc. The dictionary takes
+//  ownership of KeyName rather than making a copy of it. If this fails then KeyName is still owned by the caller.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlAttachObjectToDictionaryObjectTakeKey
+    (
+        JlDataObject*   DictionaryObject,
+        char*           KeyName,
+        JlDataObject*   NewObject
+    )
+{
+    return AttachObjectToDictionary( DictionaryObject, KeyName, KEY_STORAGE_TAKE, NewObject );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlAttachObjectToDictionaryObjectReferenceKey
+//
+//  Same as JlAttachObjectToDictionaryObject except the dictionary points at KeyName rather than making a copy of it.
+//  KeyName is not freed with the dictionary.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlAttachObjectToDictionaryObjectReferenceKey
+    (
+        JlDataObject*   DictionaryObject,
+        char const*     KeyName,
+        JlDataObject*   NewObject
+    )
+{
+    return AttachObjectToDictionary( DictionaryObject, KeyName, KEY_STORAGE_REFERENCE, NewObject );
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -794,7 +1081,12 @@ JL_STATUS
         &&  NULL != KeyName
         &&  0 != KeyName[0] )
     {
-        if( JL_DATA_TYPE_DICTIONARY == DictionaryObject->Type )
+        jlStatus = MaterializeLazyObject( DictionaryObject );
+        if( JL_STATUS_SUCCESS != jlStatus )
+        {
+            // Lazy dictionary could not be parsed
+        }
+        else if( JL_DATA_TYPE_DICTIONARY == DictionaryObject->Type )
         {
             // Find and detach object
             JlDataObject* object = FindAndDetachDictionaryItem( &DictionaryObject->Dictionary, KeyName );
@@ -883,8 +1175,8 @@ JL_STATUS
     {
         if( JL_DATA_TYPE_STRING == StringObject->Type )
         {
-            *pString = StringObject->String;
-            jlStatus = JL_STATUS_SUCCESS;
+            jlStatus = UnescapeLazyString( StringObject );
+            *pString = ( JL_STATUS_SUCCESS == jlStatus ) ? StringObject->String : NULL;
         }
         else
         {
@@ -900,6 +1192,35 @@ JL_STATUS
     return jlStatus;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlGetObjectStringPlain
+//
+//  Same as JlGetObjectString but also gets which quotes the string can be output between without escaping.
+//  Declared in JlPlainString.h
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlGetObjectStringPlain
+    (
+        JlDataObject const*     StringObject,
+        char const**            pString,
+        JL_PLAIN_STRING*        pPlain
+    )
+{
+    JL_STATUS jlStatus;
+
+    if( NULL != pPlain )
+    {
+        jlStatus = JlGetObjectString( StringObject, pString );
+        *pPlain = ( JL_STATUS_SUCCESS == jlStatus ) ? StringObject->StringPlain : JL_PLAIN_STRING_NONE;
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  JlGetObjectNumberU64
 //
@@ -918,6 +1239,7 @@ JL_STATUS
     if(     NULL != NumberObject
         &&  NULL != pNumber64 )
     {
+        ConvertNumberText( NumberObject );
         if(     JL_DATA_TYPE_NUMBER == NumberObject->Type
             &&  JL_NUM_TYPE_UNSIGNED == NumberObject->Number.Type )
         {
@@ -963,6 +1285,7 @@ JL_STATUS
     if(     NULL != NumberObject
         &&  NULL != pNumberS64 )
     {
+        ConvertNumberText( NumberObject );
         if(     JL_DATA_TYPE_NUMBER == NumberObject->Type
             &&  JL_NUM_TYPE_SIGNED == NumberObject->Number.Type )
         {
@@ -1017,6 +1340,7 @@ JL_STATUS
     if(     NULL != NumberObject
         &&  NULL != pNumberF64 )
     {
+        ConvertNumberText( NumberObject );
         if(     JL_DATA_TYPE_NUMBER == NumberObject->Type
             &&  JL_NUM_TYPE_FLOAT == NumberObject->Number.Type )
         {
@@ -1105,6 +1429,7 @@ JL_NUM_TYPE
     if(     NULL != NumberObject
         &&  JL_DATA_TYPE_NUMBER == NumberObject->Type )
     {
+        ConvertNumberText( NumberObject );
         returnType = NumberObject->Number.Type;
     }
 
@@ -1134,6 +1459,48 @@ JL_NUM_TYPE
     return isHex;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlGetObjectNumberText
+//
+//  Gets the original text of a number object from a parse with JL_PARSE_FLAGS_RAW_NUMBERS. The text is not zero
+//  terminated. Returns JL_STATUS_NOT_FOUND if the number has no text.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlGetObjectNumberText
+    (
+        JlDataObject const*     NumberObject,
+        char const**            pText,
+        size_t*                 pTextLength
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != NumberObject
+        &&  NULL != pText
+        &&  NULL != pTextLength )
+    {
+        if(     JL_DATA_TYPE_NUMBER == NumberObject->Type
+            &&  NULL != NumberObject->NumberText )
+        {
+            *pText = NumberObject->NumberText;
+            *pTextLength = NumberObject->NumberTextLength;
+            jlStatus = JL_STATUS_SUCCESS;
+        }
+        else
+        {
+            *pText = NULL;
+            *pTextLength = 0;
+            jlStatus = ( JL_DATA_TYPE_NUMBER == NumberObject->Type ) ? JL_STATUS_NOT_FOUND : JL_STATUS_WRONG_TYPE;
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  JlGetObjectListNextItem
 //
@@ -1159,8 +1526,13 @@ JL_STATUS
         &&  NULL != pNextObject
         &&  NULL != pEnumerator )
     {
-        if(     JL_DATA_TYPE_LIST == ListObject->Type
-            &&  ( NULL == *pEnumerator  || (*pEnumerator)->ParentList == &ListObject->List ) )
+        jlStatus = MaterializeLazyObject( ListObject );
+        if( JL_STATUS_SUCCESS != jlStatus )
+        {
+            // Lazy list could not be parsed
+        }
+        else if(    JL_DATA_TYPE_LIST == ListObject->Type
+                &&  ( NULL == *pEnumerator  || (*pEnumerator)->ParentList == &ListObject->List ) )
         {
             if( NULL == *pEnumerator )
             {
@@ -1234,8 +1606,13 @@ JL_STATUS
         &&  NULL != pKeyName
         &&  NULL != pEnumerator )
     {
-        if(     JL_DATA_TYPE_DICTIONARY == DictionaryObject->Type
-            &&  ( NULL == *pEnumerator  || (*pEnumerator)->ParentDictionary == &DictionaryObject->Dictionary ) )
+        jlStatus = MaterializeLazyObject( DictionaryObject );
+        if( JL_STATUS_SUCCESS != jlStatus )
+        {
+            // Lazy dictionary could not be parsed
+        }
+        else if(    JL_DATA_TYPE_DICTIONARY == DictionaryObject->Type
+                &&  ( NULL == *pEnumerator  || (*pEnumerator)->ParentDictionary == &DictionaryObject->Dictionary ) )
         {
             if( NULL == *pEnumerator )
             {
@@ -1286,6 +1663,21 @@ JL_STATUS
     return jlStatus;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlGetDictionaryItemKeyPlain
+//
+//  Returns which quotes the key name of a dictionary item can be output between without escaping. Declared in
+//  JlPlainString.h
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_PLAIN_STRING
+    JlGetDictionaryItemKeyPlain
+    (
+        JlDictionaryItem const*     DictionaryItem
+    )
+{
+    return ( NULL != DictionaryItem ) ? DictionaryItem->KeyNamePlain : JL_PLAIN_STRING_NONE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  JlGetObjectDictionaryByKey
 //
@@ -1399,7 +1791,8 @@ uint32_t
 
     if( NULL != ListObject )
     {
-        if( JL_DATA_TYPE_LIST == ListObject->Type )
+        if(     JL_DATA_TYPE_LIST == ListObject->Type
+            &&  JL_STATUS_SUCCESS == MaterializeLazyObject( ListObject ) )
         {
             count = ListObject->List.Count;
         }
@@ -1471,15 +1864,17 @@ JL_STATUS
     {
         JlDataObject* object = *pRootObject;
 
+        if( object->IsLazy )
+        {
+            // Not parsed yet so there is nothing below it to free
+            ClearLazySpan( object );
+        }
+
         objectType = JlGetObjectType( object );
         switch( objectType )
         {
         case JL_DATA_TYPE_STRING:
-            if( NULL != object->String )
-            {
-                JlFree( object->String );
-                object->String = NULL;
-            }
+            ReleaseObjectString( object );
             jlStatus = JL_STATUS_SUCCESS;
             break;
         case JL_DATA_TYPE_NUMBER:
@@ -1497,7 +1892,10 @@ JL_STATUS
                     JlFree( prevDictionaryItem );
                     prevDictionaryItem = NULL;
                 }
-                JlFree( dictionaryItem->KeyName );
+                if( !dictionaryItem->KeyNameIsReference )
+                {
+                    JlFree( dictionaryItem->KeyName );
+                }
                 dictionaryItem->KeyName = NULL;
                 jlStatus = JlFreeObjectTree( &dictionaryItem->Object );
                 prevDictionaryItem = dictionaryItem;
@@ -1556,3 +1954,252 @@ JL_STATUS
 
     return jlStatus;
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlSetObjectLazySpan
+//
+//  Marks an empty list or dictionary object as not yet parsed. Json is JsonLength bytes from its opening bracket to its
+//  closing bracket and must remain valid until the object is parsed or freed. Declared in JlLazy.h
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlSetObjectLazySpan
+    (
+        JlDataObject*   ContainerObject,
+        char const*     Json,
+        size_t          JsonLength,
+        bool            IsJson5
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != ContainerObject
+        &&  NULL != Json
+        &&  JsonLength >= 2 )
+    {
+        if(     JL_DATA_TYPE_LIST == ContainerObject->Type
+            &&  NULL == ContainerObject->List.ListHead
+            &&  !ContainerObject->IsLazy )
+        {
+            jlStatus = JL_STATUS_SUCCESS;
+        }
+        else if(    JL_DATA_TYPE_DICTIONARY == ContainerObject->Type
+                &&  NULL == ContainerObject->Dictionary.DictionaryHead
+                &&  !ContainerObject->IsLazy )
+        {
+            jlStatus = JL_STATUS_SUCCESS;
+        }
+        else
+        {
+            jlStatus = JL_STATUS_WRONG_TYPE;
+        }
+
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            ContainerObject->Lazy.Json = Json;
+            ContainerObject->Lazy.JsonLength = JsonLength;
+            ContainerObject->Lazy.IsJson5 = IsJson5;
+            ContainerObject->IsLazy = true;
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlSetObjectStringSpan
+//
+//  Sets a string object to a quoted string in the input which is unescaped the first time it is read. Json is
+//  JsonLength bytes from the opening quote to the closing quote and must remain valid until the object is read, freed,
+//  or set to another value. Declared in JlLazy.h
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlSetObjectStringSpan
+    (
+        JlDataObject*   StringObject,
+        char const*     Json,
+        size_t          JsonLength,
+        bool            IsJson5,
+        bool            HasEscapes
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != StringObject
+        &&  NULL != Json
+        &&  JsonLength >= 2 )
+    {
+        if( JL_DATA_TYPE_STRING == StringObject->Type )
+        {
+            ReleaseObjectString( StringObject );
+            StringObject->Lazy.Json = Json;
+            StringObject->Lazy.JsonLength = JsonLength;
+            StringObject->Lazy.IsJson5 = IsJson5;
+            StringObject->Lazy.HasEscapes = HasEscapes;
+            StringObject->IsLazy = true;
+            jlStatus = JL_STATUS_SUCCESS;
+        }
+        else
+        {
+            jlStatus = JL_STATUS_WRONG_TYPE;
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlGetObjectStringSpan
+//
+//  Gets the quoted span of a string object that has not been read since it was set with JlSetObjectStringSpan.
+//  Returns JL_STATUS_NOT_FOUND if the string has no span. Declared in JlLazy.h
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlGetObjectStringSpan
+    (
+        JlDataObject const*     StringObject,
+        char const**            pJson,
+        size_t*                 pJsonLength,
+        bool*                   pIsJson5,
+        bool*                   pHasEscapes
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != StringObject
+        &&  NULL != pJson
+        &&  NULL != pJsonLength
+        &&  NULL != pIsJson5
+        &&  NULL != pHasEscapes )
+    {
+        if(     JL_DATA_TYPE_STRING == StringObject->Type
+            &&  StringObject->IsLazy )
+        {
+            *pJson = StringObject->Lazy.Json;
+            *pJsonLength = StringObject->Lazy.JsonLength;
+            *pIsJson5 = StringObject->Lazy.IsJson5;
+            *pHasEscapes = StringObject->Lazy.HasEscapes;
+            jlStatus = JL_STATUS_SUCCESS;
+        }
+        else
+        {
+            jlStatus = ( JL_DATA_TYPE_STRING == StringObject->Type ) ? JL_STATUS_NOT_FOUND : JL_STATUS_WRONG_TYPE;
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlSetObjectNumberText
+//
+//  Sets a number object to the text of a number which is converted the first time it is read. Text must remain valid
+//  until the object is freed or set to another value. Declared in JlLazy.h
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlSetObjectNumberText
+    (
+        JlDataObject*   NumberObject,
+        char const*     Text,
+        size_t          TextLength
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != NumberObject
+        &&  NULL != Text
+        &&  TextLength > 0
+        &&  TextLength <= UINT16_MAX )
+    {
+        if( JL_DATA_TYPE_NUMBER == NumberObject->Type )
+        {
+            // Number.Type is left as JL_NUM_TYPE_NONE until the text is converted
+            memset( &NumberObject->Number, 0, sizeof(NumberObject->Number) );
+            NumberObject->NumberText = Text;
+            NumberObject->NumberTextLength = (uint16_t)TextLength;
+            jlStatus = JL_STATUS_SUCCESS;
+        }
+        else
+        {
+            jlStatus = JL_STATUS_WRONG_TYPE;
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlMoveListItems
+//
+//  Moves all the items of SourceList onto the end of DestinationList, leaving SourceList empty. Declared in
+//  JlParseSlice.h
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlMoveListItems
+    (
+        JlDataObject*   DestinationList,
+        JlDataObject*   SourceList
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != DestinationList
+        &&  NULL != SourceList
+        &&  DestinationList != SourceList )
+    {
+        if(     JL_DATA_TYPE_LIST == DestinationList->Type
+            &&  JL_DATA_TYPE_LIST == SourceList->Type
+            &&  !DestinationList->IsLazy
+            &&  !SourceList->IsLazy )
+        {
+            if( NULL != SourceList->List.ListHead )
+            {
+                for( JlListItem* item=SourceList->List.ListHead; item!=NULL; item=item->Next )
+                {
+                    item->ParentList = &DestinationList->List;
+                }
+
+                if( NULL != DestinationList->List.ListTail )
+                {
+                    DestinationList->List.ListTail->Next = SourceList->List.ListHead;
+                }
+                else
+                {
+                    DestinationList->List.ListHead = SourceList->List.ListHead;
+                }
+                DestinationList->List.ListTail = SourceList->List.ListTail;
+                DestinationList->List.Count += SourceList->List.Count;
+
+                SourceList->List.ListHead = NULL;
+                SourceList->List.ListTail = NULL;
+                SourceList->List.Count = 0;
+            }
+            jlStatus = JL_STATUS_SUCCESS;
+        }
+        else
+        {
+            jlStatus = JL_STATUS_WRONG_TYPE;
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
@@ -0,0 +1,259 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JsonLib
+//
+//  This module maps a file into memory read only so that it can be parsed where it is without reading it into a heap
+//  buffer. It uses mmap, or the Win32 API when built for Windows.
+//
+//  This is free and unencumbered software released into the public domain - November 2019 waterjuice.org
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  IMPORTS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if !defined( _WIN32 )
+    // Use a 64 bit off_t on 32 bit systems so that the size of files over 2 GB can be read
+    #define _FILE_OFFSET_BITS 64
+#endif
+
+#include "JlFileMap.h"
+#include "JlMemory.h"
+#include "JlStatus.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined( _WIN32 )
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TYPES
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct JlFileMap
+{
+    void*           Data;               // NULL for an empty file, which is not mapped
+    size_t          DataLength;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PRIVATE FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  MapFile
+//
+//  Maps the whole of the file read only into the address space. *pData is left NULL for an empty file.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+#if defined( _WIN32 )
+static
+JL_STATUS
+    MapFile
+    (
+        char const*     Filename,
+        void**          pData,
+        size_t*         pDataLength
+    )
+{
+    JL_STATUS jlStatus;
+    HANDLE fileHandle;
+
+    fileHandle = CreateFileA(
+        Filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+    if( INVALID_HANDLE_VALUE != fileHandle )
+    {
+        LARGE_INTEGER fileSize;
+
+        if( !GetFileSizeEx( fileHandle, &fileSize ) )
+        {
+            jlStatus = JL_STATUS_FILE_ERROR;
+        }
+        else if( (uint64_t)fileSize.QuadPart > SIZE_MAX )
+        {
+            jlStatus = JL_STATUS_OUT_OF_MEMORY;
+        }
+        else if( 0 == fileSize.QuadPart )
+        {
+            // An empty file can not be mapped
+            jlStatus = JL_STATUS_SUCCESS;
+        }
+        else
+        {
+            // The view stays valid after the handles are closed, until it is unmapped
+            HANDLE mappingHandle = CreateFileMappingA( fileHandle, NULL, PAGE_READONLY, 0, 0, NULL );
+            if( NULL != mappingHandle )
+            {
+                *pData = MapViewOfFile( mappingHandle, FILE_MAP_READ, 0, 0, 0 );
+                *pDataLength = (size_t)fileSize.QuadPart;
+                jlStatus = ( NULL != *pData ) ? JL_STATUS_SUCCESS : JL_STATUS_OUT_OF_MEMORY;
+                CloseHandle( mappingHandle );
+            }
+            else
+            {
+                jlStatus = JL_STATUS_FILE_ERROR;
+            }
+        }
+
+        CloseHandle( fileHandle );
+    }
+    else
+    {
+        jlStatus = JL_STATUS_FILE_ERROR;
+    }
+
+    return jlStatus;
+}
+#else
+static
+JL_STATUS
+    MapFile
+    (
+        char const*     Filename,
+        void**          pData,
+        size_t*         pDataLength
+    )
+{
+    JL_STATUS jlStatus;
+    int fileHandle;
+
+    fileHandle = open( Filename, O_RDONLY );
+    if( fileHandle >= 0 )
+    {
+        struct stat fileInfo;
+
+        if( 0 != fstat( fileHandle, &fileInfo ) || !S_ISREG( fileInfo.st_mode ) )
+        {
+            jlStatus = JL_STATUS_FILE_ERROR;
+        }
+        else if( (uint64_t)fileInfo.st_size > SIZE_MAX )
+        {
+            jlStatus = JL_STATUS_OUT_OF_MEMORY;
+        }
+        else if( 0 == fileInfo.st_size )
+        {
+            // An empty file can not be mapped
+            jlStatus = JL_STATUS_SUCCESS;
+        }
+        else
+        {
+            // The mapping stays valid after the file is closed, until it is unmapped
+            void* data = mmap( NULL, (size_t)fileInfo.st_size, PROT_READ, MAP_PRIVATE, fileHandle, 0 );
+            if( MAP_FAILED != data )
+            {
+                (void) posix_madvise( data, (size_t)fileInfo.st_size, POSIX_MADV_SEQUENTIAL );
+                *pData = data;
+                *pDataLength = (size_t)fileInfo.st_size;
+                jlStatus = JL_STATUS_SUCCESS;
+            }
+            else
+            {
+                jlStatus = ( ENOMEM == errno ) ? JL_STATUS_OUT_OF_MEMORY : JL_STATUS_FILE_ERROR;
+            }
+        }
+
+        close( fileHandle );
+    }
+    else
+    {
+        jlStatus = JL_STATUS_FILE_ERROR;
+    }
+
+    return jlStatus;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlFileMapCreate
+//
+//  Maps the whole of the file Filename into memory read only. See JlFileMap.h.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlFileMapCreate
+    (
+        char const*     Filename,
+        JlFileMap**     pFileMap,
+        char const**    pData,
+        size_t*         pDataLength
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != Filename
+        &&  NULL != pFileMap
+        &&  NULL != pData
+        &&  NULL != pDataLength )
+    {
+        JlFileMap* fileMap = JlNew( JlFileMap );
+        if( NULL != fileMap )
+        {
+            jlStatus = MapFile( Filename, &fileMap->Data, &fileMap->DataLength );
+            if( JL_STATUS_SUCCESS == jlStatus )
+            {
+                *pFileMap = fileMap;
+                *pData = ( NULL != fileMap->Data ) ? fileMap->Data : "";
+                *pDataLength = fileMap->DataLength;
+            }
+            else
+            {
+                JlFree( fileMap );
+            }
+        }
+        else
+        {
+            jlStatus = JL_STATUS_OUT_OF_MEMORY;
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlFileMapFree
+//
+//  Unmaps a file mapped with JlFileMapCreate. *pFileMap will be set to NULL.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlFileMapFree
+    (
+        JlFileMap**     pFileMap
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != pFileMap
+        &&  NULL != *pFileMap )
+    {
+        if( NULL != (*pFileMap)->Data )
+        {
+#if defined( _WIN32 )
+            UnmapViewOfFile( (*pFileMap)->Data );
+#else
+            munmap( (*pFileMap)->Data, (*pFileMap)->DataLength );
+#endif
+        }
+        JlFree( *pFileMap );
+        *pFileMap = NULL;
+        jlStatus = JL_STATUS_SUCCESS;
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
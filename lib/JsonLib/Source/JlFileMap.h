@@ -0,0 +1,59 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JsonLib
+//
+//  This module maps a file into memory read only so that it can be parsed where it is without reading it into a heap
+//  buffer. It uses mmap, or the Win32 API when built for Windows. Files larger than 2 GB are supported wherever they
+//  fit in the address space.
+//
+//  This is free and unencumbered software released into the public domain - November 2019 waterjuice.org
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  IMPORTS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "JlStatus.h"
+#include <stdint.h>
+#include <stddef.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TYPES
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef struct JlFileMap JlFileMap;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlFileMapCreate
+//
+//  Maps the whole of the file Filename into memory read only. *pData is set to the contents, which stay valid until
+//  the map is freed with JlFileMapFree, and *pDataLength to the size of the file. The contents are not zero
+//  terminated. An empty file gives a length of 0. The mapping is marked for sequential access, so the system reads
+//  ahead and drops pages once they have been used.
+//  Returns JL_STATUS_FILE_ERROR if the file can not be opened or mapped, or JL_STATUS_OUT_OF_MEMORY if it is too large
+//  to fit in the address space.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlFileMapCreate
+    (
+        char const*     Filename,
+        JlFileMap**     pFileMap,
+        char const**    pData,
+        size_t*         pDataLength
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlFileMapFree
+//
+//  Unmaps a file mapped with JlFileMapCreate. *pFileMap will be set to NULL.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlFileMapFree
+    (
+        JlFileMap**     pFileMap
+    );
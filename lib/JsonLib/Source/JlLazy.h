@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JsonLib
+//
+//  This module links the data model and the parser for lazy parsing (JL_PARSE_FLAGS_LAZY). The parser records lists
+//  and dictionaries below the root as spans of the input without parsing them, and the data model parses a span into
+//  real child objects the first time the list or dictionary is used.
+//  Numbers from a parse with JL_PARSE_FLAGS_RAW_NUMBERS are handled in the same way: the parser records their text and
+//  the data model converts it the first time the number is read. So are strings from a parse with
+//  JL_PARSE_FLAGS_RAW_STRINGS, which are unescaped the first time they are read.
+//
+//  This is free and unencumbered software released into the public domain - November 2019 waterjuice.org
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  IMPORTS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "JlStatus.h"
+#include "JlDataModel.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlSetObjectLazySpan
+//
+//  Marks an empty list or dictionary object as not yet parsed. Json is JsonLength bytes from its opening bracket to its
+//  closing bracket and must remain valid until the object is parsed or freed. (Implemented in JlDataModel.c)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlSetObjectLazySpan
+    (
+        JlDataObject*   ContainerObject,
+        char const*     Json,
+        size_t          JsonLength,
+        bool            IsJson5
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParseLazySpan
+//
+//  Parses the span of a lazy list or dictionary into a new object of the same type. Lists and dictionaries within it
+//  are left as lazy spans themselves. BaseOffset is the position of the span in the original input, used for the
+//  object tags. (Implemented in JlParseJson.c)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParseLazySpan
+    (
+        char const*     Json,
+        size_t          JsonLength,
+        bool            IsJson5,
+        size_t          BaseOffset,
+        JlDataObject**  pContainerObject
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlSetObjectNumberText
+//
+//  Sets a number object to TextLength bytes of Text, which is the text of a number that is converted the first time it
+//  is read. The text must be a number that JlNumberStringToNumber converts without error, and must remain valid until
+//  the object is freed or set to another value. TextLength can be no more than UINT16_MAX. (Implemented in
+//  JlDataModel.c)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlSetObjectNumberText
+    (
+        JlDataObject*   NumberObject,
+        char const*     Text,
+        size_t          TextLength
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlSetObjectStringSpan
+//
+//  Sets a string object to a quoted string in the input which is unescaped the first time it is read. Json is
+//  JsonLength bytes from the opening quote to the closing quote, and must be a string that the parser has already
+//  checked. HasEscapes is false if there are no escapes between the quotes. Json must remain valid until the object is
+//  read, freed, or set to another value. (Implemented in JlDataModel.c)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlSetObjectStringSpan
+    (
+        JlDataObject*   StringObject,
+        char const*     Json,
+        size_t          JsonLength,
+        bool            IsJson5,
+        bool            HasEscapes
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlGetObjectStringSpan
+//
+//  Gets the quoted span of a string object that has not been read since it was set with JlSetObjectStringSpan.
+//  Returns JL_STATUS_NOT_FOUND if the string has no span, or JL_STATUS_WRONG_TYPE if it is not a string object.
+//  (Implemented in JlDataModel.c)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlGetObjectStringSpan
+    (
+        JlDataObject const*     StringObject,
+        char const**            pJson,
+        size_t*                 pJsonLength,
+        bool*                   pIsJson5,
+        bool*                   pHasEscapes
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlUnescapeStringSpan
+//
+//  Unescapes the span of a string set with JlSetObjectStringSpan into a new string allocated with JlAlloc, which the
+//  caller takes ownership of. An empty string gives NULL, as it would from a normal parse. (Implemented in
+//  JlParseJson.c)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlUnescapeStringSpan
+    (
+        char const*     Json,
+        size_t          JsonLength,
+        bool            IsJson5,
+        bool            HasEscapes,
+        char**          pString
+    );
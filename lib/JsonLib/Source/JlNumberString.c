@@ -0,0 +1,475 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JsonLib
+//
+//  This module converts the text of a JSON number into a JlNumber. It is used by the data model when a number object
+//  is set from a string, and by the parser when validating without building an object tree.
+//
+//  This is free and unencumbered software released into the public domain - November 2019 waterjuice.org
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  IMPORTS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "JlNumberString.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+
+#ifndef _MSC_VER
+    #include <inttypes.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  DEFINES
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef _MSC_VER
+    #define PRId64 "lld"
+    #define isnan _isnan
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  CONSTANTS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Powers of ten that can be represented exactly as a double
+static double const EXACT_POWERS_OF_TEN[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+// The largest number of decimal digits that always fit in a uint64_t
+#define MAX_SIGNIFICAND_DIGITS          19
+
+// Exponents are limited to this size while being read. Anything this large is already out of range of a double.
+#define MAX_EXPONENT_READ               100000
+
+// No more than 768 significant digits can affect which double a decimal number rounds to. Digits beyond this are
+// replaced by a single non zero digit if any of them are non zero.
+#define MAX_CONVERTED_DIGITS            800
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  MACROS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef _MSC_VER
+    #define strncasecmp strnicmp
+#endif
+
+// Multiplying or dividing two exact doubles only gives the correctly rounded result if the arithmetic is done at
+// double precision (not x87 extended precision).
+#if ( defined( FLT_EVAL_METHOD ) && 0 == FLT_EVAL_METHOD ) || defined( _M_X64 )
+    #define EXACT_DOUBLE_ARITHMETIC     true
+#else
+    #define EXACT_DOUBLE_ARITHMETIC     false
+#endif
+
+#define IsDigit( Char )     ( (Char) >= '0' && (Char) <= '9' )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PRIVATE FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ConvertDigitsToDouble
+//
+//  Converts a decimal number to the nearest double when the fast conversion can not be used. The number is given as
+//  the digits of the number (with the decimal point removed) and a power of ten. The digits are written out with the
+//  exponent and converted by strtod. There is no decimal point in the string so the result does not depend on the
+//  locale. The digits may be split by a decimal point in the source, which is skipped. Leading zeros are dropped and
+//  only the first MAX_CONVERTED_DIGITS significant digits are kept, so this always fits in a buffer on the stack.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+double
+    ConvertDigitsToDouble
+    (
+        char const*     Digits,
+        size_t          DigitsLength,
+        int64_t         Exponent
+    )
+{
+    char buffer [MAX_CONVERTED_DIGITS + 32];
+    size_t length = 0;
+    int64_t exponent = Exponent;
+    bool isTruncated = false;
+
+    for( size_t i=0; i<DigitsLength; i++ )
+    {
+        if( !IsDigit( Digits[i] ) || ( 0 == length && '0' == Digits[i] ) )
+        {
+            // Decimal point or leading zero
+        }
+        else if( length < MAX_CONVERTED_DIGITS )
+        {
+            buffer[length] = Digits[i];
+            length += 1;
+        }
+        else
+        {
+            exponent += 1;
+            isTruncated = isTruncated || '0' != Digits[i];
+        }
+    }
+
+    if( isTruncated )
+    {
+        // Keeps the number from looking like it is exactly half way between two doubles
+        buffer[length] = '1';
+        length += 1;
+        exponent -= 1;
+    }
+    if( 0 == length )
+    {
+        buffer[length] = '0';
+        length += 1;
+    }
+    snprintf( buffer+length, sizeof(buffer)-length, "e%"PRId64"", exponent );
+
+    return strtod( buffer, NULL );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ConvertDecimalNumberString
+//
+//  Converts a decimal number string in one pass. The string must be an optional sign, digits with an optional
+//  decimal point, and an optional exponent. The number is unsigned or signed if it is written exactly as that integer
+//  would be printed (no plus sign, leading zeros, decimal point, or exponent) and fits, otherwise it is a float.
+//  Floats with up to 2^53 significand and a power of ten up to 22 are converted exactly with a single multiply or
+//  divide. Others are converted by ConvertDigitsToDouble. Returns JL_STATUS_INVALID_DATA if the string is not a
+//  decimal number.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    ConvertDecimalNumberString
+    (
+        char const*     NumberString,
+        size_t          NumberStringLength,
+        JlNumber*       pNumber
+    )
+{
+    JL_STATUS jlStatus = JL_STATUS_SUCCESS;
+    char const* pos = NumberString;
+    char const* end = NumberString + NumberStringLength;
+    char const* digitsStart;
+    bool isNegative = false;
+    bool hasSign = false;
+    bool isInteger = true;
+    uint64_t integerValue = 0;
+    bool integerOverflow = false;
+    size_t numIntegerDigits = 0;
+    size_t numFractionDigits = 0;
+    uint64_t significand = 0;
+    int numSignificantDigits = 0;
+    bool isTruncated = false;
+    int64_t exponent = 0;
+    int64_t exponentRead = 0;
+
+    if( pos < end && ( '-' == *pos || '+' == *pos ) )
+    {
+        isNegative = '-' == *pos;
+        hasSign = true;
+        pos += 1;
+    }
+    digitsStart = pos;
+
+    // Integer part. The first 19 significant digits are kept as the significand, beyond that the digits are dropped
+    // and the exponent is increased instead.
+    while( pos < end && IsDigit( *pos ) )
+    {
+        uint32_t digit = (uint32_t)( *pos - '0' );
+        if( integerValue > ( UINT64_MAX - digit ) / 10 )
+        {
+            integerOverflow = true;
+        }
+        else
+        {
+            integerValue = integerValue * 10 + digit;
+        }
+
+        if( numSignificantDigits < MAX_SIGNIFICAND_DIGITS )
+        {
+            significand = significand * 10 + digit;
+            numSignificantDigits += ( 0 != significand ) ? 1 : 0;
+        }
+        else
+        {
+            exponent += 1;
+            isTruncated = isTruncated || 0 != digit;
+        }
+        numIntegerDigits += 1;
+        pos += 1;
+    }
+
+    // Fraction part
+    if( pos < end && '.' == *pos )
+    {
+        isInteger = false;
+        pos += 1;
+        while( pos < end && IsDigit( *pos ) )
+        {
+            uint32_t digit = (uint32_t)( *pos - '0' );
+            if( numSignificantDigits < MAX_SIGNIFICAND_DIGITS )
+            {
+                significand = significand * 10 + digit;
+                numSignificantDigits += ( 0 != significand ) ? 1 : 0;
+                exponent -= 1;
+            }
+            else
+            {
+                isTruncated = isTruncated || 0 != digit;
+            }
+            numFractionDigits += 1;
+            pos += 1;
+        }
+    }
+
+    if( 0 == numIntegerDigits + numFractionDigits )
+    {
+        jlStatus = JL_STATUS_INVALID_DATA;
+    }
+
+    // Exponent
+    if(     JL_STATUS_SUCCESS == jlStatus
+        &&  pos < end
+        &&  ( 'e' == *pos || 'E' == *pos ) )
+    {
+        bool isExponentNegative = false;
+
+        isInteger = false;
+        pos += 1;
+        if( pos < end && ( '-' == *pos || '+' == *pos ) )
+        {
+            isExponentNegative = '-' == *pos;
+            pos += 1;
+        }
+
+        if( pos >= end || !IsDigit( *pos ) )
+        {
+            jlStatus = JL_STATUS_INVALID_DATA;
+        }
+        while( pos < end && IsDigit( *pos ) )
+        {
+            if( exponentRead < MAX_EXPONENT_READ )
+            {
+                exponentRead = exponentRead * 10 + ( *pos - '0' );
+            }
+            pos += 1;
+        }
+        exponentRead = isExponentNegative ? -exponentRead : exponentRead;
+        exponent += exponentRead;
+    }
+
+    if( pos != end )
+    {
+        jlStatus = JL_STATUS_INVALID_DATA;
+    }
+
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        bool isPlainInteger =
+                isInteger
+            &&  !integerOverflow
+            &&  ( 1 == numIntegerDigits || '0' != digitsStart[0] );
+
+        pNumber->IsHex = false;
+        if( isPlainInteger && !hasSign )
+        {
+            pNumber->Type = JL_NUM_TYPE_UNSIGNED;
+            pNumber->u64 = integerValue;
+        }
+        else if(    isPlainInteger
+                &&  isNegative
+                &&  0 != integerValue
+                &&  integerValue <= (uint64_t)INT64_MAX + 1 )
+        {
+            pNumber->Type = JL_NUM_TYPE_SIGNED;
+            pNumber->s64 = ( (uint64_t)INT64_MAX + 1 == integerValue ) ? INT64_MIN : -(int64_t)integerValue;
+        }
+        else
+        {
+            pNumber->Type = JL_NUM_TYPE_FLOAT;
+            if( 0 == significand )
+            {
+                pNumber->f64 = 0.0;
+            }
+            else if(    EXACT_DOUBLE_ARITHMETIC
+                    &&  !isTruncated
+                    &&  significand <= ( (uint64_t)1 << 53 )
+                    &&  exponent >= -22
+                    &&  exponent <= 22 )
+            {
+                // Both the significand and the power of ten are exact so a single operation gives the correctly
+                // rounded result.
+                pNumber->f64 = exponent < 0
+                    ? (double)significand / EXACT_POWERS_OF_TEN[-exponent]
+                    : (double)significand * EXACT_POWERS_OF_TEN[exponent];
+            }
+            else
+            {
+                pNumber->f64 = ConvertDigitsToDouble(
+                    digitsStart,
+                    numIntegerDigits + numFractionDigits + ( numFractionDigits > 0 ? 1 : 0 ),
+                    exponentRead - (int64_t)numFractionDigits );
+            }
+
+            pNumber->f64 = isNegative ? -pNumber->f64 : pNumber->f64;
+        }
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ConvertHexNumberString
+//
+//  Converts a hex number string starting with 0x. Leading zeros are allowed as long as the value fits in a uint64_t.
+//  Returns JL_STATUS_INVALID_DATA if the string is not a hex number or is too large.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    ConvertHexNumberString
+    (
+        char const*     NumberString,
+        size_t          NumberStringLength,
+        JlNumber*       pNumber
+    )
+{
+    JL_STATUS jlStatus = NumberStringLength > 2 ? JL_STATUS_SUCCESS : JL_STATUS_INVALID_DATA;
+    uint64_t value = 0;
+
+    for( size_t i=2; i<NumberStringLength && JL_STATUS_SUCCESS == jlStatus; i++ )
+    {
+        char hexChar = NumberString[i];
+        uint32_t digit = 0;
+
+        if( IsDigit( hexChar ) )
+        {
+            digit = (uint32_t)( hexChar - '0' );
+        }
+        else if( hexChar >= 'a' && hexChar <= 'f' )
+        {
+            digit = (uint32_t)( hexChar - 'a' ) + 10;
+        }
+        else if( hexChar >= 'A' && hexChar <= 'F' )
+        {
+            digit = (uint32_t)( hexChar - 'A' ) + 10;
+        }
+        else
+        {
+            jlStatus = JL_STATUS_INVALID_DATA;
+        }
+
+        if( value > ( UINT64_MAX >> 4 ) )
+        {
+            jlStatus = JL_STATUS_INVALID_DATA;
+        }
+        value = ( value << 4 ) | digit;
+    }
+
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        pNumber->Type = JL_NUM_TYPE_UNSIGNED;
+        pNumber->u64 = value;
+        pNumber->IsHex = true;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlNumberStringToNumber
+//
+//  Converts the NumberStringLength bytes of NumberString, which do not need to be zero terminated, into *pNumber.
+//  The string may be a decimal number (with optional sign, decimal point, and exponent), a hex number starting with
+//  0x, or inf, +inf, -inf, or nan. Returns JL_STATUS_INVALID_DATA if it is none of these, or if it is a float that is
+//  zero or too large to be represented. No memory is allocated.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlNumberStringToNumber
+    (
+        char const*     NumberString,
+        size_t          NumberStringLength,
+        JlNumber*       pNumber
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != NumberString
+        &&  NULL != pNumber )
+    {
+        if(     NumberStringLength >= 2
+            &&  '0' == NumberString[0]
+            &&  ( 'x' == NumberString[1] || 'X' == NumberString[1] ) )
+        {
+            // Hex
+            jlStatus = ConvertHexNumberString( NumberString, NumberStringLength, pNumber );
+        }
+        else
+        {
+            // Decimal. Classified as unsigned, signed, or float while it is converted.
+            jlStatus = ConvertDecimalNumberString( NumberString, NumberStringLength, pNumber );
+            if(     JL_STATUS_SUCCESS == jlStatus
+                &&  JL_NUM_TYPE_FLOAT == pNumber->Type )
+            {
+                double a_inf = DBL_MAX * 2.0;
+                double a_ninf = DBL_MAX * -2.0;
+
+                if(     0.0 == pNumber->f64
+                    ||  isnan( pNumber->f64 )
+                    ||  a_inf == pNumber->f64
+                    ||  a_ninf == pNumber->f64 )
+                {
+                    // Zero floats (including -0), and numbers too large to be represented are not accepted.
+                    jlStatus = JL_STATUS_INVALID_DATA;
+                }
+            }
+        }
+
+        if( JL_STATUS_SUCCESS != jlStatus )
+        {
+            // Try to convert as inf, +inf, -inf, or nan
+            pNumber->Type = JL_NUM_TYPE_FLOAT;
+            pNumber->IsHex = false;
+            if(     ( 3 == NumberStringLength && strncasecmp( NumberString, "inf", 3 ) == 0 )
+                ||  ( 4 == NumberStringLength && strncasecmp( NumberString, "+inf", 4 ) == 0 ) )
+            {
+                pNumber->f64 = DBL_MAX * 2.0;
+                jlStatus = JL_STATUS_SUCCESS;
+            }
+            else if( 4 == NumberStringLength && strncasecmp( NumberString, "-inf", 4 ) == 0 )
+            {
+                pNumber->f64 = DBL_MAX * -2.0;
+                jlStatus = JL_STATUS_SUCCESS;
+            }
+            else if( 3 == NumberStringLength && strncasecmp( NumberString, "nan", 3 ) == 0 )
+            {
+                union
+                {
+                    uint64_t    bits;
+                    double      f64;
+                } a_nan = { 0x7fffffffffffffffULL };      // Set all bits except sign to make a NaN
+
+                pNumber->f64 = a_nan.f64;
+                jlStatus = JL_STATUS_SUCCESS;
+            }
+            else
+            {
+                pNumber->Type = JL_NUM_TYPE_NONE;
+            }
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
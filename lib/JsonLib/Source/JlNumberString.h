@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JsonLib
+//
+//  This module converts the text of a JSON number into a JlNumber. It is used by the data model when a number object
+//  is set from a string, and by the parser when validating without building an object tree.
+//
+//  This is free and unencumbered software released into the public domain - November 2019 waterjuice.org
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  IMPORTS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "JlStatus.h"
+#include "JlDataModel.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TYPES
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// IsHex is placed after Type where it fits in the padding, keeping a number object no larger than the other types
+struct JlNumber
+{
+    JL_NUM_TYPE     Type;
+    bool            IsHex;      // Only relevant when Type is JL_NUM_TYPE_UNSIGNED
+    union
+    {
+        // JL_NUM_TYPE_UNSIGNED
+        uint64_t    u64;
+        // JL_NUM_TYPE_SIGNED
+        int64_t     s64;
+        // JL_NUM_TYPE_FLOAT
+        double      f64;
+    };
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlNumberStringToNumber
+//
+//  Converts the NumberStringLength bytes of NumberString, which do not need to be zero terminated, into *pNumber.
+//  The string may be a decimal number (with optional sign, decimal point, and exponent), a hex number starting with
+//  0x, or inf, +inf, -inf, or nan. Returns JL_STATUS_INVALID_DATA if it is none of these, or if it is a float that is
+//  zero or too large to be represented. No memory is allocated.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlNumberStringToNumber
+    (
+        char const*     NumberString,
+        size_t          NumberStringLength,
+        JlNumber*       pNumber
+    );
@@ -14,6 +14,9 @@
 #include "JlBuffer.h"
 #include "JlMemory.h"
 #include "JlUnicode.h"
+#include "JlLazy.h"
+#include "JlPlainString.h"
+#include "JlScan.h"
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -104,7 +107,7 @@ JL_STATUS
 //
 //  Outputs the Utf8String to the JsonBuffer. This will escape necessary characters (control chars, and quote char).
 //  Additionally if EscapeAllNonAscii is true then this will escape all characters over 127. Escaped characters will
-//  use UTF16 escaped notation.
+//  use UTF16 escaped notation. Runs of ASCII characters that need no escaping are added in one go.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 static
 JL_STATUS
@@ -122,82 +125,95 @@ JL_STATUS
 
     while( index < Utf8StringLength  &&  JL_STATUS_SUCCESS == jlStatus )
     {
-        // Collect next UTF8 character
-        uint32_t unicodeValue = 0;
-        size_t numBytes;
+        // Add any run of characters that need no escaping in one go
+        char quoteChar = EscapeSingleQuote ? '\'' : '\"';
+        size_t runLength = JlScanPlainAscii( Utf8String+index, Utf8StringLength-index, quoteChar );
+        if( runLength > 0 )
+        {
+            jlStatus = JlBufferAdd( JsonBuffer, Utf8String+index, runLength );
+            index += runLength;
+        }
 
-        jlStatus = JlUnicodeCharFromUtf8( Utf8String+index, Utf8StringLength-index, &unicodeValue, &numBytes );
-        if( JL_STATUS_SUCCESS == jlStatus )
+        if( index < Utf8StringLength  &&  JL_STATUS_SUCCESS == jlStatus )
         {
-            if(    (unicodeValue >= 32 && unicodeValue <= 127 && unicodeValue != '\"' && unicodeValue != '\\' && unicodeValue != '\'')
-                || (unicodeValue > 127 && !EscapeAllNonAscii) )
-            {
-                // Single ASCII character, or multibyte utf8 and we are not escaping all non ascii. No need
-                // to use the conversion to unicode, just copy in the original bytes
-                jlStatus = JlBufferAdd( JsonBuffer, Utf8String+index, numBytes );
-            }
-            else if( '\"' == unicodeValue )
-            {
-                jlStatus = JlBufferAdd( JsonBuffer, "\\\"", 2 );
-            }
-            else if( '\\' == unicodeValue )
-            {
-                jlStatus = JlBufferAdd( JsonBuffer, "\\\\", 2 );
-            }
-            else if( '\b' == unicodeValue )
-            {
-                jlStatus = JlBufferAdd( JsonBuffer, "\\b", 2 );
-            }
-            else if( '\f' == unicodeValue )
-            {
-                jlStatus = JlBufferAdd( JsonBuffer, "\\f", 2 );
-            }
-            else if( '\n' == unicodeValue )
-            {
-                jlStatus = JlBufferAdd( JsonBuffer, "\\n", 2 );
-            }
-            else if( '\r' == unicodeValue )
-            {
-                jlStatus = JlBufferAdd( JsonBuffer, "\\r", 2 );
-            }
-            else if( '\t' == unicodeValue )
-            {
-                jlStatus = JlBufferAdd( JsonBuffer, "\\t", 2 );
-            }
-            else if( '\'' == unicodeValue )
+            // Collect next UTF8 character
+            uint32_t unicodeValue = 0;
+            size_t numBytes;
+
+            jlStatus = JlUnicodeCharFromUtf8( Utf8String+index, Utf8StringLength-index, &unicodeValue, &numBytes );
+            if( JL_STATUS_SUCCESS == jlStatus )
             {
-                if( EscapeSingleQuote )
+                if(    (    unicodeValue >= 32 && unicodeValue <= 127
+                            &&  unicodeValue != '\"' && unicodeValue != '\\' && unicodeValue != '\'' )
+                    || (unicodeValue > 127 && !EscapeAllNonAscii) )
                 {
-                    jlStatus = JlBufferAdd( JsonBuffer, "\\'", 2 );
+                    // Single ASCII character, or multibyte utf8 and we are not escaping all non ascii. No need
+                    // to use the conversion to unicode, just copy in the original bytes
+                    jlStatus = JlBufferAdd( JsonBuffer, Utf8String+index, numBytes );
                 }
-                else
+                else if( '\"' == unicodeValue )
                 {
-                    jlStatus = JlBufferAdd( JsonBuffer, "'", 1 );
+                    jlStatus = JlBufferAdd( JsonBuffer, "\\\"", 2 );
                 }
-            }
-            else
-            {
-                // Requires escaping using UTF16 escaped notation \uxxxx[\uxxxx]
-                if( unicodeValue < 0xffff )
+                else if( '\\' == unicodeValue )
+                {
+                    jlStatus = JlBufferAdd( JsonBuffer, "\\\\", 2 );
+                }
+                else if( '\b' == unicodeValue )
                 {
-                    // Requires a single UTF16 word
-                    char string[7] = {0};
-                    sprintf( string, "\\u%4.4x", unicodeValue );
-                    jlStatus = JlBufferAdd( JsonBuffer, string, 6 );
+                    jlStatus = JlBufferAdd( JsonBuffer, "\\b", 2 );
+                }
+                else if( '\f' == unicodeValue )
+                {
+                    jlStatus = JlBufferAdd( JsonBuffer, "\\f", 2 );
+                }
+                else if( '\n' == unicodeValue )
+                {
+                    jlStatus = JlBufferAdd( JsonBuffer, "\\n", 2 );
+                }
+                else if( '\r' == unicodeValue )
+                {
+                    jlStatus = JlBufferAdd( JsonBuffer, "\\r", 2 );
+                }
+                else if( '\t' == unicodeValue )
+                {
+                    jlStatus = JlBufferAdd( JsonBuffer, "\\t", 2 );
+                }
+                else if( '\'' == unicodeValue )
+                {
+                    if( EscapeSingleQuote )
+                    {
+                        jlStatus = JlBufferAdd( JsonBuffer, "\\'", 2 );
+                    }
+                    else
+                    {
+                        jlStatus = JlBufferAdd( JsonBuffer, "'", 1 );
+                    }
                 }
                 else
                 {
-                    // Requires two UTF16 words (high and low surrogate pairs)
-                    char string[13] = {0};
-                    uint32_t highSurrogate = ( unicodeValue - 0x10000 ) >> 10;
-                    uint32_t lowSurrogate  = ( unicodeValue - 0x10000 ) & 0x03ff;
-                    sprintf( string, "\\u%4.4x\\u%4.4x", highSurrogate, lowSurrogate );
-                    jlStatus = JlBufferAdd( JsonBuffer, string, 12 );
+                    // Requires escaping using UTF16 escaped notation \uxxxx[\uxxxx]
+                    if( unicodeValue < 0xffff )
+                    {
+                        // Requires a single UTF16 word
+                        char string[7] = {0};
+                        sprintf( string, "\\u%4.4x", unicodeValue );
+                        jlStatus = JlBufferAdd( JsonBuffer, string, 6 );
+                    }
+                    else
+                    {
+                        // Requires two UTF16 words (high and low surrogate pairs)
+                        char string[13] = {0};
+                        uint32_t highSurrogate = ( unicodeValue - 0x10000 ) >> 10;
+                        uint32_t lowSurrogate  = ( unicodeValue - 0x10000 ) & 0x03ff;
+                        sprintf( string, "\\u%4.4x\\u%4.4x", highSurrogate, lowSurrogate );
+                        jlStatus = JlBufferAdd( JsonBuffer, string, 12 );
+                    }
                 }
             }
-        }
 
-        index += numBytes;
+            index += numBytes;
+        }
     }
 
     return jlStatus;
@@ -206,7 +222,10 @@ JL_STATUS
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  OutputStringObject
 //
-//  Outputs a string object to the json buffer.
+//  Outputs a string object to the json buffer. A string from a parse with JL_PARSE_FLAGS_RAW_STRINGS that has not been
+//  read is output as it was in the input, without unescaping it, if it is double quoted with only Json1 escapes and
+//  the output needs neither single quotes nor ASCII. A string that was found to need no escaping when it was set is
+//  copied as it is.
 //  Warning: This does not check that the object is a string object
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 JL_STATUS
@@ -220,29 +239,54 @@ JL_STATUS
 {
     JL_STATUS jlStatus;
     char const* string = NULL;
+    JL_PLAIN_STRING plain = JL_PLAIN_STRING_NONE;
     char const* const quoteCharStr = OutputFlags & JL_OUTPUT_FLAGS_J5_SINGLE_QUOTES ? "\'" : "\"";
     bool escapeSingleQuote = (OutputFlags & JL_OUTPUT_FLAGS_J5_SINGLE_QUOTES) ? true : false;
     bool escapeNonAscii = (OutputFlags & JL_OUTPUT_FLAGS_ASCII) ? true : false;
-
-    jlStatus = JlGetObjectString( StringObject, &string );
-    if( JL_STATUS_SUCCESS == jlStatus )
+    JL_PLAIN_STRING plainForQuotes = escapeSingleQuote ? JL_PLAIN_STRING_SINGLE_QUOTED : JL_PLAIN_STRING_DOUBLE_QUOTED;
+    char const* span = NULL;
+    size_t spanLength = 0;
+    bool spanIsJson5 = false;
+    bool spanHasEscapes = false;
+
+    if(     !escapeSingleQuote
+        &&  !escapeNonAscii
+        &&  JL_STATUS_SUCCESS == JlGetObjectStringSpan(
+                StringObject, &span, &spanLength, &spanIsJson5, &spanHasEscapes )
+        &&  '\"' == span[0]
+        &&  ( !spanIsJson5 || !spanHasEscapes ) )
+    {
+        // Not read since it was parsed, and already valid for the output. Json5 escapes are not allowed in Json1, so a
+        // Json5 string is only copied if it has no escapes.
+        jlStatus = JlBufferAdd( JsonBuffer, span, spanLength );
+    }
+    else
     {
-        if( NULL != string )
+        jlStatus = JlGetObjectStringPlain( StringObject, &string, &plain );
+        if( JL_STATUS_SUCCESS == jlStatus )
         {
-            jlStatus = JlBufferAdd( JsonBuffer, quoteCharStr, 1 );
-            if( JL_STATUS_SUCCESS == jlStatus )
+            if( NULL != string )
             {
-                jlStatus = OutputUtf8String( string, escapeNonAscii, escapeSingleQuote, JsonBuffer );
+                jlStatus = JlBufferAdd( JsonBuffer, quoteCharStr, 1 );
+                if( JL_STATUS_SUCCESS == jlStatus && ( plain & plainForQuotes ) )
+                {
+                    // Known to need no escaping when it was set
+                    jlStatus = JlBufferAdd( JsonBuffer, string, strlen( string ) );
+                }
+                else if( JL_STATUS_SUCCESS == jlStatus )
+                {
+                    jlStatus = OutputUtf8String( string, escapeNonAscii, escapeSingleQuote, JsonBuffer );
+                }
+                if( JL_STATUS_SUCCESS == jlStatus )
+                {
+                    jlStatus = JlBufferAdd( JsonBuffer, quoteCharStr, 1 );
+                }
             }
-            if( JL_STATUS_SUCCESS == jlStatus )
+            else
             {
-                jlStatus = JlBufferAdd( JsonBuffer, quoteCharStr, 1 );
+                jlStatus = JlBufferAdd( JsonBuffer, "null", 4 );
             }
         }
-        else
-        {
-            jlStatus = JlBufferAdd( JsonBuffer, "null", 4 );
-        }
     }
 
     return jlStatus;
@@ -251,7 +295,8 @@ JL_STATUS
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  OutputNumberObject
 //
-//  Outputs a number object to the json buffer.
+//  Outputs a number object to the json buffer. A number from a parse with JL_PARSE_FLAGS_RAW_NUMBERS that has not been
+//  changed is output exactly as it was in the input, without converting it.
 //  Warning: This does not check that the object is a number object
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 JL_STATUS
@@ -265,59 +310,69 @@ JL_STATUS
 {
     JL_STATUS jlStatus;
     char numString [64] = "";
+    char const* numberText = NULL;
+    size_t numberTextLength = 0;
 
-    JL_NUM_TYPE numType = JlGetObjectNumberType( NumberObject );
-    if( JL_NUM_TYPE_UNSIGNED == numType )
+    if( JL_STATUS_SUCCESS == JlGetObjectNumberText( NumberObject, &numberText, &numberTextLength ) )
     {
-        uint64_t numU64 = 0;
-        jlStatus = JlGetObjectNumberU64( NumberObject, &numU64 );
-        if( JL_STATUS_SUCCESS == jlStatus )
+        // Unchanged number from a JL_PARSE_FLAGS_RAW_NUMBERS parse
+        jlStatus = JlBufferAdd( JsonBuffer, numberText, numberTextLength );
+    }
+    else
+    {
+        JL_NUM_TYPE numType = JlGetObjectNumberType( NumberObject );
+        if( JL_NUM_TYPE_UNSIGNED == numType )
         {
-            if(     OutputFlags & JL_OUTPUT_FLAGS_J5_ALLOW_HEX
-                &&  JlIsObjectNumberHex( NumberObject ) )
+            uint64_t numU64 = 0;
+            jlStatus = JlGetObjectNumberU64( NumberObject, &numU64 );
+            if( JL_STATUS_SUCCESS == jlStatus )
             {
-                // Format hex as 2 digits, 4 digits, 8 digits, or 16 digits depending on value
-                if     ( numU64 <= 0xff )       { sprintf( numString, "0x%2.2"PRIx64, numU64 ); }
-                else if( numU64 <= 0xffff )     { sprintf( numString, "0x%4.4"PRIx64, numU64 ); }
-                else if( numU64 <= 0xffffffff ) { sprintf( numString, "0x%8.8"PRIx64, numU64 ); }
-                else                            { sprintf( numString, "0x%16.16"PRIx64, numU64 ); }
+                if(     OutputFlags & JL_OUTPUT_FLAGS_J5_ALLOW_HEX
+                    &&  JlIsObjectNumberHex( NumberObject ) )
+                {
+                    // Format hex as 2 digits, 4 digits, 8 digits, or 16 digits depending on value
+                    if     ( numU64 <= 0xff )       { sprintf( numString, "0x%2.2"PRIx64, numU64 ); }
+                    else if( numU64 <= 0xffff )     { sprintf( numString, "0x%4.4"PRIx64, numU64 ); }
+                    else if( numU64 <= 0xffffffff ) { sprintf( numString, "0x%8.8"PRIx64, numU64 ); }
+                    else                            { sprintf( numString, "0x%16.16"PRIx64, numU64 ); }
+                }
+                else
+                {
+                    sprintf( numString, "%"PRIu64, numU64 );
+                }
             }
-            else
+        }
+        else if( JL_NUM_TYPE_SIGNED == numType )
+        {
+            int64_t numS64 = 0;
+            jlStatus = JlGetObjectNumberS64( NumberObject, &numS64 );
+            if( JL_STATUS_SUCCESS == jlStatus )
             {
-                sprintf( numString, "%"PRIu64, numU64 );
+                sprintf( numString, "%"PRId64, numS64 );
             }
         }
-    }
-    else if( JL_NUM_TYPE_SIGNED == numType )
-    {
-        int64_t numS64 = 0;
-        jlStatus = JlGetObjectNumberS64( NumberObject, &numS64 );
-        if( JL_STATUS_SUCCESS == jlStatus )
+        else if( JL_NUM_TYPE_FLOAT == numType )
         {
-            sprintf( numString, "%"PRId64, numS64 );
+            // Now try getting as a double
+            double numF64 = 0.0;
+            jlStatus = JlGetObjectNumberF64( NumberObject, &numF64 );
+            if( JL_STATUS_SUCCESS == jlStatus )
+            {
+                // Note: Output is printing using %.16g which gives the best compromise between precision and sensibly
+                // printing out most numbers. While %.17g would give full precision it will cause simple numbers such
+                // as 2.1 to print as 2.1000000000000001 due to the limitations of the floating point format.
+                sprintf( numString, "%.16g", numF64 );
+            }
         }
-    }
-    else if( JL_NUM_TYPE_FLOAT == numType )
-    {
-        // Now try getting as a double
-        double numF64 = 0.0;
-        jlStatus = JlGetObjectNumberF64( NumberObject, &numF64 );
-        if( JL_STATUS_SUCCESS == jlStatus )
+        else
         {
-            // Note: Output is printing using %.16g which gives the best compromise between precision and sensibly
-            // printing out most numbers. While %.17g would give full precision it will cause simple numbers such
-            // as 2.1 to print as 2.1000000000000001 due to the limitations of the floating point format.
-            sprintf( numString, "%.16g", numF64 );
+            jlStatus = JL_STATUS_WRONG_TYPE;
         }
-    }
-    else
-    {
-        jlStatus = JL_STATUS_WRONG_TYPE;
-    }
 
-    if( JL_STATUS_SUCCESS == jlStatus )
-    {
-        jlStatus = JlBufferAdd( JsonBuffer, numString, strlen(numString) );
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            jlStatus = JlBufferAdd( JsonBuffer, numString, strlen(numString) );
+        }
     }
 
     return jlStatus;
@@ -621,12 +676,14 @@ JL_STATUS
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  OutputDictionaryKey
 //
-//  Outputs the dictionary key name
+//  Outputs the dictionary key name. KeyNamePlain says which quotes the key name can be copied between as it is,
+//  otherwise it is escaped in the same way as a string value.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 JL_STATUS
     OutputDictionaryKey
     (
         char const*             KeyName,
+        JL_PLAIN_STRING         KeyNamePlain,
         JlBuffer*               JsonBuffer,
         JL_OUTPUT_FLAGS         OutputFlags
     )
@@ -634,6 +691,9 @@ JL_STATUS
     JL_STATUS jlStatus;
     bool noQuotes = false;
     char* quoteCharStr = "\"";
+    bool escapeSingleQuote = (OutputFlags & JL_OUTPUT_FLAGS_J5_SINGLE_QUOTES) ? true : false;
+    bool escapeNonAscii = (OutputFlags & JL_OUTPUT_FLAGS_ASCII) ? true : false;
+    JL_PLAIN_STRING plainForQuotes = escapeSingleQuote ? JL_PLAIN_STRING_SINGLE_QUOTED : JL_PLAIN_STRING_DOUBLE_QUOTED;
 
     if( OutputFlags & JL_OUTPUT_FLAGS_J5_USE_BARE_KEYWORDS )
     {
@@ -648,18 +708,33 @@ JL_STATUS
         quoteCharStr = "\'";
     }
 
+    jlStatus = JL_STATUS_SUCCESS;
     if( !noQuotes )
     {
         jlStatus = JlBufferAdd( JsonBuffer, quoteCharStr, 1 );
     }
 
-    jlStatus = JlBufferAdd( JsonBuffer, KeyName, strlen(KeyName) );
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        if( noQuotes || ( KeyNamePlain & plainForQuotes ) )
+        {
+            // Bare keywords and plain key names need no escaping
+            jlStatus = JlBufferAdd( JsonBuffer, KeyName, strlen(KeyName) );
+        }
+        else
+        {
+            jlStatus = OutputUtf8String( KeyName, escapeNonAscii, escapeSingleQuote, JsonBuffer );
+        }
+    }
 
-    if( !noQuotes )
+    if( JL_STATUS_SUCCESS == jlStatus && !noQuotes )
     {
         jlStatus = JlBufferAdd( JsonBuffer, quoteCharStr, 1 );
     }
-    jlStatus = JlBufferAdd( JsonBuffer, ": ", OutputFlags & JL_OUTPUT_FLAGS_INDENT ? 2 : 1 );
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        jlStatus = JlBufferAdd( JsonBuffer, ": ", OutputFlags & JL_OUTPUT_FLAGS_INDENT ? 2 : 1 );
+    }
 
     return jlStatus;
 }
@@ -716,7 +791,11 @@ JL_STATUS
             // Output Key name
             if( JL_STATUS_SUCCESS == jlStatus )
             {
-                jlStatus = OutputDictionaryKey( nextObjectKey, JsonBuffer, OutputFlags );
+                jlStatus = OutputDictionaryKey(
+                    nextObjectKey,
+                    JlGetDictionaryItemKeyPlain( currentItem->DictionaryEnumerator ),
+                    JsonBuffer,
+                    OutputFlags );
             }
         }
         else if( JL_STATUS_END_OF_DATA == jlStatus )
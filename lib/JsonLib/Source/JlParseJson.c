@@ -13,11 +13,35 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <float.h>
 #include "JlStatus.h"
 #include "JlMemory.h"
 #include "JlBuffer.h"
 #include "JlDataModel.h"
+#include "JlParser.h"
+#include "JlReader.h"
 #include "JlUnicode.h"
+#include "JlScan.h"
+#include "JlNumberString.h"
+#include "JlLazy.h"
+#include "JlParseSlice.h"
+#include "JlFileMap.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  DEFINES
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Values of ProjectionPath.TokenIndexes for tokens that are not list indexes
+#define PROJECTION_TOKEN_NOT_INDEX      SIZE_MAX
+#define PROJECTION_TOKEN_WILDCARD       ( SIZE_MAX - 1 )
+
+// Amount of a new chunk first added to the carry buffer to complete a token left over from the previous chunk. This
+// doubles each time until the token is complete.
+#define CARRY_STITCH_SIZE               64
+
+// Approximate memory used by each value in a tree, counted towards JlParseLimits.MaxBytes. This is the object itself
+// and the list or dictionary item that holds it.
+#define LIMIT_VALUE_SIZE                ( 10 * sizeof(void*) )
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  TYPES
@@ -32,6 +56,12 @@ typedef enum
     DICT_SCAN_STATE_NEED_COMMA_OR_END = 4,
 } DICT_SCAN_STATE;
 
+typedef struct
+{
+    char*           Buffer;
+    size_t          Size;
+} ScratchBuffer;
+
 typedef struct
 {
     JL_DATA_TYPE    Type;
@@ -41,10 +71,34 @@ typedef struct
     bool            ScanForSubObjects;
     bool            PrevScanComma;
     DICT_SCAN_STATE DictionaryScanState;
-    char*           CurrentKeyName;
-    size_t          CurrentKeyStringIndex;
+    char*           CurrentKeyName;         // Allocated when building a tree, else points into KeyNameBuffers
+    bool            KeyNameOwned;           // CurrentKeyName must be freed unless it is given to the dictionary
+    bool            KeyNameInSitu;          // CurrentKeyName points into the caller's buffer (in-situ parsing)
+    bool            IsKeyEmpty;             // Current key is an empty string
+    size_t          CurrentKeyStringIndex;  // Absolute position in the input
+    size_t          ListIndex;              // Index of the next value in this list (projection only)
+    size_t          NumItems;               // Number of values found in this list or dictionary so far
+    uint64_t        ProjectionMask;         // Projection paths that continue below this value
+    bool            ProjectionAll;          // Value is at or below the end of a projection path so is kept whole
 } ParseStack;
 
+// A JSON Pointer set with JlParserSetProjection, split into its reference tokens
+typedef struct
+{
+    char const* const* Tokens;              // Unescaped and zero terminated. This is the start of the allocation
+    size_t const*   TokenIndexes;           // Token as a list index, or PROJECTION_TOKEN_NOT_INDEX / _WILDCARD
+    size_t          NumTokens;
+} ProjectionPath;
+
+// When a string is split across chunks this records how far the search for the closing quote got, so that the next
+// attempt does not need to rescan the whole string.
+typedef struct
+{
+    size_t          TokenPos;               // Absolute position of the opening quote this applies to
+    size_t          ScanIndex;              // Index within the token to resume scanning from
+    size_t          ScanLength;             // Processed length of the string up to ScanIndex
+} StringScanState;
+
 typedef struct
 {
     ParseStack*     Stack;
@@ -53,9 +107,72 @@ typedef struct
     size_t          JsonStringLength;
     size_t          StringIndex;
     bool            IsJson5;
-
+    bool            IsFinal;                // False if more input may follow JsonString (JlParserFeed)
+    size_t          BaseOffset;             // Absolute position in the input of JsonString[0]
+    StringScanState StringScan;
+    ScratchBuffer*  KeyNameBuffers;         // One per stack level
+    ScratchBuffer   StringBuffer;           // Unescaped string values are written here before copying into object
+    ScratchBuffer   NumberBuffer;           // Number strings are copied here before conversion
+    JlParseCallbacks const* Callbacks;      // If set then events are sent to these instead of building a tree
+    void*           CallbackContext;
+    bool            Paused;                 // Set by a callback to stop the parse loop after the current step
+    bool            SkipNextValue;          // Move over the next value and pause (JlReaderSkipValue)
+    bool            ValidateOnly;           // Values are checked but not written out anywhere
+    char*           InSituBuffer;           // Writable JsonString when parsing in-situ, quoted strings are unescaped in place
+    bool            Lazy;                   // Lists and dictionaries below the root are recorded as spans, not parsed
+    bool            RawNumbers;             // Plain numbers keep their text (JL_PARSE_FLAGS_RAW_NUMBERS)
+    bool            RawStrings;             // Strings are kept as spans of JsonString (JL_PARSE_FLAGS_RAW_STRINGS)
+    ProjectionPath const* Projection;       // If set then only values on these paths are parsed
+    size_t          NumProjectionPaths;
+    uint64_t        ProjectionFound;        // Projection paths that have ended at a value so far
+    bool            StopWhenFound;          // Stop once a value has been found for every path (JlParserParseKeys)
+    bool            StoppedEarly;           // Parse was stopped with the rest of the input unread
+    bool            MultipleDocuments;      // More documents may follow this one (JlParserParseNextDocument)
+    bool            ListSliceAfterComma;    // Input starts after a comma in the root list (JlParserParseListSlice)
+    bool            ListSliceEndsAtComma;   // Input ends at a comma in the root list (JlParserParseListSlice)
+    size_t          StopAtIndex;            // Parse loop stops once StringIndex reaches this (JlParserParseWithBudget)
+    JlParseLimits   Limits;                 // Set with JlParserSetLimits, with SIZE_MAX for no limit
+    size_t          NumValues;              // Values found in the document so far, for Limits
+    size_t          NumBytes;               // Approximate memory allocated for the document so far, for Limits
 } ParseParameters;
 
+// Holds input given to JlParserFeed that has not been consumed yet because it contains an incomplete token.
+typedef struct
+{
+    char*           Buffer;
+    size_t          Size;
+    size_t          Used;
+} InputCarry;
+
+struct JlParser
+{
+    JL_PARSE_FLAGS  ParseFlags;
+    ParseParameters Params;
+    // Stack is 2 more than max depth because we don't use the first element and we need an extra one to contain the
+    // last list or dictionary nest levels items.
+    ParseStack      Stack[MAX_JSON_DEPTH+2];
+    ScratchBuffer   KeyNameBuffers[MAX_JSON_DEPTH+2];
+    // Incremental parsing state
+    InputCarry      Carry;
+    ProjectionPath  Projection[JL_MAX_PROJECTION_PATHS];
+    size_t          NumProjectionPaths;
+    bool            DocumentStarted;
+    bool            BudgetInProgress;       // Document is part way through JlParserParseWithBudget
+    JL_STATUS       FeedStatus;             // Sticky error from JlParserFeed
+    size_t          FeedErrorAtPos;
+};
+
+struct JlReader
+{
+    JlParser*       Parser;
+    JlToken         Token;                  // Set by the reader callbacks
+    JlToken         LastToken;              // Last token returned by JlReaderNext
+    bool            HavePendingToken;       // Token was read by JlReaderSkipValue but not used
+    bool            Finished;
+    JL_STATUS       Status;                 // Sticky error
+    size_t          ErrorAtPos;
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  MACROS
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -69,244 +186,213 @@ typedef struct
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//  ParseForNewType
+//  ReserveScratchBuffer
 //
-//  Parses the json string from current position until it reaches a new type.
+//  Makes sure the scratch buffer is at least RequiredSize bytes. The buffer is only reallocated when it needs to grow,
+//  so a parser that is reused will stop allocating once its buffers have reached the size of the largest values seen.
+//  Existing contents are not preserved when the buffer grows.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 static
 JL_STATUS
-    DetectNewType
+    ReserveScratchBuffer
     (
-        char const*     JsonString,
-        size_t          JsonStringLength,
-        size_t          StringIndex,
-        bool            IsJson5,
-        size_t*         pNewStringIndex,
-        JL_DATA_TYPE*   pNewType,
-        size_t*         pErrorAtPos
+        ScratchBuffer*      Scratch,
+        size_t              RequiredSize
     )
 {
     JL_STATUS jlStatus;
-    bool inSingleLineComment = false;
-    bool inMultiLineComment = false;
-
-    *pNewStringIndex = StringIndex;
-    *pNewType = JL_DATA_TYPE_NONE;
 
-    jlStatus = JL_STATUS_END_OF_DATA;
-    for( size_t i=StringIndex; i<JsonStringLength; i++ )
+    if( RequiredSize <= Scratch->Size )
     {
-        JL_DATA_TYPE newType = JL_DATA_TYPE_NONE;
-        char currentChar = JsonString[i];
-        char nextChar = JsonString[i+1];
-        char nextNextChar = 0 != nextChar ? JsonString[i+2] : 0;
-
-        // See if currently in a comment and if this is the end of comment.
-        if( inSingleLineComment && '\n' == currentChar )
-        {
-            inSingleLineComment = false;
-            continue;
-        }
-        else if( inMultiLineComment && '*' == currentChar && '/' == nextChar )
-        {
-            inMultiLineComment = false;
-            i += 1; // Skip the second character in end of comment marker
-            continue;
-        }
-        else if( inSingleLineComment || inMultiLineComment )
-        {
-            continue;
-        }
-
-        if(     ' '  == currentChar
-            ||  '\n' == currentChar
-            ||  '\r' == currentChar
-            ||  '\t' == currentChar
-            ||  ( '\f' == currentChar && IsJson5 )
-            ||  ( '\v' == currentChar && IsJson5 ) )
-        {
-            // Whitespace
-            continue;
-        }
-        else if( IsJson5 && '\xc2' == currentChar && '\xa0' == nextChar )
-        {
-            // Non-breaking space allowed by json5
-            i += 1;
-            continue;
-        }
-        else if(    IsJson5
-                 && (   ( '\xe2' == currentChar && '\x80' == nextChar && '\xa8' == nextNextChar )        // Line separator
-                     || ( '\xe2' == currentChar && '\x80' == nextChar && '\xa9' == nextNextChar )        // Paragraph separator
-                     || ( '\xef' == currentChar && '\xbb' == nextChar && '\xbf' == nextNextChar ) ) )    // Byte order mark
-        {
-            // Extra white space allowed by json5
-            i += 2;
-            continue;
-        }
-
-        if( '{' == currentChar )
-        {
-            newType = JL_DATA_TYPE_DICTIONARY;
-        }
-        else if( '[' == currentChar )
-        {
-            newType = JL_DATA_TYPE_LIST;
-        }
-        else if( '\"' == currentChar )
-        {
-            newType = JL_DATA_TYPE_STRING;
-        }
-        else if( IsJson5 && '\'' == currentChar )
-        {
-            newType = JL_DATA_TYPE_STRING;
-        }
-        else if(    'f' == currentChar
-                 || 't' == currentChar )
-        {
-            newType = JL_DATA_TYPE_BOOL;
-        }
-        else if(    ( currentChar >= '0' && currentChar <= '9' )
-                 || '-' == currentChar
-                 || ( '.' == currentChar && IsJson5 )
-                 || ( '+' == currentChar && IsJson5 )
-                 )
-        {
-            newType = JL_DATA_TYPE_NUMBER;
-        }
-        else if(    IsJson5
-                 && (
-                        ( ( 'i' == currentChar || 'I' == currentChar ) && ( 'n' == nextChar || 'N' == nextChar ) )
-                     || ( ( 'n' == currentChar || 'N' == currentChar ) && ( 'a' == nextChar || 'A' == nextChar ) ) ) )
-        {
-            // Allow for "inf" or "nan" for json5
-            newType = JL_DATA_TYPE_NUMBER;
-        }
-        else if( 'n' == currentChar )
-        {
-            // If NULL type then we will just treat as a string as we have NULL strings. tyle
-            newType = JL_DATA_TYPE_STRING;
-        }
-        else if( IsJson5 && '/' == currentChar && '/' == nextChar )
-        {
-            // Single line comment
-            i += 1; // Skip the second character in comment marker
-            inSingleLineComment = true;
-            continue;
-        }
-        else if( IsJson5 && '/' == currentChar && '*' == nextChar )
-        {
-            // Multi line comment
-            i += 1; // Skip the second character in comment marker
-            inMultiLineComment = true;
-            continue;
-        }
-        else
+        jlStatus = JL_STATUS_SUCCESS;
+    }
+    else
+    {
+        // Round up so that slowly growing values don't cause an allocation each time.
+        size_t newSize = ( RequiredSize + 63 ) & ~((size_t)63);
+        char* newBuffer = JlAlloc( newSize );
+        if( NULL != newBuffer )
         {
-            // Unexpected character at this time.
-            jlStatus = JL_STATUS_INVALID_DATA;
-            if( NULL != pErrorAtPos )
+            if( NULL != Scratch->Buffer )
             {
-                *pErrorAtPos = i;
+                JlFree( Scratch->Buffer );
             }
+            Scratch->Buffer = newBuffer;
+            Scratch->Size = newSize;
+            jlStatus = JL_STATUS_SUCCESS;
         }
-
-        if( JL_DATA_TYPE_NONE != newType )
+        else
         {
-            *pNewStringIndex = i;
-            *pNewType = newType;
-            jlStatus = JL_STATUS_SUCCESS;
+            jlStatus = JL_STATUS_OUT_OF_MEMORY;
         }
-
-        break;
     }
 
     return jlStatus;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//  ParseForNewType
+//  FreeScratchBuffer
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+void
+    FreeScratchBuffer
+    (
+        ScratchBuffer*      Scratch
+    )
+{
+    if( NULL != Scratch->Buffer )
+    {
+        JlFree( Scratch->Buffer );
+        Scratch->Buffer = NULL;
+    }
+    Scratch->Size = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ReleaseKeyName
 //
-//  Parses the json string from current position until it reaches a new type, and then adds the new type to the
-//  stack. Returns JL_STATUS_END_OF_DATA if the end of the string is reached.
+//  Clears the current key name of a stack item, freeing it if it was allocated.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 static
-JL_STATUS
-    ParseForNewType
+void
+    ReleaseKeyName
     (
-        ParseParameters*    Params,
-        bool                IsJson5,
-        size_t*             pErrorAtPos
+        ParseStack*         StackItem
     )
 {
-    JL_STATUS jlStatus;
-    JL_DATA_TYPE newType = JL_DATA_TYPE_NONE;
-    size_t newStringIndex;
+    if(     StackItem->KeyNameOwned
+        &&  NULL != StackItem->CurrentKeyName )
+    {
+        JlFree( StackItem->CurrentKeyName );
+    }
+    StackItem->CurrentKeyName = NULL;
+    StackItem->KeyNameOwned = false;
+    StackItem->KeyNameInSitu = false;
+}
 
-    jlStatus = DetectNewType(
-        Params->JsonString,
-        Params->JsonStringLength,
-        Params->StringIndex,
-        IsJson5,
-        &newStringIndex,
-        &newType,
-        pErrorAtPos );
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  FindClosingQuote
+//
+//  Returns the index of the quote that closes the string whose opening quote is at Json[Index], stepping over escaped
+//  characters. Returns JsonLength if the string is not terminated.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+size_t
+    FindClosingQuote
+    (
+        char const*     Json,
+        size_t          JsonLength,
+        size_t          Index
+    )
+{
+    char quoteChar = Json[Index];
+    size_t i;
 
-    if( JL_STATUS_SUCCESS == jlStatus  &&  JL_DATA_TYPE_NONE != newType )
+    for( i=Index+1; i<JsonLength; i++ )
     {
-        if( Params->StackIndex <= MAX_JSON_DEPTH )
+        i += JlScanStringRun( Json+i, JsonLength-i, quoteChar );
+        if( i >= JsonLength || quoteChar == Json[i] )
         {
-            Params->StringIndex = newStringIndex;
-            Params->StackIndex += 1;
-            ParseStack* stackItem = &Params->Stack[Params->StackIndex];
-            memset( stackItem, 0, sizeof(*stackItem) );
-
-            stackItem->Type = newType;
-            jlStatus = JlCreateObjectWithTag( newType, Params->StringIndex, &stackItem->Object );
+            break;
         }
-        else
+        else if( '\\' == Json[i] )
         {
-            // JSON nesting too deep.
-            jlStatus = JL_STATUS_JSON_NESTING_TOO_DEEP;
+            i += 1;
         }
     }
 
-    return jlStatus;
+    return i < JsonLength ? i : JsonLength;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//  VerifyOnlyTrailingWhiteSpace
+//  MatchProjection
 //
-//  Verify there is only white space left in this string
+//  Checks a new value of NewType, about to be added below the current stack level, against the projection paths. The
+//  root is always kept. Below that a value is kept if a path ends at it (and then everything below it is kept), or if
+//  it is a list or dictionary that a path continues through. *pProjectionMask is set to the paths that continue below
+//  the value and *pProjectionAll to whether it is kept whole. Paths that end at the value are added to
+//  Params->ProjectionFound. Returns false if the value is to be skipped.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 static
-JL_STATUS
-    VerifyOnlyTrailingWhiteSpace
+bool
+    MatchProjection
     (
-        char const*         String,
-        bool                IsJson5
+        ParseParameters*        Params,
+        JL_DATA_TYPE            NewType,
+        uint64_t*               pProjectionMask,
+        bool*                   pProjectionAll
     )
 {
-    JL_STATUS jlStatus;
-    size_t len = strlen( String );
-    size_t newIndex = 0;
-    JL_DATA_TYPE newType = JL_DATA_TYPE_NONE;
-    size_t errorAtPos = 0;
+    ParseStack const* parentItem = &Params->Stack[Params->StackIndex];
+    uint64_t projectionMask = 0;
+    bool projectionAll = false;
 
-    // We should not be able to detect a new type, this should just scan through white space and comments that
-    // may be trailing.
-    jlStatus = DetectNewType( String, len, 0, IsJson5, &newIndex, &newType, &errorAtPos );
-    if( JL_STATUS_SUCCESS == jlStatus )
+    if( 0 == Params->StackIndex )
     {
-        // This is an error as we should not have found a type
-        jlStatus = JL_STATUS_INVALID_DATA;
+        // Root value, where all the paths start
+        for( size_t i=0; i<Params->NumProjectionPaths; i++ )
+        {
+            if( 0 == Params->Projection[i].NumTokens )
+            {
+                projectionAll = true;
+            }
+            else
+            {
+                projectionMask |= (uint64_t)1 << i;
+            }
+        }
+    }
+    else if( parentItem->ProjectionAll )
+    {
+        projectionAll = true;
     }
     else
     {
-        // This is good, we should not have found anything
-        jlStatus = JL_STATUS_SUCCESS;
+        // The root's values are matched against the first token of each path
+        size_t tokenIndex = (size_t)Params->StackIndex - 1;
+        char const* keyName = NULL != parentItem->CurrentKeyName ? parentItem->CurrentKeyName : "";
+
+        for( size_t i=0; i<Params->NumProjectionPaths; i++ )
+        {
+            ProjectionPath const* path = &Params->Projection[i];
+            bool isMatch = false;
+
+            if( 0 == ( parentItem->ProjectionMask & ( (uint64_t)1 << i ) ) )
+            {
+                // Path does not reach this far
+            }
+            else if( PROJECTION_TOKEN_WILDCARD == path->TokenIndexes[tokenIndex] )
+            {
+                isMatch = true;
+            }
+            else if( JL_DATA_TYPE_LIST == parentItem->Type )
+            {
+                isMatch = ( parentItem->ListIndex == path->TokenIndexes[tokenIndex] );
+            }
+            else if( JL_DATA_TYPE_DICTIONARY == parentItem->Type )
+            {
+                isMatch = ( 0 == strcmp( keyName, path->Tokens[tokenIndex] ) );
+            }
+
+            if( isMatch && tokenIndex + 1 == path->NumTokens )
+            {
+                projectionAll = true;
+                Params->ProjectionFound |= (uint64_t)1 << i;
+            }
+            else if( isMatch )
+            {
+                projectionMask |= (uint64_t)1 << i;
+            }
+        }
     }
 
-    return jlStatus;
+    *pProjectionMask = projectionMask;
+    *pProjectionAll = projectionAll;
+
+    return      0 == Params->StackIndex
+            ||  projectionAll
+            ||  (   0 != projectionMask
+                &&  ( JL_DATA_TYPE_LIST == NewType || JL_DATA_TYPE_DICTIONARY == NewType ) );
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -342,6 +428,97 @@ JL_STATUS
     return jlStatus;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  HexStringToValue
+//
+//  Converts a string of exactly 4 hex digits into its value. The digits must already have been verified with
+//  VerifyHexString. This does not rely on the string being zero terminated.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+uint32_t
+    HexStringToValue
+    (
+        char const*     String
+    )
+{
+    uint32_t value = 0;
+
+    for( size_t i=0; i<4; i++ )
+    {
+        char hexChar = String[i];
+        uint32_t digit;
+
+        if( hexChar >= '0' && hexChar <= '9' )
+        {
+            digit = hexChar - '0';
+        }
+        else if( hexChar >= 'a' && hexChar <= 'f' )
+        {
+            digit = hexChar - 'a' + 10;
+        }
+        else
+        {
+            digit = hexChar - 'A' + 10;
+        }
+
+        value = ( value << 4 ) | digit;
+    }
+
+    return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  UnescapeSimpleChar
+//
+//  Returns the character for a single character escape sequence, where EscapeChar is the character after the
+//  backslash. Returns 0 if it is not a single character escape.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+char
+    UnescapeSimpleChar
+    (
+        char            EscapeChar
+    )
+{
+    char unescapedChar;
+
+    switch( EscapeChar )
+    {
+    case 'n':
+        unescapedChar = '\n';
+        break;
+    case 'r':
+        unescapedChar = '\r';
+        break;
+    case 'f':
+        unescapedChar = '\f';
+        break;
+    case 'b':
+        unescapedChar = '\b';
+        break;
+    case 't':
+        unescapedChar = '\t';
+        break;
+    case '\\':
+        unescapedChar = '\\';
+        break;
+    case '/':
+        unescapedChar = '/';
+        break;
+    case '\"':
+        unescapedChar = '\"';
+        break;
+    case '\'':
+        unescapedChar = '\'';
+        break;
+    default:
+        unescapedChar = 0;
+        break;
+    }
+
+    return unescapedChar;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  ConvertEscapedUnicode
 //
@@ -350,7 +527,8 @@ JL_STATUS
 //  part of pair.
 //  *pNumExtraCharsRead will be set to number of characters read from String. This will be either 4 or 10.
 //  *pProcessedStringPos will be incremented by the number of UTF-8 bytes that are added to ProcessedString. There is
-//  no size parameter as we know that ProcessedString will always be large enough.
+//  no size parameter as we know that ProcessedString will always be large enough. If ProcessedString is NULL then
+//  the escape is checked but not written out.
 //  PRocessedString was originally allocated same length as original String, and a Unicode escape will be either 6 or
 //  12 bytes in length which is more than any utf8 sequence.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -360,7 +538,7 @@ JL_STATUS
     (
         char const*         String,
         size_t              StringLength,
-        char*               ProcessedString,
+        char*               ProcessedString,        // OPTIONAL
         size_t*             pProcessedStringPos,
         size_t*             pNumExtraCharsRead
     )
@@ -373,8 +551,7 @@ JL_STATUS
         if( JL_STATUS_SUCCESS == jlStatus )
         {
             // Convert hex to number
-            uint32_t number = 0;
-            sscanf( String, "%4x", &number );
+            uint32_t number = HexStringToValue( String );
 
             if( number >= 0xD800 && number <= 0xDBFF )
             {
@@ -387,8 +564,7 @@ JL_STATUS
                         jlStatus = VerifyHexString( String+6, 4 );
                         if( JL_STATUS_SUCCESS == jlStatus )
                         {
-                            uint32_t lowSurrogate = 0;
-                            sscanf( String+6, "%4x", &lowSurrogate );
+                            uint32_t lowSurrogate = HexStringToValue( String+6 );
 
                             if( lowSurrogate >= 0xDC00 && number <=0xDFFF )
                             {
@@ -433,8 +609,10 @@ JL_STATUS
             if( JL_STATUS_SUCCESS == jlStatus )
             {
                 // number contains the unicode value, now encode it into utf8
+                char utf8Bytes [8];
                 size_t numUtf8Bytes = 0;
-                jlStatus = JlUnicodeValueToUtf8( number, ProcessedString+(*pProcessedStringPos), &numUtf8Bytes );
+                jlStatus = JlUnicodeValueToUtf8(
+                    number, NULL != ProcessedString ? ProcessedString+(*pProcessedStringPos) : utf8Bytes, &numUtf8Bytes );
                 if( JL_STATUS_SUCCESS == jlStatus )
                 {
                     *pProcessedStringPos += numUtf8Bytes;
@@ -451,37 +629,121 @@ JL_STATUS
     return jlStatus;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  IsStringInSitu
+//
+//  Returns true if String points into the caller's buffer being parsed in-situ, in which case it must not be freed and
+//  is given to the object tree as a reference.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+bool
+    IsStringInSitu
+    (
+        ParseParameters const*  Params,
+        char const*             String
+    )
+{
+    return NULL != Params->InSituBuffer
+        && String >= Params->InSituBuffer
+        && String < Params->InSituBuffer + Params->JsonStringLength;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  AddAllocatedBytes
+//
+//  Adds NumBytes to the approximate memory allocated for the document. Returns JL_STATUS_LIMIT_EXCEEDED if this goes
+//  over the limit set with JlParserSetLimits. This is called before the memory is allocated.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    AddAllocatedBytes
+    (
+        ParseParameters*    Params,
+        size_t              NumBytes
+    )
+{
+    Params->NumBytes += NumBytes;
+    return ( Params->NumBytes > Params->Limits.MaxBytes ) ? JL_STATUS_LIMIT_EXCEEDED : JL_STATUS_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  CountNewValue
+//
+//  Counts a new value that is about to be added to the list or dictionary at the top of the stack (or is the root).
+//  Returns JL_STATUS_LIMIT_EXCEEDED if this goes over a limit set with JlParserSetLimits.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    CountNewValue
+    (
+        ParseParameters*    Params
+    )
+{
+    JL_STATUS jlStatus = JL_STATUS_SUCCESS;
+    ParseStack* parentItem = &Params->Stack[Params->StackIndex];
+
+    Params->NumValues += 1;
+    parentItem->NumItems += 1;
+    if(     Params->NumValues > Params->Limits.MaxValues
+        ||  parentItem->NumItems > Params->Limits.MaxItems )
+    {
+        jlStatus = JL_STATUS_LIMIT_EXCEEDED;
+    }
+    else if( NULL == Params->Callbacks )
+    {
+        jlStatus = AddAllocatedBytes( Params, LIMIT_VALUE_SIZE );
+    }
+
+    return jlStatus;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  ParseString
 //
-//  Parses the String as a string type in json. Returns a JlDataObject containing the string. *pAmountProcessed will
-//  be set with the amount of the string consumed by the parse function (including end quote).
+//  Parses the json string at the current position in Params as a string type in json. The processed string is
+//  written into OutputBuffer and *pProcessedString is set to point to it, with its length in *pProcessedLength.
+//  If OutputBuffer is NULL then the processed string is instead allocated with JlAlloc to fit the string and the
+//  caller takes ownership of it. This lets the string be handed to the object tree without copying it again. When
+//  parsing in-situ a quoted string with no OutputBuffer is instead unescaped over itself in Params->InSituBuffer and
+//  zero terminated where its closing quote was, see IsStringInSitu.
+//  If pProcessedString is NULL then the string, including its escapes, is only checked and is not written anywhere.
+//  *pAmountProcessed will be set with the amount of the string consumed by the parse function (including end quote).
+//  Params->StringIndex is not changed.
 //  If IsBareWord then this is treated as a Json5 bare key name.
 //  If AllowNewLines is true then New line characters are allowed directly within the (non bareword) string (Json5)
+//  Returns JL_STATUS_NEED_MORE_DATA if more input may follow and the string was not terminated.
+//  Returns JL_STATUS_LIMIT_EXCEEDED if the string is longer than the limit set with JlParserSetLimits, or allocating
+//  it would go over the memory limit. A string with no escapes is checked before anything is allocated.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 static
 JL_STATUS
     ParseString
     (
-        char const*         String,
-        size_t              StringLength,
+        ParseParameters*    Params,
         bool                IsBareWord,
         bool                AllowNewLines,
+        ScratchBuffer*      OutputBuffer,       // OPTIONAL
         size_t*             pAmountProcessed,
-        char**              pProcessedString
+        char**              pProcessedString,   // OPTIONAL
+        size_t*             pProcessedLength
     )
 {
     JL_STATUS jlStatus;
+    char const* String = Params->JsonString + Params->StringIndex;
+    size_t StringLength = Params->JsonStringLength - Params->StringIndex;
     size_t strLength = 0;
     size_t strEndPos = 0;
     char* processedString = NULL;
     bool singleQuoted = '\'' == String[0] ? true : false;
+    bool reachedEnd = false;
+    bool hasEscapes = IsBareWord;
 
     // Find end of string
     jlStatus = JL_STATUS_INVALID_DATA;
     if( IsBareWord )
     {
         // Find length of bareword. Simply scan through until we find a non valid bareword char
+        reachedEnd = true;
         for( size_t i=0; i<StringLength; i++ )
         {
             strEndPos = i;
@@ -501,6 +763,7 @@ JL_STATUS
             else
             {
                 // End of bareword
+                reachedEnd = false;
                 break;
             }
             strLength += 1;
@@ -508,16 +771,51 @@ JL_STATUS
     }
     else
     {
-        // Quoted string. Find the length
-        for( size_t i=1; i<StringLength; i++ )      // Start at 1 to skip the first double quote
+        // Quoted string. Find the length. If a previous attempt on this string ran out of input then carry on from
+        // where it got to.
+        size_t startIndex = 1;      // Start at 1 to skip the first double quote
+        size_t tokenPos = Params->BaseOffset + Params->StringIndex;
+        if( tokenPos == Params->StringScan.TokenPos && Params->StringScan.ScanIndex > 0 )
+        {
+            startIndex = Params->StringScan.ScanIndex;
+            strLength = Params->StringScan.ScanLength;
+            hasEscapes = true;      // Not known for the part already scanned
+        }
+
+        reachedEnd = true;
+        size_t i;
+        for( i=startIndex; i<StringLength; i++ )
         {
+            // Move over the characters that need no processing in one go.
+            size_t runLength = JlScanStringRun( String + i, StringLength - i, singleQuoted ? '\'' : '\"' );
+            i += runLength;
+            strLength += runLength;
+            if( i >= StringLength )
+            {
+                break;
+            }
+
+            size_t unitIndex = i;
+            size_t unitLength = strLength;
+
             strEndPos = i;
             if( '\\' == String[i] )
             {
+                if(     !Params->IsFinal
+                    &&  (   i+1 >= StringLength
+                         || ( AllowNewLines && i+2 >= StringLength ) ) )
+                {
+                    // Escape sequence is split, resume from the backslash
+                    i = unitIndex;
+                    strLength = unitLength;
+                    break;
+                }
+
                 // Skip next character
+                hasEscapes = true;
                 i += 1;
                 strLength += 1;
-                if( AllowNewLines )
+                if( AllowNewLines && i+1 < StringLength )
                 {
                     // Check if we are escaping a crlf sequence
                     if( '\r' == String[i] && '\n' == String[i+1] )
@@ -531,25 +829,83 @@ JL_STATUS
                      || (  singleQuoted && '\'' == String[i] ) )
             {
                 jlStatus = JL_STATUS_SUCCESS;
+                reachedEnd = false;
                 break;
             }
-            else if( String[i] < 32 )
+            else if( (unsigned char)String[i] < 32 )
             {
                 // Control chars not allowed.
                 jlStatus = JL_STATUS_INVALID_DATA;
+                reachedEnd = false;
                 *pAmountProcessed = i;
                 break;
             }
             strLength += 1;
         }
+
+        if( reachedEnd && !Params->IsFinal )
+        {
+            Params->StringScan.TokenPos = tokenPos;
+            Params->StringScan.ScanIndex = i < StringLength ? i : StringLength;
+            Params->StringScan.ScanLength = strLength;
+        }
     }
 
-    if( JL_STATUS_SUCCESS == jlStatus )
+    if( reachedEnd && !Params->IsFinal )
     {
-        // Allocate space for processed string
-        size_t strPos = 0;
-        processedString = JlAlloc( strLength + 1 );
-        if( NULL != processedString )
+        jlStatus = JL_STATUS_NEED_MORE_DATA;
+    }
+
+    if(     JL_STATUS_SUCCESS == jlStatus
+        &&  !hasEscapes
+        &&  strLength > Params->Limits.MaxStringLength )
+    {
+        jlStatus = JL_STATUS_LIMIT_EXCEEDED;
+    }
+
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        // Make sure there is space for processed string. Unescaping never makes the string longer.
+        size_t strPos = 0;
+        if( NULL == pProcessedString )
+        {
+            // Only checking the string
+        }
+        else if( NULL != OutputBuffer )
+        {
+            jlStatus = ReserveScratchBuffer( OutputBuffer, strLength + 1 );
+            if( JL_STATUS_SUCCESS == jlStatus )
+            {
+                processedString = OutputBuffer->Buffer;
+            }
+        }
+        else if( NULL != Params->InSituBuffer && !IsBareWord )
+        {
+            // Each unescaped character is written no further on than the input it came from, so the string can be
+            // processed over itself. The terminator replaces the closing quote.
+            processedString = Params->InSituBuffer + Params->StringIndex + 1;
+        }
+        else
+        {
+            jlStatus = AddAllocatedBytes( Params, strLength + 1 );
+            if( JL_STATUS_SUCCESS == jlStatus )
+            {
+                processedString = JlAlloc( strLength + 1 );
+                jlStatus = ( NULL != processedString ) ? JL_STATUS_SUCCESS : JL_STATUS_OUT_OF_MEMORY;
+            }
+        }
+
+        if( JL_STATUS_SUCCESS == jlStatus && !hasEscapes )
+        {
+            // Nothing to unescape, so the string can be copied as it is
+            if(     NULL != processedString
+                &&  !IsStringInSitu( Params, processedString ) )
+            {
+                memcpy( processedString, String+1, strLength );
+            }
+            strPos = strLength;
+        }
+        else if( JL_STATUS_SUCCESS == jlStatus )
         {
             // Process string
             for( size_t i=IsBareWord?0:1; i<strEndPos; i++ )     // Skip first char which is double quote unless IsBareWord true
@@ -561,57 +917,21 @@ JL_STATUS
                     // Escaped chars. (There will definitely be at least one character after this
                     // due to the way we parsed in previous loop)
                     char nextChar = String[i+1];
-                    char nextNextChar = String[i+2];
-                    if( 'n' == nextChar )
-                    {
-                        processedString[strPos] = '\n';
-                        strPos += 1;
-                    }
-                    else if( 'r' == nextChar )
-                    {
-                        processedString[strPos] = '\r';
-                        strPos += 1;
-                    }
-                    else if( 'f' == nextChar )
-                    {
-                        processedString[strPos] = '\f';
-                        strPos += 1;
-                    }
-                    else if( 'b' == nextChar )
-                    {
-                        processedString[strPos] = '\b';
-                        strPos += 1;
-                    }
-                    else if( 't' == nextChar )
-                    {
-                        processedString[strPos] = '\t';
-                        strPos += 1;
-                    }
-                    else if( '\\' == nextChar )
-                    {
-                        processedString[strPos] = '\\';
-                        strPos += 1;
-                    }
-                    else if( '/' == nextChar )
-                    {
-                        processedString[strPos] = '/';
-                        strPos += 1;
-                    }
-                    else if( '\"' == nextChar )
-                    {
-                        processedString[strPos] = '\"';
-                        strPos += 1;
-                    }
-                    else if( '\'' == nextChar )
+                    char nextNextChar = i+2 < strEndPos ? String[i+2] : 0;
+                    char unescapedChar = UnescapeSimpleChar( nextChar );
+                    if( 0 != unescapedChar )
                     {
-                        processedString[strPos] = '\'';
+                        if( NULL != processedString )
+                        {
+                            processedString[strPos] = unescapedChar;
+                        }
                         strPos += 1;
                     }
                     else if( 'u' == nextChar )
                     {
                         size_t numExtraCharsRead = 0;
                         // attempt to convert the escaped unicode value.
-                        jlStatus = ConvertEscapedUnicode( String+i+2, strLength-i-1, processedString, &strPos, &numExtraCharsRead );
+                        jlStatus = ConvertEscapedUnicode( String+i+2, strEndPos-i-2, processedString, &strPos, &numExtraCharsRead );
                         if( JL_STATUS_SUCCESS == jlStatus )
                         {
                             // skip the processed chars (note this is after the \u, we will also skip the \u part later)
@@ -644,24 +964,42 @@ JL_STATUS
                 }
                 else
                 {
-                    processedString[strPos] = currentChar;
-                    strPos += 1;
+                    // Copy everything up to the next escape in one go
+                    char const* nextEscape = memchr( String+i, '\\', strEndPos-i );
+                    size_t runLength = ( NULL != nextEscape ) ? (size_t)( nextEscape - (String+i) ) : strEndPos-i;
+                    if( NULL != processedString )
+                    {
+                        // The source and destination overlap when parsing in-situ
+                        memmove( processedString+strPos, String+i, runLength );
+                    }
+                    strPos += runLength;
+                    i += runLength - 1;
                 }
             }
+        }
 
-            if( JL_STATUS_SUCCESS == jlStatus )
+        if(     JL_STATUS_SUCCESS == jlStatus
+            &&  strPos > Params->Limits.MaxStringLength )
+        {
+            jlStatus = JL_STATUS_LIMIT_EXCEEDED;
+        }
+
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            if( NULL != pProcessedString )
             {
+                processedString[strPos] = 0;
                 *pProcessedString = processedString;
-                *pAmountProcessed = strEndPos + (IsBareWord ? 0 : 1);     // If not bareword then also skip the ending quote
-            }
-            else
-            {
-                JlFree( processedString );
             }
+            *pProcessedLength = strPos;
+            *pAmountProcessed = strEndPos + (IsBareWord ? 0 : 1);     // If not bareword then also skip the ending quote
         }
-        else
+        else if(    NULL == OutputBuffer
+                 && NULL != processedString
+                 && !IsStringInSitu( Params, processedString ) )
         {
-            jlStatus = JL_STATUS_OUT_OF_MEMORY;
+            JlFree( processedString );
+            processedString = NULL;
         }
     }
 
@@ -669,346 +1007,87 @@ JL_STATUS
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//  ParseForString
+//  IsNumberInRange
 //
-//  Parses the Json string at current position as a string (after the first double quotes)
+//  Returns true if a number that has passed the checks in ParseOutNumberString can be seen to be in range of a double
+//  without converting it. This is the case if it is only digits and a decimal point with an optional leading sign, is
+//  shorter than the largest exponent of a double, and has a non zero digit. Anything else needs to be converted to
+//  find out.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 static
-JL_STATUS
-    ParseForString
+bool
+    IsNumberInRange
     (
-        ParseParameters*    Params,
-        size_t*             pErrorAtPos
+        char const*     NumberString,
+        size_t          NumberStringLength
     )
 {
-    JL_STATUS jlStatus;
-    char* processedString = NULL;
-    char const* stringStart = Params->JsonString + Params->StringIndex;
-    size_t maxStringLen = Params->JsonStringLength - Params->StringIndex;
-    size_t actualStringLen = 0;
-
-    // Check if this is a json null
-    jlStatus = JL_STATUS_NOT_FOUND;
-    if( maxStringLen >= 4 )
-    {
-        if( memcmp( stringStart, "null", 4 ) == 0 )
-        {
-            // We already have a string object created, so just leave it and it will be left as NULL.
-            Params->Stack[Params->StackIndex].FinishedProcessing = true;
-            Params->StringIndex += 4;
-            jlStatus = JL_STATUS_SUCCESS;
-        }
-    }
+    bool hasNonZeroDigit = false;
+    bool isSimple = NumberStringLength < DBL_MAX_10_EXP;
 
-    if( JL_STATUS_NOT_FOUND == jlStatus )
+    for( size_t i=0; i<NumberStringLength && isSimple; i++ )
     {
-        // Now treat as a normal string
-        jlStatus = ParseString( stringStart, maxStringLen, false, Params->IsJson5, &actualStringLen, &processedString );
-        if( JL_STATUS_SUCCESS == jlStatus )
+        char numberChar = NumberString[i];
+        if( numberChar >= '1' && numberChar <= '9' )
         {
-            Params->StringIndex += actualStringLen;
-
-            // Set string in object (was already setup as a string object)
-            Params->Stack[Params->StackIndex].FinishedProcessing = true;
-            jlStatus = JlSetObjectString( Params->Stack[Params->StackIndex].Object, processedString );
-
-            JlFree( processedString );
+            hasNonZeroDigit = true;
         }
-        else
+        else if(    '0' != numberChar
+                 && '.' != numberChar
+                 && !( 0 == i && ( '-' == numberChar || '+' == numberChar ) ) )
         {
-            if( actualStringLen > 0 )
-            {
-                // If an error occured in the middle of the string, this will be set to where the error happened.
-                if( NULL != pErrorAtPos )
-                {
-                    *pErrorAtPos = Params->StringIndex + actualStringLen;
-                }
-            }
+            // Exponent, hex, inf, nan, or a misplaced sign
+            isSimple = false;
         }
     }
 
-    if( JL_STATUS_SUCCESS != jlStatus )
-    {
-        (void) JlFreeObjectTree( &Params->Stack[Params->StackIndex].Object );
-    }
-
-    return jlStatus;
+    return isSimple && hasNonZeroDigit;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//  ParseOutNumberString
+//  IsRawNumberText
 //
-//  Parses the String as a number type in json. This will return a string containing just the number.
-//  *pAmountProcessed will be set with the amount of the string consumed by the parse function (including end quote).
+//  Returns true if a number that IsNumberInRange has accepted is also written as a plain Json1 number, that is an
+//  optional minus sign, digits without a leading zero, and an optional decimal point followed by more digits. Such a
+//  number can be kept as its text (JL_PARSE_FLAGS_RAW_NUMBERS) as converting it later can not fail.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 static
-JL_STATUS
-    ParseOutNumberString
+bool
+    IsRawNumberText
     (
-        char const*         String,
-        size_t              StringLength,
-        bool                AllowJson5,
-        size_t*             pAmountProcessed,
-        char**              pProcessedString
+        char const*     NumberString,
+        size_t          NumberStringLength
     )
 {
-    JL_STATUS jlStatus;
-    size_t strLength = 0;
-    size_t strEndPos = 0;
-    size_t numSkippedChars = 0;
-    char* processedString = NULL;
-    bool hexMode = false;
-    bool isSpecial = false;
-
-    jlStatus = JL_STATUS_SUCCESS;
-
-    if( AllowJson5 )
-    {
-        // Check if inf or nan
-        if( StringLength >= 4 )
-        {
-            if(     strncasecmp( String, "+inf", 4 ) == 0
-                ||  strncasecmp( String, "-inf", 4 ) == 0 )
-            {
-                strLength = 4;
-                isSpecial = true;
-            }
-        }
-        else if( StringLength >= 3 )
-        {
-            if(     strncasecmp( String, "inf", 3 ) == 0
-                ||  strncasecmp( String, "nan", 3 ) == 0 )
-            {
-                strLength = 3;
-                isSpecial = true;
-            }
-        }
-    }
-
-    // Find end of number
-    if( !isSpecial )
-    {
-        jlStatus = JL_STATUS_SUCCESS;
-        for( size_t i=0; i<StringLength; i++ )
-        {
-            if(     ( String[i] >= '0' && String[i] <= '9' )
-                ||  '-' == String[i]
-                ||  '.' == String[i]
-                ||  'E' == String[i]
-                ||  'e' == String[i]
-                ||  '+' == String[i] )
-            {
-                strEndPos = i;
-            }
-            else if(    ' ' == String[i]
-                     || '\r' == String[i]
-                     || '\n' == String[i]
-                     || '\t' == String[i]
-                     || ( '\v' == String[i] && AllowJson5 )
-                     || ( '\f' == String[i] && AllowJson5 )
-                     || ',' == String[i]
-                     || '}' == String[i]
-                     || ']' == String[i]
-                     || ( AllowJson5 && '\xc2' == String[i] && '\xa0' == String[i+1] )
-                     || ( AllowJson5 && '\xe2' == String[i] && '\x80' == String[i+1] && '\xa8' == String[i+2] )
-                     || ( AllowJson5 && '\xe2' == String[i] && '\x80' == String[i+1] && '\xa9' == String[i+2] )
-                     || ( AllowJson5 && '\xef' == String[i] && '\xbb' == String[i+1] && '\xbf' == String[i+2] ) )
-            {
-                // Valid character that can follow a number element.
-                break;
-            }
-            else if(    AllowJson5
-                     && '/' == String[i] )
-            {
-                // Start of comment
-                break;
-            }
-            else if(    AllowJson5
-                     && 1 == i
-                     && '0' == String[0]
-                     && ( 'x' == String[1] || 'X' == String[1] ) )
-            {
-                hexMode = true;
-                strEndPos = i;
-            }
-            else if(    hexMode
-                     && (   ( String[i] >= 'a' && String[i] <= 'f' )
-                         || ( String[i] >= 'A' && String[i] <= 'F' ) ) )
-            {
-                strEndPos = i;
-            }
-            else
-            {
-                // Invalid character
-                jlStatus = JL_STATUS_INVALID_DATA;
-                break;
-            }
-        }
-    }
-
-    if( hexMode && 1 == strEndPos )
-    {
-        // Its an invalid string to only be 0x with nothing following.
-        jlStatus = JL_STATUS_INVALID_DATA;
-    }
-    else if( hexMode && strEndPos > 17 )
-    {
-        // Its too long for a 64 bit hex number which is the largest that can be handled.
-        jlStatus = JL_STATUS_INVALID_DATA;
-    }
+    size_t index = ( NumberStringLength > 0 && '-' == NumberString[0] ) ? 1 : 0;
+    size_t numDigits = 0;
+    bool isRaw = NumberStringLength <= UINT16_MAX;
 
-    if( JL_STATUS_SUCCESS == jlStatus && !AllowJson5 )
+    while( index < NumberStringLength && NumberString[index] >= '0' && NumberString[index] <= '9' )
     {
-        // Don't allow trailing decimal point (unless Json5)
-        if( '.' == String[strEndPos] )
-        {
-            jlStatus = JL_STATUS_INVALID_DATA;
-        }
+        index += 1;
+        numDigits += 1;
     }
-
-    if( JL_STATUS_SUCCESS == jlStatus && !isSpecial )
+    if( 0 == numDigits || ( numDigits > 1 && '0' == NumberString[index-numDigits] ) )
     {
-        // Now verify that it is a valid number
-        bool minusAllowed = true;
-        bool plusAllowed = AllowJson5 ? true : false;      // Json5 allows a leading point
-        bool eAllowed = false;
-        bool pointAllowed = AllowJson5 ? true : false;      // Json5 allows a leading point
-
-        bool hadPoint = false;
-        bool hadE = false;
-
-        strLength = strEndPos + 1;
-        jlStatus = JL_STATUS_SUCCESS;
-
-        for( size_t i=0; i<strLength; i++ )
-        {
-            if( hexMode )
-            {
-                if(     i < 2
-                    ||  ( String[i] >= '0' && String[i] <= '9' )
-                    ||  ( String[i] >= 'a' && String[i] <= 'f' )
-                    ||  ( String[i] >= 'A' && String[i] <= 'F' ) )
-                {
-                    strEndPos = i;
-                }
-                else
-                {
-                    jlStatus = JL_STATUS_INVALID_DATA;
-                    break;
-                }
-            }
-            else if(    ( String[i] >= '0' && String[i] <= '9' )
-                    ||  ( '-' == String[i] && minusAllowed )
-                    ||  ( '.' == String[i] && pointAllowed )
-                    ||  ( 'E' == String[i] && eAllowed )
-                    ||  ( 'e' == String[i] && eAllowed )
-                    ||  ( '+' == String[i] && plusAllowed ) )
-            {
-                strEndPos = i;
-
-                if( !hadPoint && !hadE )
-                {
-                    pointAllowed = true;
-                }
-                if( !hadE )
-                {
-                    eAllowed = true;
-                }
-
-                if( 'e' == String[i] || 'E' == String[i] )
-                {
-                    minusAllowed = true;
-                    plusAllowed = true;
-                    pointAllowed = false;
-                    eAllowed = false;
-                    hadE = true;
-                }
-                else if( '.' == String[i] )
-                {
-                    hadPoint = true;
-                    pointAllowed = false;
-                    eAllowed = false;       // can't have E straight after decimal point
-                }
-                else
-                {
-                    minusAllowed = false;
-                    plusAllowed = false;
-                }
-            }
-            else
-            {
-                jlStatus = JL_STATUS_INVALID_DATA;
-                break;
-            }
-        }
+        isRaw = false;
     }
-
-    if( JL_STATUS_SUCCESS == jlStatus )
+    else if( index < NumberStringLength && '.' == NumberString[index] )
     {
-        char const* stringPtr = String;
-
-        if( AllowJson5 && '+' == stringPtr[0] )
-        {
-            // Skip leading '+' allowed by Json5
-            stringPtr += 1;
-            strLength -= 1;
-            numSkippedChars += 1;
-        }
-
-        // Copy out number string into newly allocated string buffer
-        processedString = JlAlloc( strLength + 1 );
-        if( NULL != processedString )
+        index += 1;
+        numDigits = 0;
+        while( index < NumberStringLength && NumberString[index] >= '0' && NumberString[index] <= '9' )
         {
-            memcpy( processedString, stringPtr, strLength );
-            *pProcessedString = processedString;
-            *pAmountProcessed = strLength + numSkippedChars;
-            jlStatus = JL_STATUS_SUCCESS;
+            index += 1;
+            numDigits += 1;
         }
-        else
+        if( 0 == numDigits )
         {
-            jlStatus = JL_STATUS_OUT_OF_MEMORY;
+            isRaw = false;
         }
     }
 
-    return jlStatus;
-}
-
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//  ParseForNumber
-//
-//  Parses the Json string at current position as a number
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-static
-JL_STATUS
-    ParseForNumber
-    (
-        ParseParameters*    Params
-    )
-{
-    JL_STATUS jlStatus;
-    char* processedString = NULL;
-    char const* stringStart = Params->JsonString + Params->StringIndex;
-    size_t maxStringLen = Params->JsonStringLength - Params->StringIndex;
-    size_t actualStringLen = 0;
-
-    jlStatus = ParseOutNumberString( stringStart, maxStringLen, Params->IsJson5, &actualStringLen, &processedString );
-    if( JL_STATUS_SUCCESS == jlStatus )
-    {
-        Params->StringIndex += actualStringLen;
-
-        // Set number in object (was already setup as a number object)
-        Params->Stack[Params->StackIndex].FinishedProcessing = true;
-        jlStatus = JlSetObjectNumberString( Params->Stack[Params->StackIndex].Object, processedString );
-
-        JlFree( processedString );
-    }
-
-    if( JL_STATUS_SUCCESS != jlStatus )
-    {
-        (void) JlFreeObjectTree( &Params->Stack[Params->StackIndex].Object );
-    }
-
-    return jlStatus;
+    return isRaw && index == NumberStringLength;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1028,10 +1107,16 @@ JL_STATUS
     size_t maxStringLen = Params->JsonStringLength - Params->StringIndex;
     size_t actualStringLen = 0;
     bool boolValue = false;
+    size_t offset = Params->BaseOffset + Params->StringIndex;
 
     // Check for "true"
-    if(     maxStringLen >= 4
-        &&  0 == memcmp( stringStart, "true", 4 ) )
+    if(     maxStringLen < 5
+        &&  !Params->IsFinal )
+    {
+        jlStatus = JL_STATUS_NEED_MORE_DATA;
+    }
+    else if(    maxStringLen >= 4
+            &&  0 == memcmp( stringStart, "true", 4 ) )
     {
         jlStatus = JL_STATUS_SUCCESS;
         actualStringLen = 4;
@@ -1052,13 +1137,24 @@ JL_STATUS
     if( JL_STATUS_SUCCESS == jlStatus )
     {
         Params->StringIndex += actualStringLen;
-
-        // Set bool in object (was already setup as a bool object)
         Params->Stack[Params->StackIndex].FinishedProcessing = true;
-        jlStatus = JlSetObjectBool( Params->Stack[Params->StackIndex].Object, boolValue );
+
+        if( NULL != Params->Callbacks )
+        {
+            if( NULL != Params->Callbacks->OnBool )
+            {
+                jlStatus = Params->Callbacks->OnBool( Params->CallbackContext, boolValue, offset );
+            }
+        }
+        else
+        {
+            // Set bool in object (was already setup as a bool object)
+            jlStatus = JlSetObjectBool( Params->Stack[Params->StackIndex].Object, boolValue );
+        }
     }
 
-    if( JL_STATUS_SUCCESS != jlStatus )
+    if(     JL_STATUS_SUCCESS != jlStatus
+        &&  JL_STATUS_NEED_MORE_DATA != jlStatus )
     {
         (void) JlFreeObjectTree( &Params->Stack[Params->StackIndex].Object );
     }
@@ -1067,555 +1163,2674 @@ JL_STATUS
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//  SkipWhiteSpace
+//  SendEndEvent
 //
-//  Fast forwards the StringIndex in Params until reaches the next none whitespace character. Returns character.
+//  Calls the end of list or dictionary callback (if set) for the closing bracket at the current position.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 static
 JL_STATUS
-    SkipWhiteSpace
+    SendEndEvent
     (
-        ParseParameters*    Params,
-        char*               pNextChar
+        ParseParameters*            Params,
+        JL_PARSE_EVENT_FUNCTION     EventFunction       // OPTIONAL
     )
 {
-    JL_STATUS jlStatus;
-    bool inSingleLineComment = false;
-    bool inMultiLineComment = false;
+    JL_STATUS jlStatus = JL_STATUS_SUCCESS;
 
-    jlStatus = JL_STATUS_END_OF_DATA;
-    while( Params->StringIndex < Params->JsonStringLength )
+    if( NULL != EventFunction )
     {
-        char currentChar = Params->JsonString[Params->StringIndex];
-        char nextChar = Params->JsonString[Params->StringIndex+1];
-        char nextNextChar = 0 != nextChar ? Params->JsonString[Params->StringIndex+2] : 0;
+        jlStatus = EventFunction( Params->CallbackContext, Params->BaseOffset + Params->StringIndex );
+    }
 
-        // See if currently in a comment and if this is the end of comment.
-        if( inSingleLineComment && '\n' == currentChar )
-        {
-            inSingleLineComment = false;
-        }
-        else if( inMultiLineComment && '*' == currentChar && '/' == nextChar )
-        {
-            inMultiLineComment = false;
-            Params->StringIndex  += 1;      // Skip the extra char (the '/')
-        }
-        else if( inSingleLineComment || inMultiLineComment )
-        {
-            // In comment, so ignore
-        }
-        else if(     ' '  == currentChar
-            ||  '\n' == currentChar
-            ||  '\r' == currentChar
-            ||  '\t' == currentChar
-            ||  ( '\v' == currentChar && Params->IsJson5 )
-            ||  ( '\f' == currentChar && Params->IsJson5 ) )
-        {
-            // White space, so ignore
-        }
-        else if( Params->IsJson5 && '\xc2' == currentChar && '\xa0' == nextChar )
-        {
-            // Non-breaking space allowed by json5
-            Params->StringIndex += 1;
-        }
-        else if(    Params->IsJson5
-                 && (   ( '\xe2' == currentChar && '\x80' == nextChar && '\xa8' == nextNextChar )        // Line separator
-                     || ( '\xe2' == currentChar && '\x80' == nextChar && '\xa9' == nextNextChar )        // Paragraph separator
-                     || ( '\xef' == currentChar && '\xbb' == nextChar && '\xbf' == nextNextChar ) ) )    // Byte order mark
-        {
-            // Extra white space allowed by json5
-            Params->StringIndex += 2;
-        }
-        else if( Params->IsJson5 && '/' == currentChar && '/' == nextChar )
-        {
-            inSingleLineComment = true;
-            Params->StringIndex += 1;
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ParseKeyName
+//
+//  Parses the KeyName from the json string. When building a tree the key name is allocated at its final size and is
+//  given to the dictionary when the value is attached. Otherwise it is written into the key name scratch buffer for
+//  the current stack level where it stays until the value has been parsed. When parsing in-situ quoted key names are
+//  left in the caller's buffer instead. Json5 bare key names are still allocated as they have no closing quote to
+//  place the terminator on. When parsing with a projection the scratch buffer is used as well, and the key name is
+//  only copied if the value is attached, so nothing is allocated for the keys of values that are skipped.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    ParseKeyName
+    (
+        ParseParameters*    Params,
+        bool                IsBareWord
+    )
+{
+    JL_STATUS jlStatus;
+    size_t amountProcessed = 0;
+    size_t processedLength = 0;
+    ParseStack* currentStack = &Params->Stack[Params->StackIndex];
+    ScratchBuffer* keyNameBuffer = NULL;
+
+    if(     !Params->ValidateOnly
+        &&  (   NULL != Params->Callbacks
+            ||  ( NULL != Params->Projection && NULL == Params->InSituBuffer ) ) )
+    {
+        // When validating the key name is not kept, and there are no key name buffers.
+        keyNameBuffer = &Params->KeyNameBuffers[Params->StackIndex];
+    }
+
+    ReleaseKeyName( currentStack );
+    jlStatus = ParseString(
+        Params,
+        IsBareWord,
+        false,
+        keyNameBuffer,
+        &amountProcessed,
+        Params->ValidateOnly ? NULL : &currentStack->CurrentKeyName,
+        &processedLength );
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        currentStack->IsKeyEmpty = ( 0 == processedLength );
+        currentStack->KeyNameInSitu = IsStringInSitu( Params, currentStack->CurrentKeyName );
+        currentStack->KeyNameOwned = ( NULL == keyNameBuffer && !currentStack->KeyNameInSitu );
+        currentStack->CurrentKeyStringIndex = Params->BaseOffset + Params->StringIndex;
+        Params->StringIndex += amountProcessed;
+
+        if(     NULL != Params->Callbacks
+            &&  NULL != Params->Callbacks->OnKey )
+        {
+            jlStatus = Params->Callbacks->OnKey(
+                Params->CallbackContext, currentStack->CurrentKeyName, processedLength, currentStack->CurrentKeyStringIndex );
+        }
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  AttachStackObjectToPreviousObject
+//
+//  Attaches the latest object in the stack to the previous object if the previous one is a list or dictionary.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    AttachStackObjectToPreviousObject
+    (
+        ParseStack*     Stack,
+        int32_t         StackIndex,
+        size_t*         pErrorAtPos
+    )
+{
+    JL_STATUS jlStatus;
+
+    if( StackIndex > 0 )
+    {
+        ParseStack* currentStackItem = &Stack[StackIndex];
+        ParseStack* prevStackItem = &Stack[StackIndex-1];
+
+        if( JL_DATA_TYPE_LIST == prevStackItem->Type )
+        {
+            jlStatus = JlAttachObjectToListObject( prevStackItem->Object, currentStackItem->Object );
+            if( JL_STATUS_SUCCESS == jlStatus )
+            {
+                // Now owned by the list
+                currentStackItem->Object = NULL;
+            }
+        }
+        else if( JL_DATA_TYPE_DICTIONARY == prevStackItem->Type )
+        {
+            if( prevStackItem->KeyNameOwned )
+            {
+                jlStatus = JlAttachObjectToDictionaryObjectTakeKey(
+                    prevStackItem->Object, prevStackItem->CurrentKeyName, currentStackItem->Object );
+            }
+            else if( prevStackItem->KeyNameInSitu )
+            {
+                jlStatus = JlAttachObjectToDictionaryObjectReferenceKey(
+                    prevStackItem->Object, prevStackItem->CurrentKeyName, currentStackItem->Object );
+            }
+            else
+            {
+                jlStatus = JlAttachObjectToDictionaryObject(
+                    prevStackItem->Object, prevStackItem->CurrentKeyName, currentStackItem->Object );
+            }
+            if( JL_STATUS_SUCCESS == jlStatus )
+            {
+                // Object and key are now owned by the dictionary
+                currentStackItem->Object = NULL;
+                prevStackItem->CurrentKeyName = NULL;
+                prevStackItem->KeyNameOwned = false;
+                prevStackItem->KeyNameInSitu = false;
+            }
+            else
+            {
+                if( NULL != pErrorAtPos )
+                {
+                    *pErrorAtPos = prevStackItem->CurrentKeyStringIndex;
+                }
+                ReleaseKeyName( prevStackItem );
+            }
+        }
+        else
+        {
+            // nothing to attach it to. This occurs when the root object in the json is not a dictionary or list
+            jlStatus = JL_STATUS_SUCCESS;
+        }
+    }
+    else
+    {
+        // nothing to attach it to. This occurs when the root object in the json is not a dictionary or list
+        jlStatus = JL_STATUS_SUCCESS;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  FreePartialTree
+//
+//  Frees any objects left on the parse stack. This is used when a parse fails or is abandoned part way through.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+void
+    FreePartialTree
+    (
+        ParseParameters*    Params
+    )
+{
+    for( int32_t i=1; i<MAX_JSON_DEPTH+2; i++ )
+    {
+        if( NULL != Params->Stack[i].Object )
+        {
+            (void) JlFreeObjectTree( &Params->Stack[i].Object );
+        }
+        ReleaseKeyName( &Params->Stack[i] );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  StartParseStack
+//
+//  Sets up the parse stack in Params ready to parse a new document.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+void
+    StartParseStack
+    (
+        ParseParameters*    Params
+    )
+{
+    // Setup first item in stack as the "none" type (for whitespace). When this is popped off we
+    // will have finished.
+    memset( &Params->Stack[0], 0, sizeof(Params->Stack[0]) );
+    Params->StackIndex = 0;
+    Params->Stack[0].Type = JL_DATA_TYPE_NONE;
+    Params->Stack[0].ScanForSubObjects = true;
+    memset( &Params->StringScan, 0, sizeof(Params->StringScan) );
+    Params->ProjectionFound = 0;
+    Params->StoppedEarly = false;
+    Params->NumValues = 0;
+    Params->NumBytes = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  StartDocument
+//
+//  Sets up the parser ready to parse a new document.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+void
+    StartDocument
+    (
+        JlParser*       Parser
+    )
+{
+    if( Parser->BudgetInProgress )
+    {
+        // An unfinished document from JlParserParseWithBudget is being discarded
+        FreePartialTree( &Parser->Params );
+        Parser->BudgetInProgress = false;
+    }
+
+    StartParseStack( &Parser->Params );
+
+    Parser->DocumentStarted = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PARSE LOOPS
+//
+//  The parse loop in JlParseJsonLoop.h is built twice, giving RunParserJson1 for strict JSON and RunParserJson5 for
+//  Json5 (along with the functions it uses, such as SkipWhiteSpaceJson1 and SkipWhiteSpaceJson5). This keeps all the
+//  Json5 checks out of the strict JSON parse.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define PARSE_JSON5                 false
+#define PARSE_FUNCTION( Name )      Name##Json1
+#include "JlParseJsonLoop.h"
+#undef PARSE_JSON5
+#undef PARSE_FUNCTION
+
+#define PARSE_JSON5                 true
+#define PARSE_FUNCTION( Name )      Name##Json5
+#include "JlParseJsonLoop.h"
+#undef PARSE_JSON5
+#undef PARSE_FUNCTION
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  RunParser
+//
+//  Runs the parse loop over Params using the strict JSON or Json5 version of it (see JlParseJsonLoop.h).
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    RunParser
+    (
+        ParseParameters*    Params,
+        size_t*             pErrorAtPos
+    )
+{
+    JL_STATUS jlStatus;
+
+    if( Params->IsJson5 )
+    {
+        jlStatus = RunParserJson5( Params, pErrorAtPos );
+    }
+    else
+    {
+        jlStatus = RunParserJson1( Params, pErrorAtPos );
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  VerifyOnlyTrailingWhiteSpace
+//
+//  Verify there is only white space left in this string
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    VerifyOnlyTrailingWhiteSpace
+    (
+        char const*         String,
+        size_t              StringLength,
+        bool                IsJson5
+    )
+{
+    JL_STATUS jlStatus;
+    size_t newIndex = 0;
+    JL_DATA_TYPE newType = JL_DATA_TYPE_NONE;
+    size_t errorAtPos = 0;
+
+    // We should not be able to detect a new type, this should just scan through white space and comments that
+    // may be trailing.
+    if( IsJson5 )
+    {
+        jlStatus = DetectNewTypeJson5( String, StringLength, 0, true, &newIndex, &newType, &errorAtPos );
+    }
+    else
+    {
+        jlStatus = DetectNewTypeJson1( String, StringLength, 0, true, &newIndex, &newType, &errorAtPos );
+    }
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        // This is an error as we should not have found a type
+        jlStatus = JL_STATUS_INVALID_DATA;
+    }
+    else
+    {
+        // This is good, we should not have found anything
+        jlStatus = JL_STATUS_SUCCESS;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  CompleteDocument
+//
+//  Called once the parse loop has finished the root object and all the input has been provided. Verifies there is
+//  nothing but white space left and then takes the root object from the stack. pRootObject is NULL when parsing
+//  with callbacks as there is no tree. If the parse was stopped early, or more documents may follow, the rest of the
+//  input is not checked.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    CompleteDocument
+    (
+        ParseParameters*    Params,
+        JlDataObject**      pRootObject,        // OPTIONAL
+        size_t*             pErrorAtPos
+    )
+{
+    JL_STATUS jlStatus;
+
+    if( Params->StoppedEarly || Params->MultipleDocuments )
+    {
+        jlStatus = JL_STATUS_SUCCESS;
+    }
+    else
+    {
+        // Verify that there is nothing but white space after the final object.
+        jlStatus = VerifyOnlyTrailingWhiteSpace(
+            Params->JsonString + Params->StringIndex,
+            Params->JsonStringLength - Params->StringIndex,
+            Params->IsJson5 );
+    }
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        if( NULL != pRootObject )
+        {
+            // Get root object (in index position 1)
+            *pRootObject = Params->Stack[1].Object;
+            Params->Stack[1].Object = NULL;
+        }
+    }
+    else
+    {
+        FreePartialTree( Params );
+
+        if( NULL != pErrorAtPos )
+        {
+            *pErrorAtPos = Params->BaseOffset + Params->StringIndex;
+        }
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  StartListSlice
+//
+//  Called after StartDocument when the input starts after a comma between elements of the root list. Sets up the
+//  stack as though the root list had been opened and its elements up to the comma parsed, with a new empty list
+//  object to receive the elements of this slice.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    StartListSlice
+    (
+        JlParser*       Parser
+    )
+{
+    ParseParameters* params = &Parser->Params;
+    ParseStack* stackItem = &params->Stack[1];
+
+    params->Stack[0].FinishedProcessing = true;
+    params->Stack[0].ScanForSubObjects = false;
+
+    params->StackIndex = 1;
+    memset( stackItem, 0, sizeof(*stackItem) );
+    stackItem->Type = JL_DATA_TYPE_LIST;
+    stackItem->ProcessedFirstItem = true;
+    stackItem->PrevScanComma = true;
+
+    return JlCreateObjectWithTag( JL_DATA_TYPE_LIST, params->BaseOffset + params->StringIndex, &stackItem->Object );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  EndDocument
+//
+//  Clears the settings for the document that has just been parsed from a buffer, ready for the next one.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+void
+    EndDocument
+    (
+        JlParser*       Parser
+    )
+{
+    ParseParameters* params = &Parser->Params;
+
+    params->JsonString = NULL;
+    params->JsonStringLength = 0;
+    params->StringIndex = 0;
+    params->Lazy = false;
+    params->RawNumbers = false;
+    params->RawStrings = false;
+    params->Projection = NULL;
+    params->NumProjectionPaths = 0;
+    params->StopWhenFound = false;
+    params->MultipleDocuments = false;
+    params->ListSliceAfterComma = false;
+    params->ListSliceEndsAtComma = false;
+    Parser->DocumentStarted = false;
+    Parser->BudgetInProgress = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ParseDocument
+//
+//  Parses the JSON set in Parser->Params and returns the root object. Parser->Params must have been set up with the
+//  JSON string. The stack and scratch buffers belong to the parser and are left for the next parse. On success
+//  *pAmountConsumed is set to the length of the input that was read, which is all of it unless the parse was stopped
+//  early or more documents may follow.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    ParseDocument
+    (
+        JlParser*       Parser,
+        JlDataObject**  pRootObject,
+        size_t*         pAmountConsumed,    // OPTIONAL
+        size_t*         pErrorAtPos
+    )
+{
+    JL_STATUS jlStatus;
+    ParseParameters* params = &Parser->Params;
+
+    StartDocument( Parser );
+
+    jlStatus = params->ListSliceAfterComma ? StartListSlice( Parser ) : JL_STATUS_SUCCESS;
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        jlStatus = RunParser( params, pErrorAtPos );
+    }
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        jlStatus = CompleteDocument( params, pRootObject, pErrorAtPos );
+    }
+    if(     JL_STATUS_SUCCESS == jlStatus
+        &&  NULL != pAmountConsumed )
+    {
+        *pAmountConsumed =
+            ( params->StoppedEarly || params->MultipleDocuments ) ? params->StringIndex : params->JsonStringLength;
+    }
+
+    EndDocument( Parser );
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  KeepUnconsumedInput
+//
+//  After a JlParserFeed call keeps the input from Params->StringIndex onwards in the carry buffer so it is available
+//  to the next call. The input being parsed may be the carry buffer itself, or the chunk passed in.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    KeepUnconsumedInput
+    (
+        JlParser*       Parser
+    )
+{
+    JL_STATUS jlStatus = JL_STATUS_SUCCESS;
+    ParseParameters* params = &Parser->Params;
+    InputCarry* carry = &Parser->Carry;
+    size_t remaining = params->JsonStringLength - params->StringIndex;
+
+    if( params->JsonString == carry->Buffer )
+    {
+        if( remaining > 0 && params->StringIndex > 0 )
+        {
+            memmove( carry->Buffer, carry->Buffer + params->StringIndex, remaining );
+        }
+    }
+    else if( remaining > 0 )
+    {
+        if( remaining > carry->Size )
+        {
+            size_t newSize = ( remaining + 1023 ) & ~((size_t)1023);
+            char* newBuffer = JlAlloc( newSize );
+            if( NULL != newBuffer )
+            {
+                if( NULL != carry->Buffer )
+                {
+                    JlFree( carry->Buffer );
+                }
+                carry->Buffer = newBuffer;
+                carry->Size = newSize;
+            }
+            else
+            {
+                jlStatus = JL_STATUS_OUT_OF_MEMORY;
+            }
+        }
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            memcpy( carry->Buffer, params->JsonString + params->StringIndex, remaining );
+        }
+    }
+
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        carry->Used = remaining;
+        params->BaseOffset += params->StringIndex;
+    }
+
+    params->JsonString = NULL;
+    params->JsonStringLength = 0;
+    params->StringIndex = 0;
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  AppendToCarry
+//
+//  Adds a chunk to the end of the carry buffer, growing it as required. The buffer doubles in size so that a token
+//  split over many small chunks does not cause an allocation per chunk.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    AppendToCarry
+    (
+        InputCarry*     Carry,
+        char const*     Chunk,
+        size_t          ChunkLength
+    )
+{
+    JL_STATUS jlStatus = JL_STATUS_SUCCESS;
+
+    if( Carry->Used + ChunkLength > Carry->Size )
+    {
+        size_t newSize = Carry->Size > 0 ? Carry->Size : 1024;
+        while( newSize < Carry->Used + ChunkLength )
+        {
+            newSize *= 2;
+        }
+
+        char* newBuffer = JlRealloc( Carry->Buffer, Carry->Used, newSize );
+        if( NULL != newBuffer )
+        {
+            Carry->Buffer = newBuffer;
+            Carry->Size = newSize;
+        }
+        else
+        {
+            jlStatus = JL_STATUS_OUT_OF_MEMORY;
+        }
+    }
+
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        memcpy( Carry->Buffer + Carry->Used, Chunk, ChunkLength );
+        Carry->Used += ChunkLength;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  CompleteCarriedToken
+//
+//  Called by JlParserFeed when an incomplete token was left in the carry buffer by the previous chunk. The start of
+//  Chunk is added to the carry buffer a piece at a time and parsed until the token is complete, so that only the part
+//  of the chunk needed to finish it is copied. Params is then moved on to the same place within Chunk and
+//  JL_STATUS_SUCCESS is returned, leaving the rest of the chunk to be parsed from where it is. If all of Chunk is
+//  used without completing the token then JL_STATUS_NEED_MORE_DATA is returned with Params still on the carry buffer.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    CompleteCarriedToken
+    (
+        JlParser*       Parser,
+        char const*     Chunk,
+        size_t          ChunkLength
+    )
+{
+    JL_STATUS jlStatus = JL_STATUS_NEED_MORE_DATA;
+    ParseParameters* params = &Parser->Params;
+    InputCarry* carry = &Parser->Carry;
+    size_t carriedLength = carry->Used;
+    size_t amountAdded = 0;
+    size_t stitchSize = CARRY_STITCH_SIZE;
+
+    params->JsonString = carry->Buffer;
+    params->JsonStringLength = carry->Used;
+    params->StringIndex = 0;
+    while(      JL_STATUS_NEED_MORE_DATA == jlStatus
+            &&  params->StringIndex < carriedLength
+            &&  amountAdded < ChunkLength )
+    {
+        size_t amount = ( ChunkLength - amountAdded < stitchSize ) ? ChunkLength - amountAdded : stitchSize;
+        jlStatus = AppendToCarry( carry, Chunk + amountAdded, amount );
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            amountAdded += amount;
+            stitchSize *= 2;
+            params->JsonString = carry->Buffer;
+            params->JsonStringLength = carry->Used;
+            jlStatus = RunParser( &Parser->Params, &Parser->FeedErrorAtPos );
+        }
+    }
+
+    if(     ( JL_STATUS_SUCCESS == jlStatus || JL_STATUS_NEED_MORE_DATA == jlStatus )
+        &&  params->StringIndex >= carriedLength )
+    {
+        // The carried token is complete and everything after it is also in Chunk, so carry on from there
+        params->BaseOffset += carriedLength;
+        params->StringIndex -= carriedLength;
+        params->JsonString = Chunk;
+        params->JsonStringLength = ChunkLength;
+        carry->Used = 0;
+        jlStatus = JL_STATUS_SUCCESS;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  SetReaderToken
+//
+//  Called from the reader callbacks. Records the token and pauses the parse loop so that JlReaderNext can return it.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    SetReaderToken
+    (
+        JlReader*       Reader,
+        JL_TOKEN_TYPE   Type,
+        char const*     Text,           // OPTIONAL
+        size_t          TextLength,
+        bool            BoolValue,
+        size_t          Offset
+    )
+{
+    ParseParameters* params = &Reader->Parser->Params;
+
+    Reader->Token.Type = Type;
+    Reader->Token.Text = Text;
+    Reader->Token.TextLength = TextLength;
+    Reader->Token.BoolValue = BoolValue;
+    Reader->Token.Offset = Offset;
+    // Events are sent with the stack index of the item (or for keys, the dictionary they are in). Index 1 is the root.
+    Reader->Token.Depth = (uint32_t)( params->StackIndex - 1 + ( JL_TOKEN_TYPE_KEY == Type ? 1 : 0 ) );
+
+    params->Paused = true;
+
+    return JL_STATUS_SUCCESS;
+}
+
+static
+JL_STATUS
+    ReaderOnBeginDictionary
+    (
+        void*           Context,
+        size_t          Offset
+    )
+{
+    return SetReaderToken( Context, JL_TOKEN_TYPE_BEGIN_DICTIONARY, NULL, 0, false, Offset );
+}
+
+static
+JL_STATUS
+    ReaderOnEndDictionary
+    (
+        void*           Context,
+        size_t          Offset
+    )
+{
+    return SetReaderToken( Context, JL_TOKEN_TYPE_END_DICTIONARY, NULL, 0, false, Offset );
+}
+
+static
+JL_STATUS
+    ReaderOnBeginList
+    (
+        void*           Context,
+        size_t          Offset
+    )
+{
+    return SetReaderToken( Context, JL_TOKEN_TYPE_BEGIN_LIST, NULL, 0, false, Offset );
+}
+
+static
+JL_STATUS
+    ReaderOnEndList
+    (
+        void*           Context,
+        size_t          Offset
+    )
+{
+    return SetReaderToken( Context, JL_TOKEN_TYPE_END_LIST, NULL, 0, false, Offset );
+}
+
+static
+JL_STATUS
+    ReaderOnKey
+    (
+        void*           Context,
+        char const*     Text,
+        size_t          TextLength,
+        size_t          Offset
+    )
+{
+    return SetReaderToken( Context, JL_TOKEN_TYPE_KEY, Text, TextLength, false, Offset );
+}
+
+static
+JL_STATUS
+    ReaderOnString
+    (
+        void*           Context,
+        char const*     Text,
+        size_t          TextLength,
+        size_t          Offset
+    )
+{
+    return SetReaderToken( Context, JL_TOKEN_TYPE_STRING, Text, TextLength, false, Offset );
+}
+
+static
+JL_STATUS
+    ReaderOnNumber
+    (
+        void*           Context,
+        char const*     Text,
+        size_t          TextLength,
+        size_t          Offset
+    )
+{
+    return SetReaderToken( Context, JL_TOKEN_TYPE_NUMBER, Text, TextLength, false, Offset );
+}
+
+static
+JL_STATUS
+    ReaderOnBool
+    (
+        void*           Context,
+        bool            Value,
+        size_t          Offset
+    )
+{
+    return SetReaderToken( Context, JL_TOKEN_TYPE_BOOL, NULL, 0, Value, Offset );
+}
+
+static
+JL_STATUS
+    ReaderOnNull
+    (
+        void*           Context,
+        size_t          Offset
+    )
+{
+    return SetReaderToken( Context, JL_TOKEN_TYPE_NULL, NULL, 0, false, Offset );
+}
+
+static JlParseCallbacks const gReaderCallbacks =
+{
+    ReaderOnBeginDictionary,
+    ReaderOnEndDictionary,
+    ReaderOnBeginList,
+    ReaderOnEndList,
+    ReaderOnKey,
+    ReaderOnString,
+    ReaderOnNumber,
+    ReaderOnBool,
+    ReaderOnNull,
+};
+
+// Validation parses with no callbacks set, so nothing is built and no events are sent
+static JlParseCallbacks const gValidateCallbacks = { NULL };
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  SkipRestOfContainer
+//
+//  Moves the reader over the rest of the list or dictionary whose begin token was the last one returned, up to and
+//  including its closing bracket. The brackets are matched with SkipContainer so nothing within it is parsed. The
+//  list or dictionary is then taken off the stack as though its end token had been read.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    SkipRestOfContainer
+    (
+        JlReader*       Reader
+    )
+{
+    JL_STATUS jlStatus;
+    ParseParameters* params = &Reader->Parser->Params;
+    size_t spanLength = 0;
+
+    // Go back to the opening bracket for SkipContainer to match
+    params->StringIndex = Reader->LastToken.Offset - params->BaseOffset;
+    if( params->IsJson5 )
+    {
+        jlStatus = SkipContainerJson5( params, params->StackIndex, &spanLength );
+    }
+    else
+    {
+        jlStatus = SkipContainerJson1( params, params->StackIndex, &spanLength );
+    }
+
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        params->StringIndex += spanLength;
+        params->Stack[params->StackIndex].FinishedProcessing = true;
+        Reader->LastToken.Type = JL_TOKEN_TYPE_NONE;
+    }
+    else
+    {
+        if( JL_STATUS_JSON_NESTING_TOO_DEEP == jlStatus )
+        {
+            Reader->ErrorAtPos = params->BaseOffset + params->StringIndex;
+        }
+        else
+        {
+            // The input ended part way through the list or dictionary
+            jlStatus = JL_STATUS_INVALID_DATA;
+            Reader->ErrorAtPos = params->BaseOffset + params->JsonStringLength;
+        }
+        FreePartialTree( params );
+        Reader->Status = jlStatus;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  CompileProjectionPath
+//
+//  Splits the JSON Pointer Path into its reference tokens, unescaping ~0 and ~1, and works out which tokens are list
+//  indexes or the * wildcard. The tokens are held in a single allocation. Returns JL_STATUS_INVALID_PARAMETER if Path
+//  is not a valid JSON Pointer.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    CompileProjectionPath
+    (
+        char const*         Path,
+        ProjectionPath*     pProjectionPath
+    )
+{
+    JL_STATUS jlStatus = JL_STATUS_SUCCESS;
+    size_t pathLength = strlen( Path );
+    size_t numTokens = 0;
+
+    if( pathLength > 0 && '/' != Path[0] )
+    {
+        // A non empty pointer must start with a /
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    for( size_t i=0; i<pathLength && JL_STATUS_SUCCESS == jlStatus; i++ )
+    {
+        if( '/' == Path[i] )
+        {
+            numTokens += 1;
+        }
+        else if( '~' == Path[i] && !( i+1 < pathLength && ( '0' == Path[i+1] || '1' == Path[i+1] ) ) )
+        {
+            jlStatus = JL_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        // Token pointers, then token indexes, then the tokens themselves. The tokens are never longer than the path
+        // (each / becomes a terminator) plus the terminator of the last one.
+        size_t tablesSize = numTokens * ( sizeof(char const*) + sizeof(size_t) );
+        char* allocation = JlAlloc( tablesSize + pathLength + 1 );
+        if( NULL != allocation )
+        {
+            char const** tokens = (char const**)allocation;
+            size_t* tokenIndexes = (size_t*)( allocation + numTokens * sizeof(char const*) );
+            char* tokenChars = allocation + tablesSize;
+            size_t tokenNum = 0;
+
+            for( size_t i=0; i<pathLength; i++ )
+            {
+                if( '/' == Path[i] )
+                {
+                    if( tokenNum > 0 )
+                    {
+                        // Terminate the previous token
+                        *tokenChars = 0;
+                        tokenChars += 1;
+                    }
+                    tokens[tokenNum] = tokenChars;
+                    tokenNum += 1;
+                }
+                else if( '~' == Path[i] )
+                {
+                    *tokenChars = ( '0' == Path[i+1] ) ? '~' : '/';
+                    tokenChars += 1;
+                    i += 1;
+                }
+                else
+                {
+                    *tokenChars = Path[i];
+                    tokenChars += 1;
+                }
+            }
+            // The allocation is zeroed so the last token is already terminated
+
+            for( size_t t=0; t<numTokens; t++ )
+            {
+                char const* token = tokens[t];
+                size_t tokenLength = strlen( token );
+
+                if( 0 == strcmp( token, "*" ) )
+                {
+                    tokenIndexes[t] = PROJECTION_TOKEN_WILDCARD;
+                }
+                else if(    tokenLength > 0
+                         && tokenLength <= 9
+                         && !( '0' == token[0] && tokenLength > 1 )
+                         && strspn( token, "0123456789" ) == tokenLength )
+                {
+                    // A list index has no leading zeros. Limiting it to nine digits avoids any overflow.
+                    tokenIndexes[t] = (size_t)strtoul( token, NULL, 10 );
+                }
+                else
+                {
+                    tokenIndexes[t] = PROJECTION_TOKEN_NOT_INDEX;
+                }
+            }
+
+            pProjectionPath->Tokens = tokens;
+            pProjectionPath->TokenIndexes = tokenIndexes;
+            pProjectionPath->NumTokens = numTokens;
+        }
+        else
+        {
+            jlStatus = JL_STATUS_OUT_OF_MEMORY;
+        }
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  FreeProjection
+//
+//  Frees the projection paths held by the parser.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+void
+    FreeProjection
+    (
+        JlParser*       Parser
+    )
+{
+    for( size_t i=0; i<Parser->NumProjectionPaths; i++ )
+    {
+        if( NULL != Parser->Projection[i].Tokens )
+        {
+            JlFree( (void*)Parser->Projection[i].Tokens );
+        }
+    }
+    memset( Parser->Projection, 0, sizeof(Parser->Projection) );
+    Parser->NumProjectionPaths = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  SetLimits
+//
+//  Sets the limits in Params from Limits, with SIZE_MAX for each one that is 0 so that they can be checked without
+//  testing for 0 first. If Limits is NULL there are no limits.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+void
+    SetLimits
+    (
+        ParseParameters*        Params,
+        JlParseLimits const*    Limits          // OPTIONAL
+    )
+{
+    JlParseLimits noLimits = { 0 };
+    JlParseLimits const* limits = ( NULL != Limits ) ? Limits : &noLimits;
+
+    Params->Limits.MaxBytes = ( 0 != limits->MaxBytes ) ? limits->MaxBytes : SIZE_MAX;
+    Params->Limits.MaxValues = ( 0 != limits->MaxValues ) ? limits->MaxValues : SIZE_MAX;
+    Params->Limits.MaxStringLength = ( 0 != limits->MaxStringLength ) ? limits->MaxStringLength : SIZE_MAX;
+    Params->Limits.MaxItems = ( 0 != limits->MaxItems ) ? limits->MaxItems : SIZE_MAX;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  InitParser
+//
+//  Sets up a zeroed JlParser ready for use.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+void
+    InitParser
+    (
+        JlParser*       Parser,
+        JL_PARSE_FLAGS  ParseFlags
+    )
+{
+    Parser->ParseFlags = ParseFlags;
+    Parser->Params.Stack = Parser->Stack;
+    Parser->Params.KeyNameBuffers = Parser->KeyNameBuffers;
+    Parser->Params.IsJson5 = ( ParseFlags & JL_PARSE_FLAGS_JSON5 ) ? true : false;
+    Parser->Params.StopAtIndex = SIZE_MAX;
+    SetLimits( &Parser->Params, NULL );
+    Parser->FeedStatus = JL_STATUS_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  SetBuffer
+//
+//  Sets up Parser to parse a document in JsonBuffer, starting at StartIndex, keeping only the values on the
+//  Projection paths if it is set. Any partially fed document is discarded first.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+void
+    SetBuffer
+    (
+        JlParser*               Parser,
+        char const*             JsonBuffer,
+        size_t                  JsonBufferLength,
+        size_t                  StartIndex,
+        ProjectionPath const*   Projection,         // OPTIONAL
+        size_t                  NumProjectionPaths
+    )
+{
+    if( Parser->DocumentStarted || JL_STATUS_SUCCESS != Parser->FeedStatus )
+    {
+        (void) JlParserReset( Parser );
+    }
+
+    Parser->Params.JsonString = JsonBuffer;
+    Parser->Params.JsonStringLength = JsonBufferLength;
+    Parser->Params.StringIndex = StartIndex;
+    Parser->Params.BaseOffset = 0;
+    Parser->Params.IsFinal = true;
+    Parser->Params.Lazy = ( Parser->ParseFlags & JL_PARSE_FLAGS_LAZY ) ? true : false;
+    Parser->Params.RawNumbers = ( Parser->ParseFlags & JL_PARSE_FLAGS_RAW_NUMBERS ) ? true : false;
+    Parser->Params.RawStrings = ( Parser->ParseFlags & JL_PARSE_FLAGS_RAW_STRINGS ) ? true : false;
+    Parser->Params.Projection = Projection;
+    Parser->Params.NumProjectionPaths = NumProjectionPaths;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ParseBuffer
+//
+//  Parses a document in JsonBuffer, starting at StartIndex, into a tree using Parser, keeping only the values on the
+//  Projection paths if it is set. Any partially fed document is discarded first.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    ParseBuffer
+    (
+        JlParser*               Parser,
+        char const*             JsonBuffer,
+        size_t                  JsonBufferLength,
+        size_t                  StartIndex,
+        ProjectionPath const*   Projection,         // OPTIONAL
+        size_t                  NumProjectionPaths,
+        JlDataObject**          pRootObject,
+        size_t*                 pAmountConsumed,    // OPTIONAL
+        size_t*                 pErrorAtPos         // OPTIONAL
+    )
+{
+    SetBuffer( Parser, JsonBuffer, JsonBufferLength, StartIndex, Projection, NumProjectionPaths );
+
+    return ParseDocument( Parser, pRootObject, pAmountConsumed, pErrorAtPos );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserCreate
+//
+//  Creates a parser that can be used repeatedly with JlParserParse. The parser owns its parse stack and the scratch
+//  buffers used for unescaping strings and numbers, these are kept between parses so that once they have grown to
+//  fit the data being parsed no further allocations are made other than for the returned object tree.
+//  A parser must only be used by one thread at a time. Free with JlParserFree.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserCreate
+    (
+        JL_PARSE_FLAGS  ParseFlags,
+        JlParser**      pParser
+    )
+{
+    JL_STATUS jlStatus;
+
+    if( NULL != pParser )
+    {
+        JlParser* parser = JlNew( JlParser );
+        if( NULL != parser )
+        {
+            InitParser( parser, ParseFlags );
+
+            *pParser = parser;
+            jlStatus = JL_STATUS_SUCCESS;
+        }
+        else
+        {
+            jlStatus = JL_STATUS_OUT_OF_MEMORY;
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserFree
+//
+//  Frees a parser created with JlParserCreate. *pParser will be set to NULL. Any partially parsed document from
+//  JlParserFeed is discarded.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserFree
+    (
+        JlParser**      pParser
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != pParser
+        &&  NULL != *pParser )
+    {
+        JlParser* parser = *pParser;
+
+        FreePartialTree( &parser->Params );
+        for( size_t i=0; i<MAX_JSON_DEPTH+2; i++ )
+        {
+            FreeScratchBuffer( &parser->KeyNameBuffers[i] );
+        }
+        FreeScratchBuffer( &parser->Params.StringBuffer );
+        FreeScratchBuffer( &parser->Params.NumberBuffer );
+        if( NULL != parser->Carry.Buffer )
+        {
+            JlFree( parser->Carry.Buffer );
+        }
+        FreeProjection( parser );
+
+        JlFree( parser );
+        *pParser = NULL;
+        jlStatus = JL_STATUS_SUCCESS;
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserReset
+//
+//  Discards any partially parsed document and input held from JlParserFeed so the parser is ready for a new
+//  document. This does not need to be called after JlParserFinish or JlParserParse.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserReset
+    (
+        JlParser*       Parser
+    )
+{
+    JL_STATUS jlStatus;
+
+    if( NULL != Parser )
+    {
+        // A document abandoned part way through JlParserParseWithBudget leaves its settings (such as lazy values
+        // and projection) in Params. These must not apply to the next document, which may be fed from chunks
+        FreePartialTree( &Parser->Params );
+        EndDocument( Parser );
+        Parser->Params.BaseOffset = 0;
+        Parser->Params.IsFinal = true;
+        Parser->Carry.Used = 0;
+        Parser->FeedStatus = JL_STATUS_SUCCESS;
+        Parser->FeedErrorAtPos = 0;
+        jlStatus = JL_STATUS_SUCCESS;
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserSetProjection
+//
+//  Sets the JSON Pointer paths that JlParserParse and JlParserParseInSitu keep, replacing any set before. Values on
+//  none of the paths are skipped. See JlParser.h for details. Setting NumPaths to 0 removes the projection.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserSetProjection
+    (
+        JlParser*           Parser,
+        char const* const*  Paths,              // OPTIONAL if NumPaths is 0
+        size_t              NumPaths
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != Parser
+        &&  ( NULL != Paths || 0 == NumPaths )
+        &&  NumPaths <= JL_MAX_PROJECTION_PATHS )
+    {
+        FreeProjection( Parser );
+
+        jlStatus = JL_STATUS_SUCCESS;
+        for( size_t i=0; i<NumPaths && JL_STATUS_SUCCESS == jlStatus; i++ )
+        {
+            if( NULL != Paths[i] )
+            {
+                jlStatus = CompileProjectionPath( Paths[i], &Parser->Projection[i] );
+                if( JL_STATUS_SUCCESS == jlStatus )
+                {
+                    Parser->NumProjectionPaths += 1;
+                }
+            }
+            else
+            {
+                jlStatus = JL_STATUS_INVALID_PARAMETER;
+            }
+        }
+
+        if( JL_STATUS_SUCCESS != jlStatus )
+        {
+            // Leave the parser with no projection rather than part of one
+            FreeProjection( Parser );
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserParse
+//
+//  Parses JSON in a buffer of JsonBufferLength bytes using Parser and returns a JlDataObject representing it. The
+//  buffer does not need to be zero terminated. This behaves the same as JlParseJsonBuffer except that the parsing is
+//  done with the parser's buffers. Whether JSON5 is accepted is set by the flags the parser was created with.
+//  If an error occurs (other than JL_STATUS_INVALID_PARAMETER) then *pErrorAtPos will be set with the position
+//  within JsonBuffer where the error occurred. pErrorAtPos is an OPTIONAL parameter.
+//  Any partially fed document from JlParserFeed is discarded.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserParse
+    (
+        JlParser*       Parser,
+        char const*     JsonBuffer,
+        size_t          JsonBufferLength,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos         // OPTIONAL
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != Parser
+        &&  NULL != JsonBuffer
+        &&  NULL != pRootObject )
+    {
+        jlStatus = ParseBuffer(
+            Parser,
+            JsonBuffer,
+            JsonBufferLength,
+            0,
+            ( Parser->NumProjectionPaths > 0 ) ? Parser->Projection : NULL,
+            Parser->NumProjectionPaths,
+            pRootObject,
+            NULL,
+            pErrorAtPos );
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserParseInSitu
+//
+//  Same as JlParserParse except the strings and key names are unescaped in place within JsonBuffer, which is modified,
+//  and the returned tree points at them rather than holding copies. JsonBuffer must stay valid and unchanged until the
+//  tree has been freed.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserParseInSitu
+    (
+        JlParser*       Parser,
+        char*           JsonBuffer,
+        size_t          JsonBufferLength,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos         // OPTIONAL
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != Parser
+        &&  NULL != JsonBuffer
+        &&  NULL != pRootObject )
+    {
+        Parser->Params.InSituBuffer = JsonBuffer;
+        jlStatus = JlParserParse( Parser, JsonBuffer, JsonBufferLength, pRootObject, pErrorAtPos );
+        Parser->Params.InSituBuffer = NULL;
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserSetLimits
+//
+//  Sets limits on the size of each document parsed. See JlParser.h. Passing NULL for Limits removes them.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserSetLimits
+    (
+        JlParser*               Parser,
+        JlParseLimits const*    Limits          // OPTIONAL
+    )
+{
+    JL_STATUS jlStatus;
+
+    if( NULL != Parser )
+    {
+        SetLimits( &Parser->Params, Limits );
+        jlStatus = JL_STATUS_SUCCESS;
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserParseKeys
+//
+//  Parses the root dictionary of the JSON in JsonBuffer only as far as needed to find the values of the NumKeyNames
+//  keys in KeyNames, stopping once they have all been read. See JlParser.h for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserParseKeys
+    (
+        JlParser*           Parser,
+        char const*         JsonBuffer,
+        size_t              JsonBufferLength,
+        char const* const*  KeyNames,
+        size_t              NumKeyNames,
+        JlDataObject**      pRootObject,
+        size_t*             pAmountConsumed,    // OPTIONAL
+        size_t*             pErrorAtPos         // OPTIONAL
+    )
+{
+    JL_STATUS jlStatus;
+    ProjectionPath keyPaths[JL_MAX_PROJECTION_PATHS];
+    size_t const notIndex = PROJECTION_TOKEN_NOT_INDEX;
+
+    if(     NULL != Parser
+        &&  NULL != JsonBuffer
+        &&  NULL != KeyNames
+        &&  NumKeyNames > 0
+        &&  NumKeyNames <= JL_MAX_PROJECTION_PATHS
+        &&  NULL != pRootObject )
+    {
+        // Each key is a path of one token. They are used as they are, so a key of * is not a wildcard here.
+        jlStatus = JL_STATUS_SUCCESS;
+        for( size_t i=0; i<NumKeyNames; i++ )
+        {
+            if( NULL == KeyNames[i] )
+            {
+                jlStatus = JL_STATUS_INVALID_PARAMETER;
+            }
+            keyPaths[i].Tokens = &KeyNames[i];
+            keyPaths[i].TokenIndexes = &notIndex;
+            keyPaths[i].NumTokens = 1;
+        }
+
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            Parser->Params.StopWhenFound = true;
+            jlStatus = ParseBuffer(
+                Parser, JsonBuffer, JsonBufferLength, 0, keyPaths, NumKeyNames, pRootObject, pAmountConsumed, pErrorAtPos );
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserParseNextDocument
+//
+//  Parses the next of a series of documents in JsonBuffer (for example NDJSON) starting at *pOffset, and moves
+//  *pOffset to just after it. Returns JL_STATUS_END_OF_DATA when there is only white space left. See JlParser.h.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserParseNextDocument
+    (
+        JlParser*       Parser,
+        char const*     JsonBuffer,
+        size_t          JsonBufferLength,
+        size_t*         pOffset,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos         // OPTIONAL
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != Parser
+        &&  NULL != JsonBuffer
+        &&  NULL != pOffset
+        &&  *pOffset <= JsonBufferLength
+        &&  NULL != pRootObject )
+    {
+        size_t offset = *pOffset;
+
+        *pRootObject = NULL;
+        jlStatus = VerifyOnlyTrailingWhiteSpace( JsonBuffer + offset, JsonBufferLength - offset, Parser->Params.IsJson5 );
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            // No more documents
+            *pOffset = JsonBufferLength;
+            jlStatus = JL_STATUS_END_OF_DATA;
+        }
+        else
+        {
+            Parser->Params.MultipleDocuments = true;
+            jlStatus = ParseBuffer(
+                Parser,
+                JsonBuffer,
+                JsonBufferLength,
+                offset,
+                ( Parser->NumProjectionPaths > 0 ) ? Parser->Projection : NULL,
+                Parser->NumProjectionPaths,
+                pRootObject,
+                &offset,
+                pErrorAtPos );
+            if( JL_STATUS_SUCCESS == jlStatus )
+            {
+                *pOffset = offset;
+            }
+            else if( JL_STATUS_END_OF_DATA == jlStatus )
+            {
+                // The last document is incomplete. This is kept distinct from reaching the end of the documents.
+                jlStatus = JL_STATUS_INVALID_DATA;
+            }
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserParseWithBudget
+//
+//  Parses JSON in a buffer about ByteBudget bytes at a time, returning JL_STATUS_IN_PROGRESS until the document is
+//  complete. See JlParser.h.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserParseWithBudget
+    (
+        JlParser*       Parser,
+        char const*     JsonBuffer,
+        size_t          JsonBufferLength,
+        size_t          ByteBudget,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos         // OPTIONAL
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != Parser
+        &&  NULL != JsonBuffer
+        &&  0 != ByteBudget
+        &&  NULL != pRootObject )
+    {
+        ParseParameters* params = &Parser->Params;
+
+        if(     !Parser->BudgetInProgress
+            ||  params->JsonString != JsonBuffer
+            ||  params->JsonStringLength != JsonBufferLength )
+        {
+            SetBuffer(
+                Parser,
+                JsonBuffer,
+                JsonBufferLength,
+                0,
+                ( Parser->NumProjectionPaths > 0 ) ? Parser->Projection : NULL,
+                Parser->NumProjectionPaths );
+            StartDocument( Parser );
+            Parser->BudgetInProgress = true;
+        }
+
+        if( JsonBufferLength - params->StringIndex > ByteBudget )
+        {
+            params->StopAtIndex = params->StringIndex + ByteBudget;
+        }
+        jlStatus = RunParser( &Parser->Params, pErrorAtPos );
+        params->StopAtIndex = SIZE_MAX;
+
+        if(     JL_STATUS_SUCCESS == jlStatus
+            &&  params->StackIndex >= 0 )
+        {
+            // Stopped part way through, carry on next time
+            jlStatus = JL_STATUS_IN_PROGRESS;
+        }
+        else
+        {
+            if( JL_STATUS_SUCCESS == jlStatus )
+            {
+                jlStatus = CompleteDocument( &Parser->Params, pRootObject, pErrorAtPos );
+            }
+            EndDocument( Parser );
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserParseEvents
+//
+//  Parses JSON in a buffer of JsonBufferLength bytes using Parser, calling the functions in Callbacks for each item
+//  as it is read instead of building a JlDataObject tree. No memory is allocated for the values, the only memory used
+//  is the parser's stack and scratch buffers, so this can be used on documents of any size. Context is passed to each
+//  callback.
+//  The events are the same for Json1 and Json5 (as set by the parser's flags). As no tree is kept, repeated keys in a
+//  dictionary are not detected and are reported like any other key.
+//  If an error occurs (other than JL_STATUS_INVALID_PARAMETER) then *pErrorAtPos will be set with the position
+//  within JsonBuffer where the error occurred. Events will already have been sent for the data before the error.
+//  pErrorAtPos is an OPTIONAL parameter.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserParseEvents
+    (
+        JlParser*                   Parser,
+        char const*                 JsonBuffer,
+        size_t                      JsonBufferLength,
+        JlParseCallbacks const*     Callbacks,
+        void*                       Context,            // OPTIONAL
+        size_t*                     pErrorAtPos         // OPTIONAL
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != Parser
+        &&  NULL != JsonBuffer
+        &&  NULL != Callbacks )
+    {
+        if( Parser->DocumentStarted || JL_STATUS_SUCCESS != Parser->FeedStatus )
+        {
+            (void) JlParserReset( Parser );
+        }
+
+        Parser->Params.JsonString = JsonBuffer;
+        Parser->Params.JsonStringLength = JsonBufferLength;
+        Parser->Params.StringIndex = 0;
+        Parser->Params.BaseOffset = 0;
+        Parser->Params.IsFinal = true;
+        Parser->Params.Callbacks = Callbacks;
+        Parser->Params.CallbackContext = Context;
+
+        jlStatus = ParseDocument( Parser, NULL, NULL, pErrorAtPos );
+
+        Parser->Params.Callbacks = NULL;
+        Parser->Params.CallbackContext = NULL;
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserFeed
+//
+//  Gives the next ChunkLength bytes of a JSON document to the parser. The document can be split at any point, including
+//  in the middle of a string, number, escape sequence, or comment. As much as possible is parsed straight from Chunk,
+//  only an incomplete token at the end of the chunk is copied and held until the next call. Chunk does not need to
+//  remain valid after the call returns. Call JlParserFinish after the last chunk to get the object tree.
+//  If the data is found to be invalid the error is returned and will continue to be returned by further calls to
+//  JlParserFeed and JlParserFinish until the parser is reset. *pErrorAtPos will be set with the position of the error
+//  counted from the start of the first chunk. pErrorAtPos is an OPTIONAL parameter.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserFeed
+    (
+        JlParser*       Parser,
+        char const*     Chunk,
+        size_t          ChunkLength,
+        size_t*         pErrorAtPos         // OPTIONAL
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != Parser
+        &&  ( NULL != Chunk || 0 == ChunkLength ) )
+    {
+        ParseParameters* params = &Parser->Params;
+
+        if( Parser->BudgetInProgress )
+        {
+            // Discard the unfinished document from JlParserParseWithBudget
+            (void) JlParserReset( Parser );
+        }
+
+        jlStatus = Parser->FeedStatus;
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            if( !Parser->DocumentStarted )
+            {
+                StartDocument( Parser );
+                params->BaseOffset = 0;
+            }
+
+            params->IsFinal = false;
+            if( Parser->Carry.Used > 0  &&  params->StackIndex >= 0 )
+            {
+                // Complete the token that was left over from last time
+                jlStatus = CompleteCarriedToken( Parser, Chunk, ChunkLength );
+            }
+            else if( Parser->Carry.Used > 0 )
+            {
+                // Input after the end of the document, which is checked by JlParserFinish
+                jlStatus = AppendToCarry( &Parser->Carry, Chunk, ChunkLength );
+                params->JsonString = Parser->Carry.Buffer;
+                params->JsonStringLength = Parser->Carry.Used;
+                params->StringIndex = 0;
+            }
+            else
+            {
+                params->JsonString = Chunk;
+                params->JsonStringLength = ChunkLength;
+                params->StringIndex = 0;
+            }
+
+            if( JL_STATUS_SUCCESS == jlStatus  &&  params->StackIndex >= 0 )
+            {
+                jlStatus = RunParser( &Parser->Params, &Parser->FeedErrorAtPos );
+            }
+            if( JL_STATUS_NEED_MORE_DATA == jlStatus )
+            {
+                jlStatus = JL_STATUS_SUCCESS;
+            }
+
+            if( JL_STATUS_SUCCESS == jlStatus )
+            {
+                // Anything remaining is either an incomplete token or follows the end of the document. It will be
+                // checked when there is more input or by JlParserFinish.
+                jlStatus = KeepUnconsumedInput( Parser );
+            }
+
+            if( JL_STATUS_SUCCESS != jlStatus )
+            {
+                FreePartialTree( params );
+                Parser->FeedStatus = jlStatus;
+                params->JsonString = NULL;
+                params->JsonStringLength = 0;
+                params->StringIndex = 0;
+            }
+        }
+
+        if(     JL_STATUS_SUCCESS != jlStatus
+            &&  NULL != pErrorAtPos )
+        {
+            *pErrorAtPos = Parser->FeedErrorAtPos;
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserFinish
+//
+//  Completes a document given to the parser with JlParserFeed and returns a JlDataObject representing it. This
+//  returns the same result as JlParserParse would have done with the whole document in one buffer. If no chunks were
+//  fed then this is the same as parsing an empty buffer.
+//  If an error occurs (other than JL_STATUS_INVALID_PARAMETER) then *pErrorAtPos will be set with the position
+//  of the error counted from the start of the first chunk. pErrorAtPos is an OPTIONAL parameter.
+//  The parser is reset afterwards and can be used for another document.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserFinish
+    (
+        JlParser*       Parser,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos         // OPTIONAL
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != Parser
+        &&  NULL != pRootObject )
+    {
+        ParseParameters* params = &Parser->Params;
+        size_t errorAtPos = Parser->FeedErrorAtPos;
+
+        jlStatus = Parser->FeedStatus;
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            if( !Parser->DocumentStarted )
+            {
+                StartDocument( Parser );
+                params->BaseOffset = 0;
+            }
+
+            params->JsonString = Parser->Carry.Used > 0 ? Parser->Carry.Buffer : "";
+            params->JsonStringLength = Parser->Carry.Used;
+            params->StringIndex = 0;
+            params->IsFinal = true;
+
+            if( params->StackIndex >= 0 )
+            {
+                jlStatus = RunParser( &Parser->Params, &errorAtPos );
+            }
+            if( JL_STATUS_SUCCESS == jlStatus )
+            {
+                jlStatus = CompleteDocument( &Parser->Params, pRootObject, &errorAtPos );
+            }
+        }
+
+        if(     JL_STATUS_SUCCESS != jlStatus
+            &&  NULL != pErrorAtPos )
+        {
+            *pErrorAtPos = errorAtPos;
+        }
+
+        (void) JlParserReset( Parser );
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParseJson
+//
+//  Parses JSON 5 in a string and returns a JlDataObject representing it.
+//  If an error occurs (other than JL_STATUS_INVALID_PARAMETER) then *pErrorAtPos will be set with the position
+//  within JsonString where the error occurred. pErrorAtPos is an OPTIONAL parameter
+//  If string JSON 1 parsing is required use JlParseJsonEx
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParseJson
+    (
+        char const*     JsonString,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos
+    )
+{
+    return JlParseJsonEx( JsonString, true, pRootObject, pErrorAtPos );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParseJsonEx
+//
+//  Parses JSON in a string and returns a JlDataObject representing it.
+//  If an error occurs (other than JL_STATUS_INVALID_PARAMETER) then *pErrorAtPos will be set with the position
+//  within JsonString where the error occurred. pErrorAtPos is an OPTIONAL parameter.
+//  If IsJson5 is true then JSON 5 parsing will be done, otherwise strict JSON 1 parsing.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParseJsonEx
+    (
+        char const*     JsonString,
+        bool            IsJson5,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != JsonString
+        &&  NULL != pRootObject )
+    {
+        jlStatus = JlParseJsonBuffer( JsonString, strlen( JsonString ), IsJson5, pRootObject, pErrorAtPos );
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParseJsonBuffer
+//
+//  Parses JSON in a buffer of JsonBufferLength bytes and returns a JlDataObject representing it. The buffer does not
+//  need to be zero terminated and no bytes beyond JsonBufferLength will be read.
+//  If an error occurs (other than JL_STATUS_INVALID_PARAMETER) then *pErrorAtPos will be set with the position
+//  within JsonBuffer where the error occurred. pErrorAtPos is an OPTIONAL parameter.
+//  If IsJson5 is true then JSON 5 parsing will be done, otherwise strict JSON 1 parsing.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParseJsonBuffer
+    (
+        char const*     JsonBuffer,
+        size_t          JsonBufferLength,
+        bool            IsJson5,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != JsonBuffer
+        &&  NULL != pRootObject )
+    {
+        JlParser* parser = NULL;
+
+        jlStatus = JlParserCreate( IsJson5 ? JL_PARSE_FLAGS_JSON5 : JL_PARSE_FLAGS_NONE, &parser );
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            jlStatus = JlParserParse( parser, JsonBuffer, JsonBufferLength, pRootObject, pErrorAtPos );
+            (void) JlParserFree( &parser );
         }
-        else if( Params->IsJson5 && '/' == currentChar && '*' == nextChar )
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParseJsonIov
+//
+//  Parses a JSON document held in several separate buffers. See JsonLib.h.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParseJsonIov
+    (
+        JlIoVec const*  Segments,
+        size_t          NumSegments,
+        bool            IsJson5,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos         // OPTIONAL
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     ( NULL != Segments || 0 == NumSegments )
+        &&  NULL != pRootObject )
+    {
+        JlParser* parser = NULL;
+
+        jlStatus = JlParserCreate( IsJson5 ? JL_PARSE_FLAGS_JSON5 : JL_PARSE_FLAGS_NONE, &parser );
+        if( JL_STATUS_SUCCESS == jlStatus  &&  1 == NumSegments )
         {
-            inMultiLineComment = true;
-            Params->StringIndex += 1;
+            jlStatus = JlParserParse( parser, Segments[0].Base, Segments[0].Length, pRootObject, pErrorAtPos );
         }
-        else
+        else if( JL_STATUS_SUCCESS == jlStatus )
         {
-            // First non whitespace/comment
-            *pNextChar = currentChar;
-            jlStatus = JL_STATUS_SUCCESS;
-            break;
+            // Any error is held by the parser and returned by JlParserFinish
+            for( size_t i=0; i<NumSegments && JL_STATUS_SUCCESS == jlStatus; i++ )
+            {
+                jlStatus = JlParserFeed( parser, Segments[i].Base, Segments[i].Length, NULL );
+            }
+            jlStatus = JlParserFinish( parser, pRootObject, pErrorAtPos );
         }
 
-        Params->StringIndex += 1;
+        if( NULL != parser )
+        {
+            (void) JlParserFree( &parser );
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
     }
 
     return jlStatus;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//  ParseForList
+//  JlParseJsonFile
+//
+//  Parses JSON in a file, which is mapped into memory rather than read. See JsonLib.h.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-static
 JL_STATUS
-    ParseForList
+    JlParseJsonFile
     (
-        ParseParameters*    Params,
-        size_t*             pErrorAtPos     // OPTIONAL
+        char const*     Filename,
+        bool            IsJson5,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos         // OPTIONAL
     )
 {
     JL_STATUS jlStatus;
-    ParseStack* currentStack = &Params->Stack[Params->StackIndex];
-    char nextChar;
 
-    if( !currentStack->ProcessedFirstItem )
+    if(     NULL != Filename
+        &&  NULL != pRootObject )
+    {
+        JlFileMap* fileMap = NULL;
+        char const* json = NULL;
+        size_t jsonLength = 0;
+
+        *pRootObject = NULL;
+        if( NULL != pErrorAtPos )
+        {
+            *pErrorAtPos = 0;
+        }
+
+        // The tree holds copies of the strings, so nothing refers to the file once it has been parsed
+        jlStatus = JlFileMapCreate( Filename, &fileMap, &json, &jsonLength );
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            jlStatus = JlParseJsonBuffer( json, jsonLength, IsJson5, pRootObject, pErrorAtPos );
+            (void) JlFileMapFree( &fileMap );
+        }
+    }
+    else
     {
-        // Skip past opening square bracket
-        Params->StringIndex += 1;
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
     }
 
-    jlStatus = SkipWhiteSpace( Params, &nextChar );
-    if( JL_STATUS_SUCCESS == jlStatus )
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParseJsonInSitu
+//
+//  Same as JlParseJsonBuffer except the strings and key names are unescaped in place within JsonBuffer, which is
+//  modified, and the returned tree points at them rather than holding copies. JsonBuffer must stay valid and unchanged
+//  until the tree has been freed.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParseJsonInSitu
+    (
+        char*           JsonBuffer,
+        size_t          JsonBufferLength,
+        bool            IsJson5,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != JsonBuffer
+        &&  NULL != pRootObject )
+    {
+        JlParser* parser = NULL;
+
+        jlStatus = JlParserCreate( IsJson5 ? JL_PARSE_FLAGS_JSON5 : JL_PARSE_FLAGS_NONE, &parser );
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            jlStatus = JlParserParseInSitu( parser, JsonBuffer, JsonBufferLength, pRootObject, pErrorAtPos );
+            (void) JlParserFree( &parser );
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParseJsonLazy
+//
+//  Same as JlParseJsonBuffer except that lists and dictionaries below the root are only parsed the first time they
+//  are used. JsonBuffer must stay valid and unchanged until the tree has been freed.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParseJsonLazy
+    (
+        char const*     JsonBuffer,
+        size_t          JsonBufferLength,
+        bool            IsJson5,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != JsonBuffer
+        &&  NULL != pRootObject )
+    {
+        JlParser* parser = NULL;
+
+        jlStatus = JlParserCreate( ( IsJson5 ? JL_PARSE_FLAGS_JSON5 : JL_PARSE_FLAGS_NONE ) | JL_PARSE_FLAGS_LAZY, &parser );
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            jlStatus = JlParserParse( parser, JsonBuffer, JsonBufferLength, pRootObject, pErrorAtPos );
+            (void) JlParserFree( &parser );
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParseJsonProjection
+//
+//  Same as JlParseJsonBuffer except that only the values on the NumPaths JSON Pointer paths in Paths are parsed into
+//  the tree. See JlParserSetProjection in JlParser.h.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParseJsonProjection
+    (
+        char const*         JsonBuffer,
+        size_t              JsonBufferLength,
+        bool                IsJson5,
+        char const* const*  Paths,
+        size_t              NumPaths,
+        JlDataObject**      pRootObject,
+        size_t*             pErrorAtPos
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != JsonBuffer
+        &&  NULL != pRootObject )
     {
-        if( !currentStack->PrevScanComma )
+        JlParser* parser = NULL;
+
+        jlStatus = JlParserCreate( IsJson5 ? JL_PARSE_FLAGS_JSON5 : JL_PARSE_FLAGS_NONE, &parser );
+        if( JL_STATUS_SUCCESS == jlStatus )
         {
-            if( ']' == nextChar )
+            jlStatus = JlParserSetProjection( parser, Paths, NumPaths );
+            if( JL_STATUS_SUCCESS == jlStatus )
             {
-                // End of array
-                currentStack->FinishedProcessing = true;
-                Params->StringIndex += 1;
+                jlStatus = JlParserParse( parser, JsonBuffer, JsonBufferLength, pRootObject, pErrorAtPos );
             }
-            else if( ',' == nextChar )
+            (void) JlParserFree( &parser );
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParseJsonKeys
+//
+//  Parses the root dictionary of the JSON only as far as needed to read the NumKeyNames keys in KeyNames. See
+//  JlParserParseKeys in JlParser.h.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParseJsonKeys
+    (
+        char const*         JsonBuffer,
+        size_t              JsonBufferLength,
+        bool                IsJson5,
+        char const* const*  KeyNames,
+        size_t              NumKeyNames,
+        JlDataObject**      pRootObject,
+        size_t*             pAmountConsumed,
+        size_t*             pErrorAtPos
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != JsonBuffer
+        &&  NULL != pRootObject )
+    {
+        JlParser* parser = NULL;
+
+        jlStatus = JlParserCreate( IsJson5 ? JL_PARSE_FLAGS_JSON5 : JL_PARSE_FLAGS_NONE, &parser );
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            jlStatus = JlParserParseKeys(
+                parser, JsonBuffer, JsonBufferLength, KeyNames, NumKeyNames, pRootObject, pAmountConsumed, pErrorAtPos );
+            (void) JlParserFree( &parser );
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParseLazySpan
+//
+//  Parses the span of a lazy list or dictionary into a new object of the same type. Lists and dictionaries within it
+//  are left as lazy spans themselves. BaseOffset is the position of the span in the original input, used for the
+//  object tags. Declared in JlLazy.h
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParseLazySpan
+    (
+        char const*     Json,
+        size_t          JsonLength,
+        bool            IsJson5,
+        size_t          BaseOffset,
+        JlDataObject**  pContainerObject
+    )
+{
+    JL_STATUS jlStatus;
+    JlParser* parser = NULL;
+
+    jlStatus = JlParserCreate( ( IsJson5 ? JL_PARSE_FLAGS_JSON5 : JL_PARSE_FLAGS_NONE ) | JL_PARSE_FLAGS_LAZY, &parser );
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        parser->Params.JsonString = Json;
+        parser->Params.JsonStringLength = JsonLength;
+        parser->Params.StringIndex = 0;
+        parser->Params.BaseOffset = BaseOffset;
+        parser->Params.IsFinal = true;
+        parser->Params.Lazy = true;
+
+        jlStatus = ParseDocument( parser, pContainerObject, NULL, NULL );
+        (void) JlParserFree( &parser );
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlUnescapeStringSpan
+//
+//  Unescapes the span of a string from a JL_PARSE_FLAGS_RAW_STRINGS parse into a new string. Declared in JlLazy.h
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlUnescapeStringSpan
+    (
+        char const*     Json,
+        size_t          JsonLength,
+        bool            IsJson5,
+        bool            HasEscapes,
+        char**          pString
+    )
+{
+    JL_STATUS jlStatus;
+    char* string = NULL;
+    size_t stringLength = 0;
+
+    if(     NULL != Json
+        &&  JsonLength >= 2
+        &&  NULL != pString )
+    {
+        if( !HasEscapes )
+        {
+            // Only the quotes need removing
+            stringLength = JsonLength - 2;
+            string = JlAlloc( stringLength + 1 );
+            if( NULL != string )
             {
-                if( ! currentStack->ProcessedFirstItem )
-                {
-                    // Should not be a comma before first item
-                    jlStatus = JL_STATUS_INVALID_DATA;
-                }
-                else
-                {
-                    Params->StringIndex += 1;
-                    currentStack->PrevScanComma = true;
-                }
+                memcpy( string, Json+1, stringLength );
+                string[stringLength] = 0;
+                jlStatus = JL_STATUS_SUCCESS;
             }
             else
             {
-                if( currentStack->ProcessedFirstItem )
-                {
-                    // After first item we need to have a comma or a end bracket after
-                    // the data.
-                    jlStatus = JL_STATUS_INVALID_DATA;
-                }
-                else
-                {
-                    currentStack->ScanForSubObjects = true;
-                }
+                jlStatus = JL_STATUS_OUT_OF_MEMORY;
             }
         }
         else
         {
-            // If in last scan we had a comma then we must not have a comma again or an end bracket unless
-            // its Json5
-            if(     ',' == nextChar
-                ||  ( ']' == nextChar && !Params->IsJson5 ) )
-            {
-                jlStatus = JL_STATUS_INVALID_DATA;
-            }
-            else if( ']' == nextChar && Params->IsJson5 )
-            {
-                // Allowed an end bracket after a trailing comma in Json5
-                currentStack->FinishedProcessing = true;
-                Params->StringIndex += 1;
-            }
-            else
-            {
-                currentStack->ScanForSubObjects = true;
-                currentStack->PrevScanComma = false;
-            }
+            ParseParameters params = { 0 };
+            size_t amountProcessed = 0;
+
+            params.JsonString = Json;
+            params.JsonStringLength = JsonLength;
+            params.IsJson5 = IsJson5;
+            params.IsFinal = true;
+            SetLimits( &params, NULL );
+
+            jlStatus = ParseString( &params, false, IsJson5, NULL, &amountProcessed, &string, &stringLength );
+        }
+
+        if( JL_STATUS_SUCCESS == jlStatus && 0 == stringLength )
+        {
+            // Empty strings are not stored
+            JlFree( string );
+            string = NULL;
+        }
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            *pString = string;
         }
-
-        currentStack->ProcessedFirstItem = true;
     }
-
-    if(     JL_STATUS_SUCCESS != jlStatus
-        &&  NULL != pErrorAtPos
-        &&  0 == *pErrorAtPos )
+    else
     {
-        *pErrorAtPos = Params->StringIndex;
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
     }
 
     return jlStatus;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//  ParseKeyName
+//  JlParserParseListSlice
 //
-//  Parses the KeyName from the json string.
+//  Parses the elements of the root list in JsonBuffer from SliceStart up to SliceEnd into a new list object.
+//  Declared in JlParseSlice.h
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-static
 JL_STATUS
-    ParseKeyName
+    JlParserParseListSlice
     (
-        ParseParameters*    Params,
-        bool                IsBareWord
+        JlParser*       Parser,
+        char const*     JsonBuffer,
+        size_t          SliceStart,
+        size_t          SliceEnd,
+        bool            AfterComma,
+        bool            EndsAtComma,
+        JlDataObject**  pListObject,
+        size_t*         pErrorAtPos         // OPTIONAL
     )
 {
     JL_STATUS jlStatus;
-    size_t amountProcessed = 0;
 
-    jlStatus = ParseString(
-        Params->JsonString + Params->StringIndex,
-        Params->JsonStringLength - Params->StringIndex,
-        IsBareWord,
-        false,
-        &amountProcessed,
-        &Params->Stack[Params->StackIndex].CurrentKeyName );
-    if( JL_STATUS_SUCCESS == jlStatus )
+    if(     NULL != Parser
+        &&  NULL != JsonBuffer
+        &&  SliceStart <= SliceEnd
+        &&  NULL != pListObject )
     {
-        Params->Stack[Params->StackIndex].CurrentKeyStringIndex = Params->StringIndex;
-        Params->StringIndex += amountProcessed;
+        *pListObject = NULL;
+        Parser->Params.ListSliceAfterComma = AfterComma;
+        Parser->Params.ListSliceEndsAtComma = EndsAtComma;
+        jlStatus = ParseBuffer( Parser, JsonBuffer, SliceEnd, SliceStart, NULL, 0, pListObject, NULL, pErrorAtPos );
+        if(     JL_STATUS_SUCCESS == jlStatus
+            &&  JL_DATA_TYPE_LIST != JlGetObjectType( *pListObject ) )
+        {
+            (void) JlFreeObjectTree( pListObject );
+            jlStatus = JL_STATUS_WRONG_TYPE;
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
     }
 
     return jlStatus;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//  ParseForDictionary
+//  JlParseJsonEvents
+//
+//  Parses JSON in a buffer of JsonBufferLength bytes calling the functions in Callbacks for each item as it is read.
+//  No JlDataObject tree is built. See JlParserParseEvents in JlParser.h for details.
+//  If an error occurs (other than JL_STATUS_INVALID_PARAMETER) then *pErrorAtPos will be set with the position
+//  within JsonBuffer where the error occurred. pErrorAtPos is an OPTIONAL parameter.
+//  If IsJson5 is true then JSON 5 parsing will be done, otherwise strict JSON 1 parsing.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-static
 JL_STATUS
-    ParseForDictionary
+    JlParseJsonEvents
     (
-        ParseParameters*    Params,
-        size_t*             pErrorAtPos     // OPTIONAL
+        char const*                 JsonBuffer,
+        size_t                      JsonBufferLength,
+        bool                        IsJson5,
+        JlParseCallbacks const*     Callbacks,
+        void*                       Context,
+        size_t*                     pErrorAtPos
     )
 {
     JL_STATUS jlStatus;
-    ParseStack* currentStack = &Params->Stack[Params->StackIndex];
-    char nextChar;
 
-    if( !currentStack->ProcessedFirstItem )
+    if(     NULL != JsonBuffer
+        &&  NULL != Callbacks )
     {
-        // Skip past opening curly bracket
-        Params->StringIndex += 1;
-        currentStack->DictionaryScanState = DICT_SCAN_STATE_NEED_KEY;
-    }
+        JlParser* parser = NULL;
 
-    jlStatus = SkipWhiteSpace( Params, &nextChar );
-    if( JL_STATUS_SUCCESS == jlStatus )
-    {
-        if( DICT_SCAN_STATE_NEED_KEY == currentStack->DictionaryScanState )
-        {
-            if(     '\"' == nextChar
-                ||  ( Params->IsJson5 && '\'' == nextChar ) )
-            {
-                // Read key
-                jlStatus = ParseKeyName( Params, false );
-                currentStack->DictionaryScanState = DICT_SCAN_STATE_NEED_COLON;
-            }
-            else if( Params->IsJson5 &&
-                     (      '_' == nextChar
-                       ||   '$' == nextChar
-                       ||   ( nextChar >= 'a' && nextChar <= 'z' )
-                       ||   ( nextChar >= 'A' && nextChar <= 'Z' )
-                       ) )
-            {
-                // Json5 bareword key
-                jlStatus = ParseKeyName( Params, true );
-                currentStack->DictionaryScanState = DICT_SCAN_STATE_NEED_COLON;
-            }
-            else if( '}' == nextChar && ( !currentStack->ProcessedFirstItem || Params->IsJson5 ) )
-            {
-                // This means an empty dictionary or, in Json5, there was a trailing comma
-                currentStack->FinishedProcessing = true;
-                currentStack->DictionaryScanState = DICT_SCAN_STATE_NONE;
-                Params->StringIndex += 1;   // Move past end curly bracket
-            }
-            else
-            {
-                jlStatus = JL_STATUS_INVALID_DATA;
-            }
-        }
-        else if( DICT_SCAN_STATE_NEED_COLON == currentStack->DictionaryScanState )
-        {
-            if( ':' == nextChar )
-            {
-                currentStack->DictionaryScanState = DICT_SCAN_STATE_NEED_VALUE;
-                currentStack->ScanForSubObjects = true;
-                Params->StringIndex += 1;   // Move past colon
-            }
-            else
-            {
-                jlStatus = JL_STATUS_INVALID_DATA;
-            }
-        }
-        else if( DICT_SCAN_STATE_NEED_VALUE == currentStack->DictionaryScanState )
-        {
-            // We will have added object already because ScanForSubObjects was set and
-            // value processed in main loop. So we just need to skip on to the next state
-            currentStack->DictionaryScanState = DICT_SCAN_STATE_NEED_COMMA_OR_END;
-            currentStack->ScanForSubObjects = false;
-        }
-        else if( DICT_SCAN_STATE_NEED_COMMA_OR_END == currentStack->DictionaryScanState )
+        jlStatus = JlParserCreate( IsJson5 ? JL_PARSE_FLAGS_JSON5 : JL_PARSE_FLAGS_NONE, &parser );
+        if( JL_STATUS_SUCCESS == jlStatus )
         {
-            if( ',' == nextChar )
-            {
-                // Set back to scanning for a new keyname
-                currentStack->DictionaryScanState = DICT_SCAN_STATE_NEED_KEY;
-                Params->StringIndex += 1;   // Move past comma
-            }
-            else if( '}' == nextChar )
-            {
-                // End dictionary
-                currentStack->FinishedProcessing = true;
-                currentStack->DictionaryScanState = DICT_SCAN_STATE_NONE;
-                Params->StringIndex += 1;   // Move past end curly bracket
-            }
-            else
-            {
-                jlStatus = JL_STATUS_INVALID_DATA;
-            }
+            jlStatus = JlParserParseEvents( parser, JsonBuffer, JsonBufferLength, Callbacks, Context, pErrorAtPos );
+            (void) JlParserFree( &parser );
         }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
 
-        if(     JL_STATUS_SUCCESS != jlStatus
-            &&  NULL != currentStack->CurrentKeyName )
-        {
-            JlFree( currentStack->CurrentKeyName );
-            currentStack->CurrentKeyName = NULL;
-        }
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlValidateJson
+//
+//  Checks that a buffer of JsonBufferLength bytes contains valid JSON without building anything. Repeated and empty
+//  dictionary keys are treated differently to JlParseJsonBuffer. See JsonLib.h.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlValidateJson
+    (
+        char const*     JsonBuffer,
+        size_t          JsonBufferLength,
+        bool            IsJson5,
+        size_t*         pErrorAtPos         // OPTIONAL
+    )
+{
+    JL_STATUS jlStatus;
 
-        currentStack->ProcessedFirstItem = true;
+    if( NULL != JsonBuffer )
+    {
+        // Only the parse parameters and the parse stack are needed, not a whole JlParser, as nothing is kept.
+        ParseParameters params;
+        ParseStack stack[MAX_JSON_DEPTH+2];
 
-        if(     JL_STATUS_SUCCESS != jlStatus
-            &&  NULL != pErrorAtPos
-            &&  0 == *pErrorAtPos )
+        memset( &params, 0, sizeof(params) );
+        memset( stack, 0, sizeof(stack) );
+        params.Stack = stack;
+        params.IsJson5 = IsJson5;
+        params.StopAtIndex = SIZE_MAX;
+        SetLimits( &params, NULL );
+        params.JsonString = JsonBuffer;
+        params.JsonStringLength = JsonBufferLength;
+        params.IsFinal = true;
+        params.Callbacks = &gValidateCallbacks;
+        params.ValidateOnly = true;
+
+        StartParseStack( &params );
+        jlStatus = RunParser( &params, pErrorAtPos );
+        if( JL_STATUS_SUCCESS == jlStatus )
         {
-            *pErrorAtPos = Params->StringIndex;
+            jlStatus = CompleteDocument( &params, NULL, pErrorAtPos );
         }
     }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
 
     return jlStatus;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//  AttachStackObjectToPreviousObject
+//  JlReaderCreate
 //
-//  Attaches the latest object in the stack to the previous object if the previous one is a list or dictionary.
+//  Creates a reader. Whether JSON5 is accepted is set by ParseFlags. Use JlReaderStart to set the JSON to read. The
+//  reader can be used for any number of documents. Free with JlReaderFree.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-static
 JL_STATUS
-    AttachStackObjectToPreviousObject
+    JlReaderCreate
     (
-        ParseStack*     Stack,
-        int32_t         StackIndex,
-        size_t*         pErrorAtPos
+        JL_PARSE_FLAGS  ParseFlags,
+        JlReader**      pReader
     )
 {
     JL_STATUS jlStatus;
 
-    if( StackIndex > 0 )
+    if( NULL != pReader )
     {
-        ParseStack* currentStackItem = &Stack[StackIndex];
-        ParseStack* prevStackItem = &Stack[StackIndex-1];
-
-        if( JL_DATA_TYPE_LIST == prevStackItem->Type )
+        JlReader* reader = JlNew( JlReader );
+        if( NULL != reader )
         {
-            jlStatus = JlAttachObjectToListObject( prevStackItem->Object, currentStackItem->Object );
-        }
-        else if( JL_DATA_TYPE_DICTIONARY == prevStackItem->Type )
-        {
-            jlStatus = JlAttachObjectToDictionaryObject( prevStackItem->Object, prevStackItem->CurrentKeyName, currentStackItem->Object );
-            if(     JL_STATUS_SUCCESS != jlStatus
-                &&  NULL != pErrorAtPos )
+            jlStatus = JlParserCreate( ParseFlags, &reader->Parser );
+            if( JL_STATUS_SUCCESS == jlStatus )
+            {
+                // Nothing to read until JlReaderStart is called
+                reader->Finished = true;
+                *pReader = reader;
+            }
+            else
             {
-                *pErrorAtPos = prevStackItem->CurrentKeyStringIndex;
+                JlFree( reader );
             }
-            JlFree( prevStackItem->CurrentKeyName );
-            prevStackItem->CurrentKeyName = NULL;
         }
         else
         {
-            // nothing to attach it to. This occurs when the root object in the json is not a dictionary or list
-            jlStatus = JL_STATUS_SUCCESS;
+            jlStatus = JL_STATUS_OUT_OF_MEMORY;
         }
     }
     else
     {
-        // nothing to attach it to. This occurs when the root object in the json is not a dictionary or list
-        jlStatus = JL_STATUS_SUCCESS;
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
     }
 
     return jlStatus;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//  PUBLIC FUNCTIONS
+//  JlReaderFree
+//
+//  Frees a reader created with JlReaderCreate. *pReader will be set to NULL.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlReaderFree
+    (
+        JlReader**      pReader
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != pReader
+        &&  NULL != *pReader )
+    {
+        (void) JlParserFree( &(*pReader)->Parser );
+        JlFree( *pReader );
+        *pReader = NULL;
+        jlStatus = JL_STATUS_SUCCESS;
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//  JlParseJson
+//  JlReaderStart
 //
-//  Parses JSON 5 in a string and returns a JlDataObject representing it.
-//  If an error occurs (other than JL_STATUS_INVALID_PARAMETER) then *pErrorAtPos will be set with the position
-//  within JsonString where the error occurred. pErrorAtPos is an OPTIONAL parameter
-//  If string JSON 1 parsing is required use JlParseJsonEx
+//  Sets the reader to read the JSON in a buffer of JsonBufferLength bytes. The buffer does not need to be zero
+//  terminated and must remain valid while it is being read. Any document previously being read is abandoned.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 JL_STATUS
-    JlParseJson
+    JlReaderStart
     (
-        char const*     JsonString,
-        JlDataObject**  pRootObject,
-        size_t*         pErrorAtPos
+        JlReader*       Reader,
+        char const*     JsonBuffer,
+        size_t          JsonBufferLength
     )
 {
-    return JlParseJsonEx( JsonString, true, pRootObject, pErrorAtPos );
+    JL_STATUS jlStatus;
+
+    if(     NULL != Reader
+        &&  NULL != JsonBuffer )
+    {
+        JlParser* parser = Reader->Parser;
+
+        (void) JlParserReset( parser );
+        StartDocument( parser );
+        parser->Params.JsonString = JsonBuffer;
+        parser->Params.JsonStringLength = JsonBufferLength;
+        parser->Params.Callbacks = &gReaderCallbacks;
+        parser->Params.CallbackContext = Reader;
+
+        memset( &Reader->Token, 0, sizeof(Reader->Token) );
+        memset( &Reader->LastToken, 0, sizeof(Reader->LastToken) );
+        Reader->HavePendingToken = false;
+        Reader->Finished = false;
+        Reader->Status = JL_STATUS_SUCCESS;
+        Reader->ErrorAtPos = 0;
+        jlStatus = JL_STATUS_SUCCESS;
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//  JlParseJsonEx
+//  JlReaderNext
 //
-//  Parses JSON in a string and returns a JlDataObject representing it.
-//  If an error occurs (other than JL_STATUS_INVALID_PARAMETER) then *pErrorAtPos will be set with the position
-//  within JsonString where the error occurred. pErrorAtPos is an OPTIONAL parameter.
-//  If IsJson5 is true then JSON 5 parsing will be done, otherwise strict JSON 1 parsing.
+//  Reads the next token from the document into *pToken. Returns JL_STATUS_END_OF_DATA once the whole document has
+//  been read. If the document is invalid, including ending before it is complete, then an error is returned and
+//  *pErrorAtPos is set to the position of the error. Once an error has been returned it will be returned again by
+//  any further calls. pErrorAtPos is an OPTIONAL parameter.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 JL_STATUS
-    JlParseJsonEx
+    JlReaderNext
     (
-        char const*     JsonString,
-        bool            IsJson5,
-        JlDataObject**  pRootObject,
-        size_t*         pErrorAtPos
+        JlReader*       Reader,
+        JlToken*        pToken,
+        size_t*         pErrorAtPos         // OPTIONAL
     )
 {
     JL_STATUS jlStatus;
 
-    if(     NULL != JsonString
-        &&  NULL != pRootObject )
+    if(     NULL != Reader
+        &&  NULL != pToken )
     {
-        size_t prevStringIndex = 0;
-        ParseParameters params = { 0 };
-        params.JsonString = JsonString;
-        params.JsonStringLength = strlen( JsonString );
-        params.StringIndex = 0;
-        params.IsJson5 = IsJson5;
-        // Stack is allocated 2 more because we don't use the first element and we need an extra one to contain the last list
-        // or dictionary nest levels items.
-        params.Stack = JlAlloc( sizeof(ParseStack) * (MAX_JSON_DEPTH+2) );
+        ParseParameters* params = &Reader->Parser->Params;
 
-        if( NULL != pErrorAtPos )
+        if( Reader->HavePendingToken )
         {
-            *pErrorAtPos = 0;
+            Reader->HavePendingToken = false;
+            jlStatus = JL_STATUS_SUCCESS;
         }
-
-        if( NULL != params.Stack )
+        else if( JL_STATUS_SUCCESS != Reader->Status )
         {
-            // Setup first item in stack as the "none" type (for whitespace). When this is popped off we
-            // will have finished.
-            params.StackIndex = 0;
-            params.Stack[0].Type = JL_DATA_TYPE_NONE;
-            params.Stack[0].ScanForSubObjects = true;
-
+            jlStatus = Reader->Status;
+        }
+        else if( Reader->Finished )
+        {
+            jlStatus = JL_STATUS_END_OF_DATA;
+        }
+        else
+        {
+            params->Paused = false;
             jlStatus = JL_STATUS_SUCCESS;
-            while( params.StackIndex >= 0  &&  JL_STATUS_SUCCESS == jlStatus )
+            if( params->StackIndex >= 0 )
             {
-                ParseStack* stackItem = &params.Stack[params.StackIndex];
-
-                if( ! stackItem->FinishedProcessing )
-                {
-                    prevStringIndex = params.StringIndex;
-                    if( params.Stack[params.StackIndex].ScanForSubObjects )
-                    {
-                        if( JL_DATA_TYPE_NONE == params.Stack[params.StackIndex].Type )
-                        {
-                            // Note we must mark it finished first because ParseForNewType will adjust StackIndex
-                            stackItem->FinishedProcessing = true;
-                            stackItem->ScanForSubObjects = false;
-                        }
-                        // Turn off scanning for sub objects as we will need to go back to list or dictionary
-                        // processing between objects
-                        stackItem->ScanForSubObjects = false;
-
-                        jlStatus = ParseForNewType( &params, IsJson5, pErrorAtPos );
-                    }
-                    else if( JL_DATA_TYPE_STRING == stackItem->Type )
-                    {
-                        jlStatus = ParseForString( &params, pErrorAtPos );
-                    }
-                    else if( JL_DATA_TYPE_NUMBER == stackItem->Type )
-                    {
-                        jlStatus = ParseForNumber( &params );
-                    }
-                    else if( JL_DATA_TYPE_BOOL == stackItem->Type )
-                    {
-                        jlStatus = ParseForBool( &params );
-                    }
-                    else if( JL_DATA_TYPE_LIST == stackItem->Type )
-                    {
-                        jlStatus = ParseForList( &params, pErrorAtPos );
-                    }
-                    else if( JL_DATA_TYPE_DICTIONARY == stackItem->Type )
-                    {
-                        jlStatus = ParseForDictionary( &params, pErrorAtPos );
-                    }
-
-                }
-                else
-                {
-                    // Attempt to attach this object to previous level (if its a list or dictionary)
-                    jlStatus = AttachStackObjectToPreviousObject( params.Stack, params.StackIndex, pErrorAtPos );
-                    // Finished with this level. So pop off the stack
-                    params.StackIndex -= 1;
-                }
+                jlStatus = RunParser( &Reader->Parser->Params, &Reader->ErrorAtPos );
             }
 
-            if( JL_STATUS_SUCCESS == jlStatus )
+            if(     JL_STATUS_SUCCESS == jlStatus
+                &&  !params->Paused )
             {
-                // Verify that there is nothing but white space after the final object.
-                jlStatus = VerifyOnlyTrailingWhiteSpace( JsonString + params.StringIndex, IsJson5 );
-                if( JL_STATUS_SUCCESS != jlStatus )
+                // Reached the end of the document
+                jlStatus = CompleteDocument( &Reader->Parser->Params, NULL, &Reader->ErrorAtPos );
+                if( JL_STATUS_SUCCESS == jlStatus )
                 {
-                    // At this point we have a full object tree created, but the params are now
-                    // reset. So modify index so it will remove the full tree (at index 1)
-                    params.StackIndex = 1;
-
-                    if( NULL != pErrorAtPos )
-                    {
-                        *pErrorAtPos = params.StringIndex;
-                    }
+                    Reader->Finished = true;
+                    jlStatus = JL_STATUS_END_OF_DATA;
                 }
             }
-
-            if( JL_STATUS_SUCCESS == jlStatus )
+            else if( JL_STATUS_END_OF_DATA == jlStatus )
             {
-                // Get root object (in index position 1)
-                *pRootObject = params.Stack[1].Object;
+                // The input ended part way through the document
+                jlStatus = JL_STATUS_INVALID_DATA;
             }
-            else
+
+            if(     JL_STATUS_SUCCESS != jlStatus
+                &&  JL_STATUS_END_OF_DATA != jlStatus )
             {
-                // Free object tree created so far
-                for( int32_t i=params.StackIndex; i>0; i-- )
-                {
-                    (void) JlFreeObjectTree( &params.Stack[i].Object );
-                    if( NULL != params.Stack[i].CurrentKeyName )
-                    {
-                        JlFree( params.Stack[i].CurrentKeyName );
-                        params.Stack[i].CurrentKeyName = NULL;
-                    }
-                }
+                Reader->Status = jlStatus;
             }
+        }
 
-            JlFree( params.Stack );
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            *pToken = Reader->Token;
+            Reader->LastToken = Reader->Token;
         }
-        else
+        else if(    JL_STATUS_END_OF_DATA != jlStatus
+                &&  NULL != pErrorAtPos )
         {
-            jlStatus = JL_STATUS_OUT_OF_MEMORY;
+            *pErrorAtPos = Reader->ErrorAtPos;
         }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
 
-        if( JL_STATUS_SUCCESS != jlStatus )
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlReaderSkipValue
+//
+//  Skips over the next value, including everything within it if it is a list or dictionary. If the next token is a
+//  key then the key and its value are skipped. If the last token returned by JlReaderNext was the start of a list or
+//  dictionary then the rest of that list or dictionary is skipped, up to and including its end token.
+//  The value is moved over by matching brackets and quotes without unescaping strings or converting numbers, so
+//  nothing within it is checked other than that its strings end and its brackets balance.
+//  Returns JL_STATUS_NOT_FOUND if there is no value to skip because the next token is the end of a list or
+//  dictionary. That token will be the next one returned by JlReaderNext.
+//  pErrorAtPos is an OPTIONAL parameter.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlReaderSkipValue
+    (
+        JlReader*       Reader,
+        size_t*         pErrorAtPos         // OPTIONAL
+    )
+{
+    JL_STATUS jlStatus;
+
+    if( NULL != Reader )
+    {
+        ParseParameters* params = &Reader->Parser->Params;
+        JlToken token;
+
+        if(     !Reader->HavePendingToken
+            &&  !Reader->Finished
+            &&  JL_STATUS_SUCCESS == Reader->Status
+            &&  (   JL_TOKEN_TYPE_BEGIN_DICTIONARY == Reader->LastToken.Type
+                 || JL_TOKEN_TYPE_BEGIN_LIST == Reader->LastToken.Type ) )
+        {
+            // Skip the rest of the list or dictionary that was just started
+            jlStatus = SkipRestOfContainer( Reader );
+            if(     JL_STATUS_SUCCESS != jlStatus
+                &&  NULL != pErrorAtPos )
+            {
+                *pErrorAtPos = Reader->ErrorAtPos;
+            }
+        }
+        else
         {
-            // If optional parameter was provided, then set the position of the error in the string.
-            if(     NULL != pErrorAtPos
-                &&  0 == *pErrorAtPos )
+            // The parse loop moves over the next value with SkipValue and pauses without sending a token for it, so
+            // the token is left as NONE. A key or end token is sent as normal.
+            params->SkipNextValue = true;
+            if( !Reader->HavePendingToken )
+            {
+                Reader->Token.Type = JL_TOKEN_TYPE_NONE;
+            }
+            jlStatus = JlReaderNext( Reader, &token, pErrorAtPos );
+            if(     JL_STATUS_SUCCESS == jlStatus
+                &&  JL_TOKEN_TYPE_KEY == token.Type )
+            {
+                Reader->Token.Type = JL_TOKEN_TYPE_NONE;
+                jlStatus = JlReaderNext( Reader, &token, pErrorAtPos );
+            }
+            params->SkipNextValue = false;
+
+            if(     JL_STATUS_SUCCESS == jlStatus
+                &&  (   JL_TOKEN_TYPE_END_DICTIONARY == token.Type
+                     || JL_TOKEN_TYPE_END_LIST == token.Type ) )
             {
-                *pErrorAtPos = prevStringIndex;
+                // Nothing to skip. Leave the end token to be returned next.
+                Reader->HavePendingToken = true;
+                jlStatus = JL_STATUS_NOT_FOUND;
             }
         }
     }
@@ -0,0 +1,1563 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JsonLib
+//
+//  This module is the parse loop of JlParseJson.c. It is included by JlParseJson.c twice, once to build the strict
+//  JSON parser and once to build the Json5 one. Before each include PARSE_JSON5 is defined as false or true, and
+//  PARSE_FUNCTION( Name ) as the name the functions are given for that version. As PARSE_JSON5 is a constant the
+//  compiler removes all the Json5 checks (comments, extra white space, single quotes, bare words, etc) from the strict
+//  version. This is not a normal header and can only be included from JlParseJson.c, after the types and functions
+//  it uses.
+//
+//  This is free and unencumbered software released into the public domain - November 2019 waterjuice.org
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if !defined( PARSE_JSON5 ) || !defined( PARSE_FUNCTION )
+    #error PARSE_JSON5 and PARSE_FUNCTION must be defined before including JlParseJsonLoop.h
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  FUNCTION NAMES
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define DetectNewType            PARSE_FUNCTION( DetectNewType )
+#define SkipContainer            PARSE_FUNCTION( SkipContainer )
+#define SkipValue                PARSE_FUNCTION( SkipValue )
+#define ParseForNewType          PARSE_FUNCTION( ParseForNewType )
+#define ParseForString           PARSE_FUNCTION( ParseForString )
+#define ParseOutNumberString     PARSE_FUNCTION( ParseOutNumberString )
+#define ParseForNumber           PARSE_FUNCTION( ParseForNumber )
+#define SkipWhiteSpace           PARSE_FUNCTION( SkipWhiteSpace )
+#define IsCompleteWhiteSpace     PARSE_FUNCTION( IsCompleteWhiteSpace )
+#define ParseForList             PARSE_FUNCTION( ParseForList )
+#define ParseForDictionary       PARSE_FUNCTION( ParseForDictionary )
+#define RunParser                PARSE_FUNCTION( RunParser )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PRIVATE FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  DetectNewType
+//
+//  Parses the json string from current position until it reaches a new type.
+//  If IsFinal is false then more input may follow, in which case JL_STATUS_NEED_MORE_DATA is returned if the end of
+//  the string is reached, or if there are not enough characters left to be certain what the next item is.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    DetectNewType
+    (
+        char const*     JsonString,
+        size_t          JsonStringLength,
+        size_t          StringIndex,
+        bool            IsFinal,
+        size_t*         pNewStringIndex,
+        JL_DATA_TYPE*   pNewType,
+        size_t*         pErrorAtPos
+    )
+{
+    JL_STATUS jlStatus;
+    bool inSingleLineComment = false;
+    bool inMultiLineComment = false;
+
+    *pNewStringIndex = StringIndex;
+    *pNewType = JL_DATA_TYPE_NONE;
+
+    jlStatus = IsFinal ? JL_STATUS_END_OF_DATA : JL_STATUS_NEED_MORE_DATA;
+    for( size_t i=StringIndex; i<JsonStringLength; i++ )
+    {
+        JL_DATA_TYPE newType = JL_DATA_TYPE_NONE;
+
+        if( !inSingleLineComment && !inMultiLineComment )
+        {
+            // Move over any run of plain white space in one go.
+            i += JlScanWhiteSpace( JsonString + i, JsonStringLength - i );
+            if( i >= JsonStringLength )
+            {
+                break;
+            }
+        }
+
+        char currentChar = JsonString[i];
+
+        if( !IsFinal && i+2 >= JsonStringLength )
+        {
+            // Can't see the next two characters which may be needed to identify comments, Json5 white space, or
+            // inf and nan. Wait for more input.
+            break;
+        }
+
+        char nextChar = i+1 < JsonStringLength ? JsonString[i+1] : 0;
+        char nextNextChar = i+2 < JsonStringLength ? JsonString[i+2] : 0;
+
+        // See if currently in a comment and if this is the end of comment.
+        if( inSingleLineComment && '\n' == currentChar )
+        {
+            inSingleLineComment = false;
+            continue;
+        }
+        else if( inMultiLineComment && '*' == currentChar && '/' == nextChar )
+        {
+            inMultiLineComment = false;
+            i += 1; // Skip the second character in end of comment marker
+            continue;
+        }
+        else if( inSingleLineComment || inMultiLineComment )
+        {
+            continue;
+        }
+
+        if(     ' '  == currentChar
+            ||  '\n' == currentChar
+            ||  '\r' == currentChar
+            ||  '\t' == currentChar
+            ||  ( '\f' == currentChar && PARSE_JSON5 )
+            ||  ( '\v' == currentChar && PARSE_JSON5 ) )
+        {
+            // Whitespace
+            continue;
+        }
+        else if( PARSE_JSON5 && '\xc2' == currentChar && '\xa0' == nextChar )
+        {
+            // Non-breaking space allowed by json5
+            i += 1;
+            continue;
+        }
+        else if(    PARSE_JSON5
+                 && (   ( '\xe2' == currentChar && '\x80' == nextChar && '\xa8' == nextNextChar )        // Line separator
+                     || ( '\xe2' == currentChar && '\x80' == nextChar && '\xa9' == nextNextChar )        // Paragraph separator
+                     || ( '\xef' == currentChar && '\xbb' == nextChar && '\xbf' == nextNextChar ) ) )    // Byte order mark
+        {
+            // Extra white space allowed by json5
+            i += 2;
+            continue;
+        }
+
+        if( '{' == currentChar )
+        {
+            newType = JL_DATA_TYPE_DICTIONARY;
+        }
+        else if( '[' == currentChar )
+        {
+            newType = JL_DATA_TYPE_LIST;
+        }
+        else if( '\"' == currentChar )
+        {
+            newType = JL_DATA_TYPE_STRING;
+        }
+        else if( PARSE_JSON5 && '\'' == currentChar )
+        {
+            newType = JL_DATA_TYPE_STRING;
+        }
+        else if(    'f' == currentChar
+                 || 't' == currentChar )
+        {
+            newType = JL_DATA_TYPE_BOOL;
+        }
+        else if(    ( currentChar >= '0' && currentChar <= '9' )
+                 || '-' == currentChar
+                 || ( '.' == currentChar && PARSE_JSON5 )
+                 || ( '+' == currentChar && PARSE_JSON5 )
+                 )
+        {
+            newType = JL_DATA_TYPE_NUMBER;
+        }
+        else if(    PARSE_JSON5
+                 && (
+                        ( ( 'i' == currentChar || 'I' == currentChar ) && ( 'n' == nextChar || 'N' == nextChar ) )
+                     || ( ( 'n' == currentChar || 'N' == currentChar ) && ( 'a' == nextChar || 'A' == nextChar ) ) ) )
+        {
+            // Allow for "inf" or "nan" for json5
+            newType = JL_DATA_TYPE_NUMBER;
+        }
+        else if( 'n' == currentChar )
+        {
+            // If NULL type then we will just treat as a string as we have NULL strings. tyle
+            newType = JL_DATA_TYPE_STRING;
+        }
+        else if( PARSE_JSON5 && '/' == currentChar && '/' == nextChar )
+        {
+            // Single line comment
+            i += 1; // Skip the second character in comment marker
+            inSingleLineComment = true;
+            continue;
+        }
+        else if( PARSE_JSON5 && '/' == currentChar && '*' == nextChar )
+        {
+            // Multi line comment
+            i += 1; // Skip the second character in comment marker
+            inMultiLineComment = true;
+            continue;
+        }
+        else
+        {
+            // Unexpected character at this time.
+            jlStatus = JL_STATUS_INVALID_DATA;
+            if( NULL != pErrorAtPos )
+            {
+                *pErrorAtPos = i;
+            }
+        }
+
+        if( JL_DATA_TYPE_NONE != newType )
+        {
+            *pNewStringIndex = i;
+            *pNewType = newType;
+            jlStatus = JL_STATUS_SUCCESS;
+        }
+
+        break;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  SkipContainer
+//
+//  Moves over the list or dictionary whose opening bracket is at Params->StringIndex by matching brackets, stepping
+//  over strings (and Json5 comments) so that brackets within them are ignored. Nothing else is checked, that is left
+//  until the span is parsed. *pSpanLength is set to the length up to and including the closing bracket.
+//  Returns JL_STATUS_END_OF_DATA if the input ends before the closing bracket, or JL_STATUS_INVALID_DATA if it ends
+//  within a string, as a full parse would. Level is the stack level the container would be parsed at. Returns
+//  JL_STATUS_JSON_NESTING_TOO_DEEP if parsing its contents would go deeper than the parse stack allows, so that the
+//  depth limit is the same as when the whole document is parsed.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    SkipContainer
+    (
+        ParseParameters const*  Params,
+        int32_t                 Level,
+        size_t*                 pSpanLength
+    )
+{
+    JL_STATUS jlStatus = JL_STATUS_END_OF_DATA;
+    char const* json = Params->JsonString + Params->StringIndex;
+    size_t jsonLength = Params->JsonStringLength - Params->StringIndex;
+    size_t depth = 0;
+    size_t maxDepth = 0;        // Deepest stack level needed, with the container itself as 1
+
+    for( size_t i=0; i<jsonLength; i++ )
+    {
+        char currentChar = json[i];
+        char nextChar = i+1 < jsonLength ? json[i+1] : 0;
+
+        if( '[' == currentChar || '{' == currentChar )
+        {
+            depth += 1;
+            maxDepth = depth > maxDepth ? depth : maxDepth;
+        }
+        else if( ']' == currentChar || '}' == currentChar )
+        {
+            depth -= 1;
+            if( 0 == depth )
+            {
+                *pSpanLength = i + 1;
+                jlStatus = JL_STATUS_SUCCESS;
+                break;
+            }
+        }
+        else if(    ' ' == currentChar
+                 || '\n' == currentChar
+                 || '\r' == currentChar
+                 || '\t' == currentChar
+                 || ',' == currentChar
+                 || ':' == currentChar )
+        {
+            // Separators
+        }
+        else if( PARSE_JSON5 && '/' == currentChar && '/' == nextChar )
+        {
+            // Single line comment
+            char const* endOfLine = memchr( json+i, '\n', jsonLength-i );
+            i = ( NULL != endOfLine ) ? (size_t)( endOfLine - json ) : jsonLength;
+        }
+        else if( PARSE_JSON5 && '/' == currentChar && '*' == nextChar )
+        {
+            // Multi line comment
+            i += 2;
+            while( i+1 < jsonLength && !( '*' == json[i] && '/' == json[i+1] ) )
+            {
+                i += 1;
+            }
+            i += 1;     // Leave i on the closing slash
+        }
+        else
+        {
+            // Start of a value or key, which sits one level below the current container
+            maxDepth = depth+1 > maxDepth ? depth+1 : maxDepth;
+
+            if( '\"' == currentChar || ( PARSE_JSON5 && '\'' == currentChar ) )
+            {
+                i = FindClosingQuote( json, jsonLength, i );
+                if( i >= jsonLength )
+                {
+                    // String is not terminated
+                    jlStatus = JL_STATUS_INVALID_DATA;
+                }
+            }
+        }
+    }
+
+    if(     JL_STATUS_SUCCESS == jlStatus
+        &&  (size_t)Level + maxDepth - 1 > MAX_JSON_DEPTH + 1 )
+    {
+        jlStatus = JL_STATUS_JSON_NESTING_TOO_DEEP;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  SkipValue
+//
+//  Moves over the value starting at Params->StringIndex without parsing it. Lists and dictionaries are skipped with
+//  SkipContainer and strings up to their closing quote. Numbers, true, false, and null are skipped up to the first
+//  character that can not be part of them, anything wrong after that is found by the parse of the enclosing list or
+//  dictionary. Nothing within the value is checked. *pValueLength is set to the length of the value.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    SkipValue
+    (
+        ParseParameters const*  Params,
+        int32_t                 Level,
+        size_t*                 pValueLength
+    )
+{
+    JL_STATUS jlStatus;
+    char const* json = Params->JsonString + Params->StringIndex;
+    size_t jsonLength = Params->JsonStringLength - Params->StringIndex;
+    char firstChar = json[0];
+
+    if( '[' == firstChar || '{' == firstChar )
+    {
+        jlStatus = SkipContainer( Params, Level, pValueLength );
+    }
+    else if( '\"' == firstChar || '\'' == firstChar )
+    {
+        size_t endQuote = FindClosingQuote( json, jsonLength, 0 );
+        if( endQuote < jsonLength )
+        {
+            *pValueLength = endQuote + 1;
+            jlStatus = JL_STATUS_SUCCESS;
+        }
+        else
+        {
+            // String is not terminated
+            jlStatus = JL_STATUS_INVALID_DATA;
+        }
+    }
+    else
+    {
+        size_t i;
+        for( i=1; i<jsonLength; i++ )
+        {
+            char currentChar = json[i];
+            if( !(      ( currentChar >= '0' && currentChar <= '9' )
+                    ||  ( currentChar >= 'a' && currentChar <= 'z' )
+                    ||  ( currentChar >= 'A' && currentChar <= 'Z' )
+                    ||  '+' == currentChar
+                    ||  '-' == currentChar
+                    ||  '.' == currentChar ) )
+            {
+                break;
+            }
+        }
+        *pValueLength = i;
+        jlStatus = JL_STATUS_SUCCESS;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ParseForNewType
+//
+//  Parses the json string from current position until it reaches a new type, and then adds the new type to the
+//  stack. Returns JL_STATUS_END_OF_DATA if the end of the string is reached. If the type is a list or dictionary the
+//  opening bracket is consumed. When parsing with a projection, values that are not on any of its paths are moved
+//  over with SkipValue and nothing is added to the stack. The same is done for a value being skipped by
+//  JlReaderSkipValue, after which the loop is paused.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    ParseForNewType
+    (
+        ParseParameters*    Params,
+        size_t*             pErrorAtPos
+    )
+{
+    JL_STATUS jlStatus;
+    JL_DATA_TYPE newType = JL_DATA_TYPE_NONE;
+    size_t newStringIndex;
+
+    size_t errorAtPos = 0;
+
+    jlStatus = DetectNewType(
+        Params->JsonString,
+        Params->JsonStringLength,
+        Params->StringIndex,
+        Params->IsFinal,
+        &newStringIndex,
+        &newType,
+        &errorAtPos );
+
+    if( JL_STATUS_INVALID_DATA == jlStatus  &&  NULL != pErrorAtPos )
+    {
+        *pErrorAtPos = Params->BaseOffset + errorAtPos;
+    }
+
+    if( JL_STATUS_SUCCESS == jlStatus  &&  JL_DATA_TYPE_NONE != newType )
+    {
+        uint64_t projectionMask = 0;
+        bool projectionAll = true;
+        bool isWanted = true;
+
+        if( NULL != Params->Projection )
+        {
+            isWanted = MatchProjection( Params, newType, &projectionMask, &projectionAll );
+            Params->Stack[Params->StackIndex].ListIndex += 1;
+        }
+        if( Params->SkipNextValue )
+        {
+            isWanted = false;
+        }
+
+        if( isWanted )
+        {
+            jlStatus = CountNewValue( Params );
+        }
+
+        if( JL_STATUS_SUCCESS != jlStatus )
+        {
+            // Over a limit set with JlParserSetLimits
+            if( NULL != pErrorAtPos )
+            {
+                *pErrorAtPos = Params->BaseOffset + newStringIndex;
+            }
+        }
+        else if( Params->StackIndex > MAX_JSON_DEPTH )
+        {
+            // JSON nesting too deep.
+            jlStatus = JL_STATUS_JSON_NESTING_TOO_DEEP;
+        }
+        else if( !isWanted )
+        {
+            // Not on any projection path, or being skipped by JlReaderSkipValue, so move over it without creating
+            // anything
+            size_t valueLength = 0;
+            Params->StringIndex = newStringIndex;
+            jlStatus = SkipValue( Params, Params->StackIndex + 1, &valueLength );
+            if( JL_STATUS_SUCCESS == jlStatus )
+            {
+                Params->StringIndex += valueLength;
+                ReleaseKeyName( &Params->Stack[Params->StackIndex] );
+                if( Params->SkipNextValue )
+                {
+                    // Stop here so that JlReaderSkipValue can return
+                    Params->SkipNextValue = false;
+                    Params->Paused = true;
+                }
+            }
+            else if(    JL_STATUS_JSON_NESTING_TOO_DEEP != jlStatus
+                     && NULL != pErrorAtPos )
+            {
+                // Ran out of input
+                *pErrorAtPos = Params->BaseOffset + Params->JsonStringLength;
+            }
+        }
+        else
+        {
+            Params->StringIndex = newStringIndex;
+            Params->StackIndex += 1;
+            ParseStack* stackItem = &Params->Stack[Params->StackIndex];
+            memset( stackItem, 0, sizeof(*stackItem) );
+
+            stackItem->Type = newType;
+            stackItem->ProjectionMask = projectionMask;
+            stackItem->ProjectionAll = projectionAll;
+            if( NULL == Params->Callbacks )
+            {
+                jlStatus = JlCreateObjectWithTag( newType, Params->BaseOffset + Params->StringIndex, &stackItem->Object );
+            }
+
+            if(     Params->Lazy
+                &&  projectionAll
+                &&  Params->StackIndex >= 2
+                &&  ( JL_DATA_TYPE_LIST == newType || JL_DATA_TYPE_DICTIONARY == newType )
+                &&  JL_STATUS_SUCCESS == jlStatus )
+            {
+                // Record where the list or dictionary is and move over it. It is parsed the first time it is used.
+                size_t spanLength = 0;
+                jlStatus = SkipContainer( Params, Params->StackIndex, &spanLength );
+                if( JL_STATUS_SUCCESS == jlStatus )
+                {
+                    jlStatus = JlSetObjectLazySpan(
+                        stackItem->Object, Params->JsonString + Params->StringIndex, spanLength, PARSE_JSON5 );
+                    Params->StringIndex += spanLength;
+                    stackItem->FinishedProcessing = true;
+                }
+                else if(    JL_STATUS_JSON_NESTING_TOO_DEEP != jlStatus
+                         && NULL != pErrorAtPos )
+                {
+                    // Ran out of input
+                    *pErrorAtPos = Params->BaseOffset + Params->JsonStringLength;
+                }
+            }
+            else if( JL_DATA_TYPE_LIST == newType )
+            {
+                if(     NULL != Params->Callbacks
+                    &&  NULL != Params->Callbacks->OnBeginList )
+                {
+                    jlStatus = Params->Callbacks->OnBeginList( Params->CallbackContext, Params->BaseOffset + Params->StringIndex );
+                }
+                // Skip past opening square bracket
+                Params->StringIndex += 1;
+            }
+            else if( JL_DATA_TYPE_DICTIONARY == newType )
+            {
+                if(     NULL != Params->Callbacks
+                    &&  NULL != Params->Callbacks->OnBeginDictionary )
+                {
+                    jlStatus = Params->Callbacks->OnBeginDictionary( Params->CallbackContext, Params->BaseOffset + Params->StringIndex );
+                }
+                // Skip past opening curly bracket
+                Params->StringIndex += 1;
+                stackItem->DictionaryScanState = DICT_SCAN_STATE_NEED_KEY;
+            }
+        }
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ParseForString
+//
+//  Parses the Json string at current position as a string (after the first double quotes)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    ParseForString
+    (
+        ParseParameters*    Params,
+        size_t*             pErrorAtPos
+    )
+{
+    JL_STATUS jlStatus;
+    char* processedString = NULL;
+    char const* stringStart = Params->JsonString + Params->StringIndex;
+    size_t maxStringLen = Params->JsonStringLength - Params->StringIndex;
+    size_t actualStringLen = 0;
+    size_t processedLength = 0;
+    size_t offset = Params->BaseOffset + Params->StringIndex;
+
+    // Check if this is a json null
+    jlStatus = JL_STATUS_NOT_FOUND;
+    if( maxStringLen < 4 && !Params->IsFinal )
+    {
+        jlStatus = JL_STATUS_NEED_MORE_DATA;
+    }
+    else if( maxStringLen >= 4 )
+    {
+        if( memcmp( stringStart, "null", 4 ) == 0 )
+        {
+            // We already have a string object created, so just leave it and it will be left as NULL.
+            Params->Stack[Params->StackIndex].FinishedProcessing = true;
+            Params->StringIndex += 4;
+            jlStatus = JL_STATUS_SUCCESS;
+
+            if(     NULL != Params->Callbacks
+                &&  NULL != Params->Callbacks->OnNull )
+            {
+                jlStatus = Params->Callbacks->OnNull( Params->CallbackContext, offset );
+            }
+        }
+    }
+
+    if( JL_STATUS_NOT_FOUND == jlStatus )
+    {
+        // Now treat as a normal string. When building a tree the string is allocated at its final size and given to
+        // the string object, otherwise it is only needed until the callback returns. Raw strings are only checked
+        // here, and are unescaped when they are first read.
+        bool keepRaw = Params->RawStrings && NULL == Params->Callbacks && NULL == Params->InSituBuffer;
+        jlStatus = ParseString(
+            Params,
+            false,
+            PARSE_JSON5,
+            ( NULL != Params->Callbacks ) ? &Params->StringBuffer : NULL,
+            &actualStringLen,
+            ( Params->ValidateOnly || keepRaw ) ? NULL : &processedString,
+            &processedLength );
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            Params->StringIndex += actualStringLen;
+            Params->Stack[Params->StackIndex].FinishedProcessing = true;
+
+            if( keepRaw )
+            {
+                // Empty strings are not stored, so the object is left as it is
+                if( processedLength > 0 )
+                {
+                    JlDataObject* stringObject = Params->Stack[Params->StackIndex].Object;
+                    bool hasEscapes = NULL != memchr( stringStart + 1, '\\', actualStringLen - 2 );
+                    jlStatus = JlSetObjectStringSpan(
+                        stringObject, stringStart, actualStringLen, PARSE_JSON5, hasEscapes );
+                }
+            }
+            else if( NULL != Params->Callbacks )
+            {
+                if( NULL != Params->Callbacks->OnString )
+                {
+                    jlStatus = Params->Callbacks->OnString( Params->CallbackContext, processedString, processedLength, offset );
+                }
+            }
+            else if( IsStringInSitu( Params, processedString ) )
+            {
+                // Set string in object (was already setup as a string object). It stays in the caller's buffer.
+                jlStatus = JlSetObjectStringReference( Params->Stack[Params->StackIndex].Object, processedString );
+                processedString = NULL;
+            }
+            else
+            {
+                // Set string in object (was already setup as a string object)
+                jlStatus = JlSetObjectStringTakeOwnership( Params->Stack[Params->StackIndex].Object, processedString );
+                if( JL_STATUS_SUCCESS != jlStatus )
+                {
+                    JlFree( processedString );
+                }
+                processedString = NULL;
+            }
+        }
+        else
+        {
+            if( actualStringLen > 0 )
+            {
+                // If an error occured in the middle of the string, this will be set to where the error happened.
+                if( NULL != pErrorAtPos )
+                {
+                    *pErrorAtPos = Params->BaseOffset + Params->StringIndex + actualStringLen;
+                }
+            }
+        }
+    }
+
+    if(     JL_STATUS_SUCCESS != jlStatus
+        &&  JL_STATUS_NEED_MORE_DATA != jlStatus )
+    {
+        (void) JlFreeObjectTree( &Params->Stack[Params->StackIndex].Object );
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ParseOutNumberString
+//
+//  Parses the String as a number type in json. This will return a string containing just the number, written into
+//  OutputBuffer. *pProcessedLength is set to the length of the returned string. If OutputBuffer is NULL then
+//  *pProcessedString points to the number within String instead, and is not zero terminated.
+//  *pAmountProcessed will be set with the amount of the string consumed by the parse function (including end quote).
+//  If IsFinal is false then more input may follow String, so JL_STATUS_NEED_MORE_DATA is returned if the number
+//  runs to the end of String.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    ParseOutNumberString
+    (
+        char const*         String,
+        size_t              StringLength,
+        bool                IsFinal,
+        ScratchBuffer*      OutputBuffer,       // OPTIONAL
+        size_t*             pAmountProcessed,
+        char const**        pProcessedString,
+        size_t*             pProcessedLength
+    )
+{
+    JL_STATUS jlStatus;
+    size_t strLength = 0;
+    size_t strEndPos = 0;
+    size_t numSkippedChars = 0;
+    char* processedString = NULL;
+    bool hexMode = false;
+    bool isSpecial = false;
+
+    jlStatus = JL_STATUS_SUCCESS;
+
+    if(     PARSE_JSON5
+        &&  !IsFinal
+        &&  (   ( String[0] < '0' || String[0] > '9' )
+             && '-' != String[0]
+             && '+' != String[0]
+             && '.' != String[0] ) )
+    {
+        // inf and nan are only accepted when they are the entire remaining input, so can only be decided once all
+        // the input is available.
+        jlStatus = JL_STATUS_NEED_MORE_DATA;
+    }
+    else if(    PARSE_JSON5
+             && !IsFinal
+             && StringLength < 4 )
+    {
+        // Could be +inf or -inf
+        jlStatus = JL_STATUS_NEED_MORE_DATA;
+    }
+    else if(    PARSE_JSON5
+             && !IsFinal
+             && ( '+' == String[0] || '-' == String[0] )
+             && ( 'i' == String[1] || 'I' == String[1] ) )
+    {
+        jlStatus = JL_STATUS_NEED_MORE_DATA;
+    }
+    else if( PARSE_JSON5 )
+    {
+        // Check if inf or nan
+        if( StringLength >= 4 )
+        {
+            if(     strncasecmp( String, "+inf", 4 ) == 0
+                ||  strncasecmp( String, "-inf", 4 ) == 0 )
+            {
+                strLength = 4;
+                isSpecial = true;
+            }
+        }
+        else if( StringLength >= 3 )
+        {
+            if(     strncasecmp( String, "inf", 3 ) == 0
+                ||  strncasecmp( String, "nan", 3 ) == 0 )
+            {
+                strLength = 3;
+                isSpecial = true;
+            }
+        }
+    }
+
+    // Find end of number
+    if( !isSpecial && JL_STATUS_SUCCESS == jlStatus )
+    {
+        jlStatus = IsFinal ? JL_STATUS_SUCCESS : JL_STATUS_NEED_MORE_DATA;
+        for( size_t i=0; i<StringLength; i++ )
+        {
+            if( !IsFinal && i+2 >= StringLength )
+            {
+                // Can't be sure the number has ended
+                break;
+            }
+            else if(    ( String[i] >= '0' && String[i] <= '9' )
+                ||  '-' == String[i]
+                ||  '.' == String[i]
+                ||  'E' == String[i]
+                ||  'e' == String[i]
+                ||  '+' == String[i] )
+            {
+                strEndPos = i;
+            }
+            else if(    ' ' == String[i]
+                     || '\r' == String[i]
+                     || '\n' == String[i]
+                     || '\t' == String[i]
+                     || ( '\v' == String[i] && PARSE_JSON5 )
+                     || ( '\f' == String[i] && PARSE_JSON5 )
+                     || ',' == String[i]
+                     || '}' == String[i]
+                     || ']' == String[i]
+                     || ( PARSE_JSON5 && i+1 < StringLength && '\xc2' == String[i] && '\xa0' == String[i+1] )
+                     || ( PARSE_JSON5 && i+2 < StringLength && '\xe2' == String[i] && '\x80' == String[i+1] && '\xa8' == String[i+2] )
+                     || ( PARSE_JSON5 && i+2 < StringLength && '\xe2' == String[i] && '\x80' == String[i+1] && '\xa9' == String[i+2] )
+                     || ( PARSE_JSON5 && i+2 < StringLength && '\xef' == String[i] && '\xbb' == String[i+1] && '\xbf' == String[i+2] ) )
+            {
+                // Valid character that can follow a number element.
+                jlStatus = JL_STATUS_SUCCESS;
+                break;
+            }
+            else if(    PARSE_JSON5
+                     && '/' == String[i] )
+            {
+                // Start of comment
+                jlStatus = JL_STATUS_SUCCESS;
+                break;
+            }
+            else if(    PARSE_JSON5
+                     && 1 == i
+                     && '0' == String[0]
+                     && ( 'x' == String[1] || 'X' == String[1] ) )
+            {
+                hexMode = true;
+                strEndPos = i;
+            }
+            else if(    hexMode
+                     && (   ( String[i] >= 'a' && String[i] <= 'f' )
+                         || ( String[i] >= 'A' && String[i] <= 'F' ) ) )
+            {
+                strEndPos = i;
+            }
+            else
+            {
+                // Invalid character
+                jlStatus = JL_STATUS_INVALID_DATA;
+                break;
+            }
+        }
+    }
+
+    if( JL_STATUS_NEED_MORE_DATA == jlStatus )
+    {
+        // The number may continue in the next part of the input
+    }
+    else if( hexMode && 1 == strEndPos )
+    {
+        // Its an invalid string to only be 0x with nothing following.
+        jlStatus = JL_STATUS_INVALID_DATA;
+    }
+    else if( hexMode && strEndPos > 17 )
+    {
+        // Its too long for a 64 bit hex number which is the largest that can be handled.
+        jlStatus = JL_STATUS_INVALID_DATA;
+    }
+
+    if( JL_STATUS_SUCCESS == jlStatus && !PARSE_JSON5 )
+    {
+        // Don't allow trailing decimal point (unless Json5)
+        if( '.' == String[strEndPos] )
+        {
+            jlStatus = JL_STATUS_INVALID_DATA;
+        }
+    }
+
+    if( JL_STATUS_SUCCESS == jlStatus && !isSpecial )
+    {
+        // Now verify that it is a valid number
+        bool minusAllowed = true;
+        bool plusAllowed = PARSE_JSON5;      // Json5 allows a leading point
+        bool eAllowed = false;
+        bool pointAllowed = PARSE_JSON5;      // Json5 allows a leading point
+
+        bool hadPoint = false;
+        bool hadE = false;
+
+        strLength = strEndPos + 1;
+        jlStatus = JL_STATUS_SUCCESS;
+
+        for( size_t i=0; i<strLength; i++ )
+        {
+            if( hexMode )
+            {
+                if(     i < 2
+                    ||  ( String[i] >= '0' && String[i] <= '9' )
+                    ||  ( String[i] >= 'a' && String[i] <= 'f' )
+                    ||  ( String[i] >= 'A' && String[i] <= 'F' ) )
+                {
+                    strEndPos = i;
+                }
+                else
+                {
+                    jlStatus = JL_STATUS_INVALID_DATA;
+                    break;
+                }
+            }
+            else if(    ( String[i] >= '0' && String[i] <= '9' )
+                    ||  ( '-' == String[i] && minusAllowed )
+                    ||  ( '.' == String[i] && pointAllowed )
+                    ||  ( 'E' == String[i] && eAllowed )
+                    ||  ( 'e' == String[i] && eAllowed )
+                    ||  ( '+' == String[i] && plusAllowed ) )
+            {
+                strEndPos = i;
+
+                if( !hadPoint && !hadE )
+                {
+                    pointAllowed = true;
+                }
+                if( !hadE )
+                {
+                    eAllowed = true;
+                }
+
+                if( 'e' == String[i] || 'E' == String[i] )
+                {
+                    minusAllowed = true;
+                    plusAllowed = true;
+                    pointAllowed = false;
+                    eAllowed = false;
+                    hadE = true;
+                }
+                else if( '.' == String[i] )
+                {
+                    hadPoint = true;
+                    pointAllowed = false;
+                    eAllowed = false;       // can't have E straight after decimal point
+                }
+                else
+                {
+                    minusAllowed = false;
+                    plusAllowed = false;
+                }
+            }
+            else
+            {
+                jlStatus = JL_STATUS_INVALID_DATA;
+                break;
+            }
+        }
+    }
+
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        char const* stringPtr = String;
+
+        if( PARSE_JSON5 && '+' == stringPtr[0] )
+        {
+            // Skip leading '+' allowed by Json5
+            stringPtr += 1;
+            strLength -= 1;
+            numSkippedChars += 1;
+        }
+
+        if( NULL == OutputBuffer )
+        {
+            // Number is left where it is
+            *pProcessedString = stringPtr;
+            *pProcessedLength = strLength;
+            *pAmountProcessed = strLength + numSkippedChars;
+        }
+        else
+        {
+            // Copy out number string into the scratch buffer
+            jlStatus = ReserveScratchBuffer( OutputBuffer, strLength + 1 );
+            if( JL_STATUS_SUCCESS == jlStatus )
+            {
+                processedString = OutputBuffer->Buffer;
+                memcpy( processedString, stringPtr, strLength );
+                processedString[strLength] = 0;
+                *pProcessedString = processedString;
+                *pProcessedLength = strLength;
+                *pAmountProcessed = strLength + numSkippedChars;
+            }
+        }
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ParseForNumber
+//
+//  Parses the Json string at current position as a number
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    ParseForNumber
+    (
+        ParseParameters*    Params
+    )
+{
+    JL_STATUS jlStatus;
+    char const* processedString = NULL;
+    char const* stringStart = Params->JsonString + Params->StringIndex;
+    size_t maxStringLen = Params->JsonStringLength - Params->StringIndex;
+    size_t actualStringLen = 0;
+    size_t processedLength = 0;
+    size_t offset = Params->BaseOffset + Params->StringIndex;
+
+    jlStatus = ParseOutNumberString(
+        stringStart, maxStringLen, Params->IsFinal,
+        Params->ValidateOnly ? NULL : &Params->NumberBuffer, &actualStringLen, &processedString, &processedLength );
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        Params->StringIndex += actualStringLen;
+        Params->Stack[Params->StackIndex].FinishedProcessing = true;
+
+        if(     Params->ValidateOnly
+            ||  NULL != Params->Callbacks )
+        {
+            // Check the number would be accepted when set into a number object, as ParseOutNumberString lets through
+            // text such as "-" or "1e" that is only rejected when converted.
+            if( !IsNumberInRange( processedString, processedLength ) )
+            {
+                JlNumber number;
+                jlStatus = JlNumberStringToNumber( processedString, processedLength, &number );
+            }
+            if(     JL_STATUS_SUCCESS == jlStatus
+                &&  NULL != Params->Callbacks
+                &&  NULL != Params->Callbacks->OnNumber )
+            {
+                jlStatus = Params->Callbacks->OnNumber( Params->CallbackContext, processedString, processedLength, offset );
+            }
+        }
+        else if(    Params->RawNumbers
+                 && IsNumberInRange( processedString, processedLength )
+                 && IsRawNumberText( stringStart, processedLength ) )
+        {
+            // Keep the text from the input, it is converted when the value is first read
+            jlStatus = JlSetObjectNumberText( Params->Stack[Params->StackIndex].Object, stringStart, processedLength );
+        }
+        else
+        {
+            // Set number in object (was already setup as a number object)
+            jlStatus = JlSetObjectNumberString( Params->Stack[Params->StackIndex].Object, processedString );
+        }
+    }
+
+    if(     JL_STATUS_SUCCESS != jlStatus
+        &&  JL_STATUS_NEED_MORE_DATA != jlStatus )
+    {
+        (void) JlFreeObjectTree( &Params->Stack[Params->StackIndex].Object );
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  SkipWhiteSpace
+//
+//  Fast forwards the StringIndex in Params until reaches the next none whitespace character. Returns character.
+//  Returns JL_STATUS_NEED_MORE_DATA if more input may follow and the end was reached.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    SkipWhiteSpace
+    (
+        ParseParameters*    Params,
+        char*               pNextChar
+    )
+{
+    JL_STATUS jlStatus;
+    bool inSingleLineComment = false;
+    bool inMultiLineComment = false;
+
+    jlStatus = Params->IsFinal ? JL_STATUS_END_OF_DATA : JL_STATUS_NEED_MORE_DATA;
+    while( Params->StringIndex < Params->JsonStringLength )
+    {
+        if( !inSingleLineComment && !inMultiLineComment )
+        {
+            // Move over any run of plain white space in one go.
+            Params->StringIndex += JlScanWhiteSpace(
+                Params->JsonString + Params->StringIndex,
+                Params->JsonStringLength - Params->StringIndex );
+            if( Params->StringIndex >= Params->JsonStringLength )
+            {
+                break;
+            }
+        }
+
+        size_t remaining = Params->JsonStringLength - Params->StringIndex;
+        char currentChar = Params->JsonString[Params->StringIndex];
+        char nextChar = remaining > 1 ? Params->JsonString[Params->StringIndex+1] : 0;
+        char nextNextChar = remaining > 2 ? Params->JsonString[Params->StringIndex+2] : 0;
+
+        if( !Params->IsFinal && remaining < 3 )
+        {
+            // Not enough look ahead to identify comments or Json5 white space. Wait for more input.
+            break;
+        }
+
+        // See if currently in a comment and if this is the end of comment.
+        if( inSingleLineComment && '\n' == currentChar )
+        {
+            inSingleLineComment = false;
+        }
+        else if( inMultiLineComment && '*' == currentChar && '/' == nextChar )
+        {
+            inMultiLineComment = false;
+            Params->StringIndex  += 1;      // Skip the extra char (the '/')
+        }
+        else if( inSingleLineComment || inMultiLineComment )
+        {
+            // In comment, so ignore
+        }
+        else if(     ' '  == currentChar
+            ||  '\n' == currentChar
+            ||  '\r' == currentChar
+            ||  '\t' == currentChar
+            ||  ( '\v' == currentChar && PARSE_JSON5 )
+            ||  ( '\f' == currentChar && PARSE_JSON5 ) )
+        {
+            // White space, so ignore
+        }
+        else if( PARSE_JSON5 && '\xc2' == currentChar && '\xa0' == nextChar )
+        {
+            // Non-breaking space allowed by json5
+            Params->StringIndex += 1;
+        }
+        else if(    PARSE_JSON5
+                 && (   ( '\xe2' == currentChar && '\x80' == nextChar && '\xa8' == nextNextChar )        // Line separator
+                     || ( '\xe2' == currentChar && '\x80' == nextChar && '\xa9' == nextNextChar )        // Paragraph separator
+                     || ( '\xef' == currentChar && '\xbb' == nextChar && '\xbf' == nextNextChar ) ) )    // Byte order mark
+        {
+            // Extra white space allowed by json5
+            Params->StringIndex += 2;
+        }
+        else if( PARSE_JSON5 && '/' == currentChar && '/' == nextChar )
+        {
+            inSingleLineComment = true;
+            Params->StringIndex += 1;
+        }
+        else if( PARSE_JSON5 && '/' == currentChar && '*' == nextChar )
+        {
+            inMultiLineComment = true;
+            Params->StringIndex += 1;
+        }
+        else
+        {
+            // First non whitespace/comment
+            *pNextChar = currentChar;
+            jlStatus = JL_STATUS_SUCCESS;
+            break;
+        }
+
+        Params->StringIndex += 1;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  IsCompleteWhiteSpace
+//
+//  Returns true if String is all plain white space and, for Json5, comments that end within it. Used at the end of a
+//  list slice, where a comment that is still open at the end means the comma after it was inside the comment.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+bool
+    IsCompleteWhiteSpace
+    (
+        char const*     String,
+        size_t          StringLength
+    )
+{
+    size_t index = JlScanWhiteSpace( String, StringLength );
+    bool isComplete = true;
+
+    while( isComplete && index < StringLength )
+    {
+        char const* commentEnd = NULL;
+
+        if( PARSE_JSON5 && index + 1 < StringLength && '/' == String[index] && '/' == String[index+1] )
+        {
+            commentEnd = memchr( String + index + 2, '\n', StringLength - index - 2 );
+        }
+        else if( PARSE_JSON5 && index + 1 < StringLength && '/' == String[index] && '*' == String[index+1] )
+        {
+            for( size_t i=index+2; NULL == commentEnd && i+1 < StringLength; i++ )
+            {
+                if( '*' == String[i] && '/' == String[i+1] )
+                {
+                    commentEnd = String + i + 1;
+                }
+            }
+        }
+
+        if( NULL != commentEnd )
+        {
+            index = (size_t)( commentEnd - String ) + 1;
+            index += JlScanWhiteSpace( String + index, StringLength - index );
+        }
+        else
+        {
+            isComplete = false;
+        }
+    }
+
+    return isComplete;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ParseForList
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    ParseForList
+    (
+        ParseParameters*    Params,
+        size_t*             pErrorAtPos     // OPTIONAL
+    )
+{
+    JL_STATUS jlStatus;
+    ParseStack* currentStack = &Params->Stack[Params->StackIndex];
+    size_t valueEndIndex = Params->StringIndex;
+    char nextChar;
+
+    jlStatus = SkipWhiteSpace( Params, &nextChar );
+    if(     JL_STATUS_END_OF_DATA == jlStatus
+        &&  Params->ListSliceEndsAtComma
+        &&  1 == Params->StackIndex
+        &&  currentStack->ProcessedFirstItem
+        &&  !currentStack->PrevScanComma
+        &&  IsCompleteWhiteSpace(
+                Params->JsonString + valueEndIndex, Params->JsonStringLength - valueEndIndex ) )
+    {
+        // The slice ends at the comma after this element
+        currentStack->FinishedProcessing = true;
+        jlStatus = JL_STATUS_SUCCESS;
+    }
+    else if(    JL_STATUS_SUCCESS == jlStatus
+             && ']' == nextChar
+             && Params->ListSliceEndsAtComma
+             && 1 == Params->StackIndex )
+    {
+        // The root list can not end before the comma that ends the slice
+        jlStatus = JL_STATUS_INVALID_DATA;
+    }
+    else if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        if( !currentStack->PrevScanComma )
+        {
+            if( ']' == nextChar )
+            {
+                // End of array
+                jlStatus = SendEndEvent( Params, Params->Callbacks ? Params->Callbacks->OnEndList : NULL );
+                currentStack->FinishedProcessing = true;
+                Params->StringIndex += 1;
+            }
+            else if( ',' == nextChar )
+            {
+                if( ! currentStack->ProcessedFirstItem )
+                {
+                    // Should not be a comma before first item
+                    jlStatus = JL_STATUS_INVALID_DATA;
+                }
+                else
+                {
+                    Params->StringIndex += 1;
+                    currentStack->PrevScanComma = true;
+                }
+            }
+            else
+            {
+                if( currentStack->ProcessedFirstItem )
+                {
+                    // After first item we need to have a comma or a end bracket after
+                    // the data.
+                    jlStatus = JL_STATUS_INVALID_DATA;
+                }
+                else
+                {
+                    currentStack->ScanForSubObjects = true;
+                }
+            }
+        }
+        else
+        {
+            // If in last scan we had a comma then we must not have a comma again or an end bracket unless
+            // its Json5
+            if(     ',' == nextChar
+                ||  ( ']' == nextChar && !PARSE_JSON5 ) )
+            {
+                jlStatus = JL_STATUS_INVALID_DATA;
+            }
+            else if( ']' == nextChar && PARSE_JSON5 )
+            {
+                // Allowed an end bracket after a trailing comma in Json5
+                jlStatus = SendEndEvent( Params, Params->Callbacks ? Params->Callbacks->OnEndList : NULL );
+                currentStack->FinishedProcessing = true;
+                Params->StringIndex += 1;
+            }
+            else
+            {
+                currentStack->ScanForSubObjects = true;
+                currentStack->PrevScanComma = false;
+            }
+        }
+
+        currentStack->ProcessedFirstItem = true;
+    }
+
+    if(     JL_STATUS_SUCCESS != jlStatus
+        &&  JL_STATUS_NEED_MORE_DATA != jlStatus
+        &&  NULL != pErrorAtPos
+        &&  0 == *pErrorAtPos )
+    {
+        *pErrorAtPos = Params->BaseOffset + Params->StringIndex;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ParseForDictionary
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    ParseForDictionary
+    (
+        ParseParameters*    Params,
+        size_t*             pErrorAtPos     // OPTIONAL
+    )
+{
+    JL_STATUS jlStatus;
+    ParseStack* currentStack = &Params->Stack[Params->StackIndex];
+    char nextChar;
+
+    jlStatus = SkipWhiteSpace( Params, &nextChar );
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        if( DICT_SCAN_STATE_NEED_KEY == currentStack->DictionaryScanState )
+        {
+            if(     '\"' == nextChar
+                ||  ( PARSE_JSON5 && '\'' == nextChar ) )
+            {
+                // Read key
+                jlStatus = ParseKeyName( Params, false );
+                if( JL_STATUS_SUCCESS == jlStatus )
+                {
+                    currentStack->DictionaryScanState = DICT_SCAN_STATE_NEED_COLON;
+                }
+            }
+            else if( PARSE_JSON5 &&
+                     (      '_' == nextChar
+                       ||   '$' == nextChar
+                       ||   ( nextChar >= 'a' && nextChar <= 'z' )
+                       ||   ( nextChar >= 'A' && nextChar <= 'Z' )
+                       ) )
+            {
+                // Json5 bareword key
+                jlStatus = ParseKeyName( Params, true );
+                if( JL_STATUS_SUCCESS == jlStatus )
+                {
+                    currentStack->DictionaryScanState = DICT_SCAN_STATE_NEED_COLON;
+                }
+            }
+            else if( '}' == nextChar && ( !currentStack->ProcessedFirstItem || PARSE_JSON5 ) )
+            {
+                // This means an empty dictionary or, in Json5, there was a trailing comma
+                jlStatus = SendEndEvent( Params, Params->Callbacks ? Params->Callbacks->OnEndDictionary : NULL );
+                currentStack->FinishedProcessing = true;
+                currentStack->DictionaryScanState = DICT_SCAN_STATE_NONE;
+                Params->StringIndex += 1;   // Move past end curly bracket
+            }
+            else
+            {
+                jlStatus = JL_STATUS_INVALID_DATA;
+            }
+        }
+        else if( DICT_SCAN_STATE_NEED_COLON == currentStack->DictionaryScanState )
+        {
+            if( ':' == nextChar )
+            {
+                currentStack->DictionaryScanState = DICT_SCAN_STATE_NEED_VALUE;
+                currentStack->ScanForSubObjects = true;
+                Params->StringIndex += 1;   // Move past colon
+            }
+            else
+            {
+                jlStatus = JL_STATUS_INVALID_DATA;
+            }
+        }
+        else if( DICT_SCAN_STATE_NEED_VALUE == currentStack->DictionaryScanState )
+        {
+            // We will have added object already because ScanForSubObjects was set and
+            // value processed in main loop. So we just need to skip on to the next state
+            currentStack->DictionaryScanState = DICT_SCAN_STATE_NEED_COMMA_OR_END;
+            currentStack->ScanForSubObjects = false;
+        }
+        else if( DICT_SCAN_STATE_NEED_COMMA_OR_END == currentStack->DictionaryScanState )
+        {
+            if( ',' == nextChar )
+            {
+                // Set back to scanning for a new keyname
+                currentStack->DictionaryScanState = DICT_SCAN_STATE_NEED_KEY;
+                Params->StringIndex += 1;   // Move past comma
+            }
+            else if( '}' == nextChar )
+            {
+                // End dictionary
+                jlStatus = SendEndEvent( Params, Params->Callbacks ? Params->Callbacks->OnEndDictionary : NULL );
+                currentStack->FinishedProcessing = true;
+                currentStack->DictionaryScanState = DICT_SCAN_STATE_NONE;
+                Params->StringIndex += 1;   // Move past end curly bracket
+            }
+            else
+            {
+                jlStatus = JL_STATUS_INVALID_DATA;
+            }
+        }
+
+        if( JL_STATUS_NEED_MORE_DATA == jlStatus )
+        {
+            // Key name was incomplete, it will be parsed again when there is more input.
+        }
+        else
+        {
+            if( JL_STATUS_SUCCESS != jlStatus )
+            {
+                ReleaseKeyName( currentStack );
+            }
+
+            currentStack->ProcessedFirstItem = true;
+
+            if(     JL_STATUS_SUCCESS != jlStatus
+                &&  NULL != pErrorAtPos
+                &&  0 == *pErrorAtPos )
+            {
+                *pErrorAtPos = Params->BaseOffset + Params->StringIndex;
+            }
+        }
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  RunParser
+//
+//  Runs the parse loop over Params from the current position until the document is complete or an error
+//  occurs. If Params->IsFinal is false and a token runs into the end of the input then JL_STATUS_NEED_MORE_DATA is
+//  returned with Params->StringIndex left at the start of that token. Everything before it has been consumed and the
+//  stack holds the state needed to carry on once more input is available.
+//  The loop also stops, returning JL_STATUS_SUCCESS, once Params->StringIndex reaches Params->StopAtIndex. It can be
+//  run again to carry on from there.
+//  On any other error the partially built tree is freed.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    RunParser
+    (
+        ParseParameters*    Params,
+        size_t*             pErrorAtPos
+    )
+{
+    JL_STATUS jlStatus;
+    size_t prevStringIndex = 0;
+
+    if( NULL != pErrorAtPos )
+    {
+        *pErrorAtPos = 0;
+    }
+
+    jlStatus = JL_STATUS_SUCCESS;
+    while(      Params->StackIndex >= 0
+            &&  JL_STATUS_SUCCESS == jlStatus
+            &&  !Params->Paused
+            &&  Params->StringIndex < Params->StopAtIndex )
+    {
+        ParseStack* stackItem = &Params->Stack[Params->StackIndex];
+
+        if( ! stackItem->FinishedProcessing )
+        {
+            prevStringIndex = Params->StringIndex;
+            if( stackItem->ScanForSubObjects )
+            {
+                if( JL_DATA_TYPE_NONE == stackItem->Type )
+                {
+                    // Note we must mark it finished first because ParseForNewType will adjust StackIndex
+                    stackItem->FinishedProcessing = true;
+                }
+                // Turn off scanning for sub objects as we will need to go back to list or dictionary
+                // processing between objects
+                stackItem->ScanForSubObjects = false;
+
+                jlStatus = ParseForNewType( Params, pErrorAtPos );
+                if( JL_STATUS_NEED_MORE_DATA == jlStatus )
+                {
+                    // Put back the state so this step is repeated when there is more input
+                    stackItem->ScanForSubObjects = true;
+                    if( JL_DATA_TYPE_NONE == stackItem->Type )
+                    {
+                        stackItem->FinishedProcessing = false;
+                    }
+                }
+            }
+            else if( JL_DATA_TYPE_STRING == stackItem->Type )
+            {
+                jlStatus = ParseForString( Params, pErrorAtPos );
+            }
+            else if( JL_DATA_TYPE_NUMBER == stackItem->Type )
+            {
+                jlStatus = ParseForNumber( Params );
+            }
+            else if( JL_DATA_TYPE_BOOL == stackItem->Type )
+            {
+                jlStatus = ParseForBool( Params );
+            }
+            else if( JL_DATA_TYPE_LIST == stackItem->Type )
+            {
+                jlStatus = ParseForList( Params, pErrorAtPos );
+            }
+            else if( JL_DATA_TYPE_DICTIONARY == stackItem->Type )
+            {
+                jlStatus = ParseForDictionary( Params, pErrorAtPos );
+            }
+
+            if( JL_STATUS_NEED_MORE_DATA == jlStatus )
+            {
+                // Rewind to the start of the incomplete token
+                Params->StringIndex = prevStringIndex;
+            }
+        }
+        else
+        {
+            if( NULL == Params->Callbacks )
+            {
+                // Attempt to attach this object to previous level (if its a list or dictionary)
+                jlStatus = AttachStackObjectToPreviousObject( Params->Stack, Params->StackIndex, pErrorAtPos );
+
+                if(     Params->StopWhenFound
+                    &&  2 == Params->StackIndex
+                    &&  JL_STATUS_SUCCESS == jlStatus
+                    &&  Params->ProjectionFound == ( (uint64_t)-1 >> ( 64 - Params->NumProjectionPaths ) ) )
+                {
+                    // That was the last value wanted from the root dictionary, so leave the rest of the input unread
+                    Params->Stack[1].FinishedProcessing = true;
+                    Params->StoppedEarly = true;
+                }
+            }
+            else if(    Params->ValidateOnly
+                     && Params->StackIndex > 0
+                     && JL_DATA_TYPE_DICTIONARY == Params->Stack[Params->StackIndex-1].Type
+                     && Params->Stack[Params->StackIndex-1].IsKeyEmpty )
+            {
+                // An empty key can not be added to a dictionary object, so this is where building a tree would fail
+                jlStatus = JL_STATUS_INVALID_DATA;
+                if( NULL != pErrorAtPos )
+                {
+                    *pErrorAtPos = Params->Stack[Params->StackIndex-1].CurrentKeyStringIndex;
+                }
+            }
+            // Finished with this level. So pop off the stack
+            Params->StackIndex -= 1;
+        }
+    }
+
+    if(     JL_STATUS_SUCCESS != jlStatus
+        &&  JL_STATUS_NEED_MORE_DATA != jlStatus )
+    {
+        // Free object tree created so far
+        FreePartialTree( Params );
+
+        // If optional parameter was provided, then set the position of the error in the string.
+        if(     NULL != pErrorAtPos
+            &&  0 == *pErrorAtPos )
+        {
+            *pErrorAtPos = Params->BaseOffset + prevStringIndex;
+            if(     Params->StackIndex >= 0
+                &&  JL_DATA_TYPE_DICTIONARY == Params->Stack[Params->StackIndex].Type
+                &&  !Params->Stack[Params->StackIndex].ProcessedFirstItem )
+            {
+                // The opening curly bracket was skipped when the dictionary was started, but errors before the first
+                // key are reported at the bracket.
+                *pErrorAtPos -= 1;
+            }
+        }
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  FUNCTION NAMES
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#undef DetectNewType
+#undef SkipContainer
+#undef SkipValue
+#undef ParseForNewType
+#undef ParseForString
+#undef ParseOutNumberString
+#undef ParseForNumber
+#undef SkipWhiteSpace
+#undef IsCompleteWhiteSpace
+#undef ParseForList
+#undef ParseForDictionary
+#undef RunParser
@@ -0,0 +1,326 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JsonLib
+//
+//  This module contains JlParseJsonParallel which parses a large document whose root is a list on several threads.
+//  The split points between the slices are guessed by scanning for a comma that looks to be between two elements of
+//  the root list. The slices are parsed at the same time, each into a list of its own, and then the elements are
+//  joined in order. A slice only parses if it starts and ends between elements of the root list, so a bad guess
+//  makes a slice fail. If any slice fails the whole document is parsed again on one thread, which gives the same
+//  result (or error) as JlParseJsonBuffer.
+//
+//  This is free and unencumbered software released into the public domain - November 2019 waterjuice.org
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  IMPORTS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "JlStatus.h"
+#include "JlMemory.h"
+#include "JlDataModel.h"
+#include "JlParser.h"
+#include "JlScan.h"
+#include "JlThreads.h"
+#include "JlParseSlice.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  CONSTANTS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define MIN_SLICE_SIZE              ( 1024*1024 )       // 1 MB, smaller documents are not split
+#define SPLIT_SCAN_SIZE             ( 64*1024 )         // How far to look for a split point
+#define MAX_THREADS                 256
+#define NO_SPLIT_POINT              SIZE_MAX
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TYPES
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+    char const*     JsonBuffer;
+    bool            IsJson5;
+    size_t          SliceStart;
+    size_t          SliceEnd;
+    bool            AfterComma;
+    bool            EndsAtComma;
+    JlThread*       Thread;
+    JlDataObject*   ListObject;
+    JL_STATUS       Status;
+} ListSlice;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PRIVATE FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  FindSplitPoint
+//
+//  Guesses a comma between two elements of the root list at or after From. The scan starts after the next newline,
+//  as a Json1 string can not contain one, and then follows strings so that commas inside them are not used. The
+//  depth of the start is not known, so the comma picked is the first of those at the lowest depth seen within
+//  SPLIT_SCAN_SIZE bytes. Returns NO_SPLIT_POINT if there is no comma. The guess can be wrong (for example when an
+//  element is longer than the scan, or in a Json5 comment) which is found when the slices are parsed.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+size_t
+    FindSplitPoint
+    (
+        char const*     JsonBuffer,
+        size_t          JsonBufferLength,
+        bool            IsJson5,
+        size_t          From
+    )
+{
+    size_t splitPoint = NO_SPLIT_POINT;
+    char const* newLine = memchr( JsonBuffer + From, '\n', JsonBufferLength - From );
+    size_t index = ( NULL != newLine ) ? (size_t)( newLine - JsonBuffer ) + 1 : From;
+    size_t scanEnd = ( JsonBufferLength - index > SPLIT_SCAN_SIZE ) ? index + SPLIT_SCAN_SIZE : JsonBufferLength;
+    char quoteChar = 0;
+    int32_t depth = 0;
+    int32_t splitDepth = 0;
+
+    for( ; index < scanEnd; index++ )
+    {
+        char currentChar = JsonBuffer[index];
+
+        if( 0 != quoteChar )
+        {
+            if( '\\' == currentChar )
+            {
+                index += 1;
+            }
+            else if( quoteChar == currentChar )
+            {
+                quoteChar = 0;
+            }
+        }
+        else if( '"' == currentChar || ( IsJson5 && '\'' == currentChar ) )
+        {
+            quoteChar = currentChar;
+        }
+        else if( '[' == currentChar || '{' == currentChar )
+        {
+            depth += 1;
+        }
+        else if( ']' == currentChar || '}' == currentChar )
+        {
+            depth -= 1;
+        }
+        else if(    ',' == currentChar
+                 && ( NO_SPLIT_POINT == splitPoint || depth < splitDepth ) )
+        {
+            splitPoint = index;
+            splitDepth = depth;
+        }
+    }
+
+    return splitPoint;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ParseSlice
+//
+//  Parses one slice into its own list object using a parser of its own. This is run on the new threads and on the
+//  calling thread.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+void
+    ParseSlice
+    (
+        void*   Context
+    )
+{
+    ListSlice* slice = (ListSlice*)Context;
+    JlParser* parser = NULL;
+
+    slice->Status = JlParserCreate( slice->IsJson5 ? JL_PARSE_FLAGS_JSON5 : JL_PARSE_FLAGS_NONE, &parser );
+    if( JL_STATUS_SUCCESS == slice->Status )
+    {
+        slice->Status = JlParserParseListSlice(
+            parser,
+            slice->JsonBuffer,
+            slice->SliceStart,
+            slice->SliceEnd,
+            slice->AfterComma,
+            slice->EndsAtComma,
+            &slice->ListObject,
+            NULL );
+        (void) JlParserFree( &parser );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ParseSlices
+//
+//  Parses the slices at the same time and joins their elements into the list of the first slice. Returns false if
+//  any slice failed, in which case nothing is returned.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+bool
+    ParseSlices
+    (
+        ListSlice*      Slices,
+        size_t          NumSlices,
+        JlDataObject**  pRootObject
+    )
+{
+    bool allParsed = true;
+
+    // Slice 0 is parsed on this thread, along with any that a thread could not be started for
+    for( size_t i=1; i<NumSlices; i++ )
+    {
+        (void) JlThreadCreate( ParseSlice, &Slices[i], &Slices[i].Thread );
+    }
+    ParseSlice( &Slices[0] );
+    for( size_t i=1; i<NumSlices; i++ )
+    {
+        if( NULL != Slices[i].Thread )
+        {
+            (void) JlThreadWait( &Slices[i].Thread );
+        }
+        else
+        {
+            ParseSlice( &Slices[i] );
+        }
+    }
+
+    for( size_t i=0; i<NumSlices; i++ )
+    {
+        if( JL_STATUS_SUCCESS != Slices[i].Status )
+        {
+            allParsed = false;
+        }
+    }
+
+    if( allParsed )
+    {
+        for( size_t i=1; i<NumSlices; i++ )
+        {
+            (void) JlMoveListItems( Slices[0].ListObject, Slices[i].ListObject );
+        }
+        *pRootObject = Slices[0].ListObject;
+        Slices[0].ListObject = NULL;
+    }
+
+    for( size_t i=0; i<NumSlices; i++ )
+    {
+        if( NULL != Slices[i].ListObject )
+        {
+            (void) JlFreeObjectTree( &Slices[i].ListObject );
+        }
+    }
+
+    return allParsed;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParseJsonParallel
+//
+//  Parses JSON in a buffer, splitting a large root list between several threads. See JsonLib.h.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParseJsonParallel
+    (
+        char const*     JsonBuffer,
+        size_t          JsonBufferLength,
+        bool            IsJson5,
+        uint32_t        NumThreads,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != JsonBuffer
+        &&  NULL != pRootObject )
+    {
+        uint32_t numThreads = ( 0 != NumThreads ) ? NumThreads : JlThreadGetProcessorCount( );
+        size_t maxSlices = JsonBufferLength / MIN_SLICE_SIZE;
+        size_t rootIndex = JlScanWhiteSpace( JsonBuffer, JsonBufferLength );
+        bool parsed = false;
+
+        *pRootObject = NULL;
+        if( numThreads > MAX_THREADS )
+        {
+            numThreads = MAX_THREADS;
+        }
+        if( maxSlices > numThreads )
+        {
+            maxSlices = numThreads;
+        }
+
+        if(     maxSlices >= 2
+            &&  rootIndex < JsonBufferLength
+            &&  '[' == JsonBuffer[rootIndex] )
+        {
+            ListSlice* slices = JlAlloc( maxSlices * sizeof(ListSlice) );
+            if( NULL != slices )
+            {
+                size_t sliceSize = JsonBufferLength / maxSlices;
+                size_t numSlices = 0;
+
+                slices[0].SliceStart = 0;
+                for( size_t i=1; i<maxSlices; i++ )
+                {
+                    size_t from = sliceSize * i;
+                    size_t splitPoint = NO_SPLIT_POINT;
+                    if( from > slices[numSlices].SliceStart )
+                    {
+                        splitPoint = FindSplitPoint( JsonBuffer, JsonBufferLength, IsJson5, from );
+                    }
+                    if( NO_SPLIT_POINT != splitPoint )
+                    {
+                        slices[numSlices].SliceEnd = splitPoint;
+                        slices[numSlices].EndsAtComma = true;
+                        numSlices += 1;
+                        slices[numSlices].SliceStart = splitPoint + 1;
+                        slices[numSlices].AfterComma = true;
+                    }
+                }
+                slices[numSlices].SliceEnd = JsonBufferLength;
+                numSlices += 1;
+
+                for( size_t i=0; i<numSlices; i++ )
+                {
+                    slices[i].JsonBuffer = JsonBuffer;
+                    slices[i].IsJson5 = IsJson5;
+                }
+
+                if( numSlices >= 2 )
+                {
+                    parsed = ParseSlices( slices, numSlices, pRootObject );
+                }
+
+                JlFree( slices );
+            }
+        }
+
+        if( parsed )
+        {
+            if( NULL != pErrorAtPos )
+            {
+                *pErrorAtPos = 0;
+            }
+            jlStatus = JL_STATUS_SUCCESS;
+        }
+        else
+        {
+            // Either not worth splitting or a split was wrong (or the JSON is invalid), so parse it on this thread
+            jlStatus = JlParseJsonBuffer( JsonBuffer, JsonBufferLength, IsJson5, pRootObject, pErrorAtPos );
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
@@ -0,0 +1,562 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JsonLib
+//
+//  This module contains JlParseNdjsonParallel which parses NDJSON on several threads. The buffer is split into chunks
+//  at newlines. Each thread repeatedly takes the next chunk and parses its documents with its own JlParser. The
+//  results of a chunk are then passed to the caller's function, either straight away or, when they must be in input
+//  order, once all the chunks before it have been passed on.
+//
+//  This is free and unencumbered software released into the public domain - November 2019 waterjuice.org
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  IMPORTS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "JlStatus.h"
+#include "JlMemory.h"
+#include "JlDataModel.h"
+#include "JlParser.h"
+#include "JlThreads.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  CONSTANTS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define CHUNK_SIZE                  ( 64*1024 )         // 64 kB, extended to the next newline
+#define CHUNKS_AHEAD_PER_THREAD     4                   // Parsed chunks waiting to be passed on in order
+#define MAX_THREADS                 256
+#define RESULTS_MIN_SIZE            64
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TYPES
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+    size_t          Offset;
+    JL_STATUS       ParseStatus;
+    size_t          ErrorAtPos;
+    JlDataObject*   RootObject;
+} DocumentResult;
+
+// The parsed documents of one chunk. The Results array is kept and reused for later chunks.
+typedef struct
+{
+    DocumentResult* Results;
+    size_t          NumResults;
+    size_t          ResultsAllocated;
+    bool            Complete;               // InOrder only: parsed and waiting for the chunks before it
+} ChunkResults;
+
+typedef struct
+{
+    // Set before the threads start
+    char const*                     JsonBuffer;
+    size_t                          JsonBufferLength;
+    bool                            InOrder;
+    JL_NDJSON_DOCUMENT_FUNCTION     OnDocument;
+    void*                           Context;
+    ChunkResults*                   Slots;                  // InOrder only: chunk n uses Slots[n % NumSlots]
+    size_t                          NumSlots;
+    JlMutex*                        Lock;
+    JlCondition*                    SlotFreed;
+    JlMutex*                        CallbackLock;
+
+    // Protected by Lock
+    size_t                          NextChunkStart;
+    size_t                          NextChunkNumber;
+    size_t                          NextChunkToDeliver;     // InOrder only
+    bool                            Delivering;             // InOrder only: a thread is passing on chunks
+    JL_STATUS                       Status;                 // Set when a thread fails or OnDocument stops the parse
+
+    // Protected by CallbackLock
+    JL_STATUS                       CallbackStatus;
+} NdjsonState;
+
+typedef struct
+{
+    NdjsonState*    State;
+    JlParser*       Parser;
+    JlThread*       Thread;
+    ChunkResults    Results;                // Not InOrder: the results of the chunk this thread is parsing
+} NdjsonWorker;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PRIVATE FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  SetFailed
+//
+//  Records the first failure so that the threads stop taking new chunks, and wakes any waiting for a slot.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+void
+    SetFailed
+    (
+        NdjsonState*    State,
+        JL_STATUS       FailStatus
+    )
+{
+    JlMutexLock( State->Lock );
+    if( JL_STATUS_SUCCESS == State->Status )
+    {
+        State->Status = FailStatus;
+    }
+    JlConditionSignalAll( State->SlotFreed );
+    JlMutexUnlock( State->Lock );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  FreeResults
+//
+//  Frees any object trees left in the results and sets NumResults to 0.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+void
+    FreeResults
+    (
+        ChunkResults*   Results
+    )
+{
+    for( size_t i=0; i<Results->NumResults; i++ )
+    {
+        if( NULL != Results->Results[i].RootObject )
+        {
+            (void)JlFreeObjectTree( &Results->Results[i].RootObject );
+        }
+    }
+    Results->NumResults = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  AddResult
+//
+//  Adds a document to the results of a chunk, doubling the size of the array if needed.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    AddResult
+    (
+        ChunkResults*           Results,
+        DocumentResult const*   Result
+    )
+{
+    JL_STATUS jlStatus = JL_STATUS_SUCCESS;
+
+    if( Results->NumResults == Results->ResultsAllocated )
+    {
+        size_t newAllocated = ( 0 != Results->ResultsAllocated ) ? Results->ResultsAllocated * 2 : RESULTS_MIN_SIZE;
+        DocumentResult* newResults = JlAlloc( newAllocated * sizeof(DocumentResult) );
+        if( NULL != newResults )
+        {
+            if( NULL != Results->Results )
+            {
+                memcpy( newResults, Results->Results, Results->NumResults * sizeof(DocumentResult) );
+                JlFree( Results->Results );
+            }
+            Results->Results = newResults;
+            Results->ResultsAllocated = newAllocated;
+        }
+        else
+        {
+            jlStatus = JL_STATUS_OUT_OF_MEMORY;
+        }
+    }
+
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        Results->Results[Results->NumResults] = *Result;
+        Results->NumResults += 1;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ParseChunk
+//
+//  Parses the documents from ChunkStart up to ChunkEnd into Results. A document that fails to parse is recorded with
+//  its error and parsing carries on from the next line. Only fails if the results can not be stored.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    ParseChunk
+    (
+        JlParser*       Parser,
+        char const*     JsonBuffer,
+        size_t          ChunkStart,
+        size_t          ChunkEnd,
+        ChunkResults*   Results
+    )
+{
+    JL_STATUS jlStatus = JL_STATUS_SUCCESS;
+    size_t offset = ChunkStart;
+    bool moreDocuments = true;
+
+    while(      JL_STATUS_SUCCESS == jlStatus
+            &&  moreDocuments )
+    {
+        DocumentResult result = {0};
+
+        // Skip the white space first so that the document's Offset is the start of the document itself
+        while(      offset < ChunkEnd
+                &&  (   ' ' == JsonBuffer[offset]
+                    ||  '\t' == JsonBuffer[offset]
+                    ||  '\r' == JsonBuffer[offset]
+                    ||  '\n' == JsonBuffer[offset] ) )
+        {
+            offset += 1;
+        }
+
+        result.Offset = offset;
+        result.ParseStatus = JlParserParseNextDocument(
+            Parser, JsonBuffer, ChunkEnd, &offset, &result.RootObject, &result.ErrorAtPos );
+        if( JL_STATUS_END_OF_DATA == result.ParseStatus )
+        {
+            moreDocuments = false;
+        }
+        else
+        {
+            if( JL_STATUS_SUCCESS == result.ParseStatus )
+            {
+                result.ErrorAtPos = 0;
+            }
+            else
+            {
+                // Carry on from the line after the bad document
+                char const* newLine = memchr( JsonBuffer + result.Offset, '\n', ChunkEnd - result.Offset );
+                offset = ( NULL != newLine ) ? (size_t)( newLine - JsonBuffer ) + 1 : ChunkEnd;
+            }
+
+            jlStatus = AddResult( Results, &result );
+            if(     JL_STATUS_SUCCESS != jlStatus
+                &&  NULL != result.RootObject )
+            {
+                (void)JlFreeObjectTree( &result.RootObject );
+            }
+        }
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  DeliverResults
+//
+//  Passes the documents of a chunk to OnDocument, then frees any trees it did not take. If the parse has already
+//  been stopped the trees are just freed.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+void
+    DeliverResults
+    (
+        NdjsonState*    State,
+        ChunkResults*   Results
+    )
+{
+    JL_STATUS callbackStatus;
+    bool stopped;
+
+    JlMutexLock( State->Lock );
+    stopped = ( JL_STATUS_SUCCESS != State->Status );
+    JlMutexUnlock( State->Lock );
+
+    JlMutexLock( State->CallbackLock );
+    // OnDocument may have stopped the parse while waiting for the lock
+    stopped = stopped || ( JL_STATUS_SUCCESS != State->CallbackStatus );
+    for( size_t i=0; i<Results->NumResults && !stopped; i++ )
+    {
+        DocumentResult* result = &Results->Results[i];
+        State->CallbackStatus = State->OnDocument(
+            State->Context, result->Offset, result->ParseStatus, result->ErrorAtPos, &result->RootObject );
+        stopped = ( JL_STATUS_SUCCESS != State->CallbackStatus );
+    }
+    callbackStatus = State->CallbackStatus;
+    JlMutexUnlock( State->CallbackLock );
+
+    FreeResults( Results );
+
+    if( JL_STATUS_SUCCESS != callbackStatus )
+    {
+        SetFailed( State, callbackStatus );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  CompleteOrderedChunk
+//
+//  Marks the slot of a chunk as parsed. If no other thread is passing on chunks then this thread passes on the
+//  completed chunks in order, starting from the next one due, until it reaches one that is not yet complete.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+void
+    CompleteOrderedChunk
+    (
+        NdjsonState*    State,
+        ChunkResults*   Slot
+    )
+{
+    JlMutexLock( State->Lock );
+    Slot->Complete = true;
+    if( !State->Delivering )
+    {
+        ChunkResults* nextSlot = &State->Slots[State->NextChunkToDeliver % State->NumSlots];
+
+        State->Delivering = true;
+        while(      State->NextChunkToDeliver < State->NextChunkNumber
+                &&  nextSlot->Complete )
+        {
+            // The slot can not be reused until NextChunkToDeliver has moved past it, so it is safe to use unlocked
+            JlMutexUnlock( State->Lock );
+            DeliverResults( State, nextSlot );
+            JlMutexLock( State->Lock );
+
+            nextSlot->Complete = false;
+            State->NextChunkToDeliver += 1;
+            JlConditionSignalAll( State->SlotFreed );
+            nextSlot = &State->Slots[State->NextChunkToDeliver % State->NumSlots];
+        }
+        State->Delivering = false;
+    }
+    JlMutexUnlock( State->Lock );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  WorkerThread
+//
+//  Takes chunks and parses them until there are none left or the parse has been stopped. This is run on each of the
+//  new threads and on the calling thread.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+void
+    WorkerThread
+    (
+        void*   Context
+    )
+{
+    NdjsonWorker* worker = (NdjsonWorker*)Context;
+    NdjsonState* state = worker->State;
+    bool haveChunk = true;
+
+    while( haveChunk )
+    {
+        size_t chunkStart = 0;
+        size_t chunkEnd = 0;
+        size_t chunkNumber = 0;
+
+        JlMutexLock( state->Lock );
+        while(      state->InOrder
+                &&  JL_STATUS_SUCCESS == state->Status
+                &&  state->NextChunkStart < state->JsonBufferLength
+                &&  state->NextChunkNumber >= state->NextChunkToDeliver + state->NumSlots )
+        {
+            JlConditionWait( state->SlotFreed, state->Lock );
+        }
+        if(     JL_STATUS_SUCCESS == state->Status
+            &&  state->NextChunkStart < state->JsonBufferLength )
+        {
+            // The chunk ends at the first newline at least CHUNK_SIZE bytes in
+            chunkStart = state->NextChunkStart;
+            chunkEnd = state->JsonBufferLength;
+            if( state->JsonBufferLength - chunkStart > CHUNK_SIZE )
+            {
+                size_t searchFrom = chunkStart + CHUNK_SIZE - 1;
+                char const* newLine = memchr(
+                    state->JsonBuffer + searchFrom, '\n', state->JsonBufferLength - searchFrom );
+                if( NULL != newLine )
+                {
+                    chunkEnd = (size_t)( newLine - state->JsonBuffer ) + 1;
+                }
+            }
+            chunkNumber = state->NextChunkNumber;
+            state->NextChunkStart = chunkEnd;
+            state->NextChunkNumber += 1;
+        }
+        else
+        {
+            haveChunk = false;
+        }
+        JlMutexUnlock( state->Lock );
+
+        if( haveChunk )
+        {
+            ChunkResults* results = state->InOrder ? &state->Slots[chunkNumber % state->NumSlots] : &worker->Results;
+            JL_STATUS jlStatus = ParseChunk( worker->Parser, state->JsonBuffer, chunkStart, chunkEnd, results );
+            if( JL_STATUS_SUCCESS != jlStatus )
+            {
+                SetFailed( state, jlStatus );
+            }
+
+            if( state->InOrder )
+            {
+                CompleteOrderedChunk( state, results );
+            }
+            else
+            {
+                DeliverResults( state, results );
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParseNdjsonParallel
+//
+//  Parses a buffer of NDJSON using several threads, calling OnDocument for each document. See JsonLib.h.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParseNdjsonParallel
+    (
+        char const*                     JsonBuffer,
+        size_t                          JsonBufferLength,
+        bool                            IsJson5,
+        uint32_t                        NumThreads,
+        bool                            InOrder,
+        JL_NDJSON_DOCUMENT_FUNCTION     OnDocument,
+        void*                           Context
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != JsonBuffer
+        &&  NULL != OnDocument )
+    {
+        NdjsonState state = {0};
+        NdjsonWorker* workers = NULL;
+        uint32_t numThreads = ( 0 != NumThreads ) ? NumThreads : JlThreadGetProcessorCount( );
+        uint32_t numStarted = 0;
+
+        if( numThreads > MAX_THREADS )
+        {
+            numThreads = MAX_THREADS;
+        }
+
+        state.JsonBuffer = JsonBuffer;
+        state.JsonBufferLength = JsonBufferLength;
+        state.InOrder = InOrder;
+        state.OnDocument = OnDocument;
+        state.Context = Context;
+        state.Status = JL_STATUS_SUCCESS;
+        state.CallbackStatus = JL_STATUS_SUCCESS;
+
+        jlStatus = JlMutexCreate( &state.Lock );
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            jlStatus = JlMutexCreate( &state.CallbackLock );
+        }
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            jlStatus = JlConditionCreate( &state.SlotFreed );
+        }
+        if(     JL_STATUS_SUCCESS == jlStatus
+            &&  InOrder )
+        {
+            state.NumSlots = (size_t)numThreads * CHUNKS_AHEAD_PER_THREAD;
+            state.Slots = JlAlloc( state.NumSlots * sizeof(ChunkResults) );
+            if( NULL == state.Slots )
+            {
+                jlStatus = JL_STATUS_OUT_OF_MEMORY;
+            }
+        }
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            workers = JlAlloc( numThreads * sizeof(NdjsonWorker) );
+            if( NULL == workers )
+            {
+                jlStatus = JL_STATUS_OUT_OF_MEMORY;
+            }
+        }
+        for( uint32_t i=0; JL_STATUS_SUCCESS == jlStatus && i<numThreads; i++ )
+        {
+            workers[i].State = &state;
+            jlStatus = JlParserCreate( IsJson5 ? JL_PARSE_FLAGS_JSON5 : JL_PARSE_FLAGS_NONE, &workers[i].Parser );
+        }
+
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            // Worker 0 runs on this thread
+            for( uint32_t i=1; JL_STATUS_SUCCESS == jlStatus && i<numThreads; i++ )
+            {
+                jlStatus = JlThreadCreate( WorkerThread, &workers[i], &workers[i].Thread );
+                if( JL_STATUS_SUCCESS == jlStatus )
+                {
+                    numStarted += 1;
+                }
+                else
+                {
+                    // Stop the threads that have started
+                    SetFailed( &state, jlStatus );
+                }
+            }
+
+            if( JL_STATUS_SUCCESS == jlStatus )
+            {
+                WorkerThread( &workers[0] );
+            }
+
+            for( uint32_t i=1; i<=numStarted; i++ )
+            {
+                (void)JlThreadWait( &workers[i].Thread );
+            }
+
+            jlStatus = state.Status;
+        }
+
+        // Clean up
+        if( NULL != workers )
+        {
+            for( uint32_t i=0; i<numThreads; i++ )
+            {
+                if( NULL != workers[i].Parser )
+                {
+                    (void)JlParserFree( &workers[i].Parser );
+                }
+                FreeResults( &workers[i].Results );
+                if( NULL != workers[i].Results.Results )
+                {
+                    JlFree( workers[i].Results.Results );
+                }
+            }
+            JlFree( workers );
+        }
+        if( NULL != state.Slots )
+        {
+            for( size_t i=0; i<state.NumSlots; i++ )
+            {
+                FreeResults( &state.Slots[i] );
+                if( NULL != state.Slots[i].Results )
+                {
+                    JlFree( state.Slots[i].Results );
+                }
+            }
+            JlFree( state.Slots );
+        }
+        if( NULL != state.SlotFreed )
+        {
+            (void)JlConditionFree( &state.SlotFreed );
+        }
+        if( NULL != state.CallbackLock )
+        {
+            (void)JlMutexFree( &state.CallbackLock );
+        }
+        if( NULL != state.Lock )
+        {
+            (void)JlMutexFree( &state.Lock );
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
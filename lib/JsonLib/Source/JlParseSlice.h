@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JsonLib
+//
+//  This module links the parser and the data model for parsing a large root list in slices (JlParseJsonParallel).
+//  Each slice holds whole elements of the root list and is parsed into a list of its own, then the elements are moved
+//  in order into the list from the first slice.
+//
+//  This is free and unencumbered software released into the public domain - November 2019 waterjuice.org
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  IMPORTS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "JlStatus.h"
+#include "JlDataModel.h"
+#include "JlParser.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlParserParseListSlice
+//
+//  Parses the elements of the root list in JsonBuffer from SliceStart up to SliceEnd into a new list object. If
+//  AfterComma is false the slice is the start of the document, including the opening bracket, otherwise SliceStart is
+//  just after a comma between two elements. If EndsAtComma is false the slice is the end of the document, including
+//  the closing bracket, otherwise SliceEnd is the position of a comma between two elements and there must be nothing
+//  but plain white space between the last element and it. The elements are parsed exactly as they would be by
+//  JlParserParse of the whole document, with tags that are positions in JsonBuffer. Any failure, including SliceStart
+//  or SliceEnd not being where they are claimed to be, returns an error. (Implemented in JlParseJson.c)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlParserParseListSlice
+    (
+        JlParser*       Parser,
+        char const*     JsonBuffer,
+        size_t          SliceStart,
+        size_t          SliceEnd,
+        bool            AfterComma,
+        bool            EndsAtComma,
+        JlDataObject**  pListObject,
+        size_t*         pErrorAtPos         // OPTIONAL
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlMoveListItems
+//
+//  Moves all the items of SourceList onto the end of DestinationList, leaving SourceList empty. No memory is
+//  allocated. (Implemented in JlDataModel.c)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlMoveListItems
+    (
+        JlDataObject*   DestinationList,
+        JlDataObject*   SourceList
+    );
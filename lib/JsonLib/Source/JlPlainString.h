@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JsonLib
+//
+//  This module links the data model and the JSON output for strings that need no escaping. When a string value or a
+//  dictionary key name is set the data model records whether it can be written out as it is, so that the output can
+//  copy it in one go instead of checking it a character at a time.
+//
+//  This is free and unencumbered software released into the public domain - November 2019 waterjuice.org
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  IMPORTS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "JlStatus.h"
+#include "JlDataModel.h"
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TYPES
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Records which quotes a string can be written between without any escaping. A plain string is only ASCII, so it is
+// also unchanged by JL_OUTPUT_FLAGS_ASCII.
+typedef uint8_t JL_PLAIN_STRING;
+#define JL_PLAIN_STRING_NONE                    ((JL_PLAIN_STRING) 0x0 )
+#define JL_PLAIN_STRING_DOUBLE_QUOTED           ((JL_PLAIN_STRING) 0x1 )
+#define JL_PLAIN_STRING_SINGLE_QUOTED           ((JL_PLAIN_STRING) 0x2 )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlGetObjectStringPlain
+//
+//  Same as JlGetObjectString but also sets *pPlain to say which quotes the string can be written between without
+//  escaping. (Implemented in JlDataModel.c)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlGetObjectStringPlain
+    (
+        JlDataObject const*     StringObject,
+        char const**            pString,
+        JL_PLAIN_STRING*        pPlain
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlGetDictionaryItemKeyPlain
+//
+//  Returns which quotes the key name of a dictionary item, as returned in the enumerator of
+//  JlGetObjectDictionaryNextItem, can be written between without escaping. (Implemented in JlDataModel.c)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_PLAIN_STRING
+    JlGetDictionaryItemKeyPlain
+    (
+        JlDictionaryItem const*     DictionaryItem
+    );
@@ -0,0 +1,254 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JsonLib
+//
+//  This module provides the scanning functions used by the parser and the JSON output to move quickly over runs of
+//  bytes that need no individual handling. Where SSE2 is available 16 bytes are classified at a time, otherwise a byte
+//  at a time.
+//
+//  This is free and unencumbered software released into the public domain - November 2019 waterjuice.org
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  IMPORTS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "JlScan.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// SSE2 is part of x86-64 so is always present there. Builds for other processors use the byte at a time versions.
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+    #define JL_SCAN_SSE2
+    #include <emmintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #endif
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  MACROS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define IsJsonWhiteSpace( Char )    ( ' ' == (Char) || '\n' == (Char) || '\r' == (Char) || '\t' == (Char) )
+#define IsStringRunChar( Char, QuoteChar )  \
+    ( (unsigned char)(Char) >= 0x20 && '\\' != (Char) && (QuoteChar) != (Char) )
+#define IsPlainAsciiChar( Char, QuoteChar )  \
+    (   (unsigned char)(Char) >= 0x20 && (unsigned char)(Char) <= 0x7f \
+     && '\\' != (Char) && '\"' != (Char) && (QuoteChar) != (Char) )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PRIVATE FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef JL_SCAN_SSE2
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  IndexOfFirstSetBit
+//
+//  Returns the index of the lowest set bit in a non zero Mask
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+size_t
+    IndexOfFirstSetBit
+    (
+        uint32_t        Mask
+    )
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward( &index, Mask );
+    return index;
+#else
+    return (size_t)__builtin_ctz( Mask );
+#endif
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlScanWhiteSpace
+//
+//  Returns the number of bytes at the start of String that are JSON white space (space, tab, carriage return, or
+//  line feed). Reads no further than StringLength bytes. Json5 white space and comments are not included, these are
+//  left for the caller to handle.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t
+    JlScanWhiteSpace
+    (
+        char const*     String,
+        size_t          StringLength
+    )
+{
+    size_t index = 0;
+    bool moreToScan;
+
+    // Between tokens in compact JSON there is usually no white space, or only a single space. Check for these a byte
+    // at a time before setting up for a block scan.
+    while( index < 2 && index < StringLength && IsJsonWhiteSpace( String[index] ) )
+    {
+        index += 1;
+    }
+    moreToScan = ( 2 == index );
+
+#ifdef JL_SCAN_SSE2
+    if( moreToScan )
+    {
+        __m128i const spaces = _mm_set1_epi8( ' ' );
+        __m128i const lineFeeds = _mm_set1_epi8( '\n' );
+        __m128i const carriageReturns = _mm_set1_epi8( '\r' );
+        __m128i const tabs = _mm_set1_epi8( '\t' );
+
+        while( moreToScan && StringLength - index >= 16 )
+        {
+            __m128i block = _mm_loadu_si128( (__m128i const*)( String + index ) );
+            __m128i isWhiteSpace = _mm_or_si128(
+                _mm_or_si128( _mm_cmpeq_epi8( block, spaces ), _mm_cmpeq_epi8( block, lineFeeds ) ),
+                _mm_or_si128( _mm_cmpeq_epi8( block, carriageReturns ), _mm_cmpeq_epi8( block, tabs ) ) );
+            uint32_t notWhiteSpaceMask = ~(uint32_t)_mm_movemask_epi8( isWhiteSpace ) & 0xffff;
+
+            if( 0 != notWhiteSpaceMask )
+            {
+                index += IndexOfFirstSetBit( notWhiteSpaceMask );
+                moreToScan = false;
+            }
+            else
+            {
+                index += 16;
+            }
+        }
+    }
+#endif
+
+    if( moreToScan )
+    {
+        // Remainder that is too short for a block
+        while( index < StringLength && IsJsonWhiteSpace( String[index] ) )
+        {
+            index += 1;
+        }
+    }
+
+    return index;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlScanStringRun
+//
+//  Returns the number of bytes at the start of String, which is the inside of a quoted string, that can be copied as
+//  they are. The run ends at the first backslash, control character (below 0x20), or QuoteChar. Reads no further
+//  than StringLength bytes.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t
+    JlScanStringRun
+    (
+        char const*     String,
+        size_t          StringLength,
+        char            QuoteChar
+    )
+{
+    size_t index = 0;
+    bool moreToScan = true;
+
+#ifdef JL_SCAN_SSE2
+    {
+        __m128i const quotes = _mm_set1_epi8( QuoteChar );
+        __m128i const backslashes = _mm_set1_epi8( '\\' );
+        __m128i const maxControlChar = _mm_set1_epi8( 0x1f );
+
+        while( moreToScan && StringLength - index >= 16 )
+        {
+            __m128i block = _mm_loadu_si128( (__m128i const*)( String + index ) );
+            // There is no unsigned compare in SSE2. A byte is a control character if max(byte,0x1f) is 0x1f
+            __m128i isControlChar = _mm_cmpeq_epi8( _mm_max_epu8( block, maxControlChar ), maxControlChar );
+            __m128i isSpecial = _mm_or_si128(
+                _mm_or_si128( _mm_cmpeq_epi8( block, quotes ), _mm_cmpeq_epi8( block, backslashes ) ),
+                isControlChar );
+            uint32_t specialMask = (uint32_t)_mm_movemask_epi8( isSpecial );
+
+            if( 0 != specialMask )
+            {
+                index += IndexOfFirstSetBit( specialMask );
+                moreToScan = false;
+            }
+            else
+            {
+                index += 16;
+            }
+        }
+    }
+#endif
+
+    if( moreToScan )
+    {
+        while( index < StringLength && IsStringRunChar( String[index], QuoteChar ) )
+        {
+            index += 1;
+        }
+    }
+
+    return index;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlScanPlainAscii
+//
+//  Returns the number of bytes at the start of String that can be written out inside a JSON string quoted with
+//  QuoteChar without escaping. These are the ASCII characters from 0x20 to 0x7f other than backslash, double quote,
+//  and QuoteChar. Reads no further than StringLength bytes.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t
+    JlScanPlainAscii
+    (
+        char const*     String,
+        size_t          StringLength,
+        char            QuoteChar
+    )
+{
+    size_t index = 0;
+    bool moreToScan = true;
+
+#ifdef JL_SCAN_SSE2
+    {
+        __m128i const quotes = _mm_set1_epi8( QuoteChar );
+        __m128i const doubleQuotes = _mm_set1_epi8( '\"' );
+        __m128i const backslashes = _mm_set1_epi8( '\\' );
+        __m128i const maxControlChar = _mm_set1_epi8( 0x1f );
+
+        while( moreToScan && StringLength - index >= 16 )
+        {
+            __m128i block = _mm_loadu_si128( (__m128i const*)( String + index ) );
+            // As a signed compare, bytes of 0x80 and above are negative so are not greater than 0x1f either
+            uint32_t notPlainMask = ~(uint32_t)_mm_movemask_epi8( _mm_cmpgt_epi8( block, maxControlChar ) ) & 0xffff;
+            __m128i isSpecial = _mm_or_si128(
+                _mm_or_si128( _mm_cmpeq_epi8( block, quotes ), _mm_cmpeq_epi8( block, doubleQuotes ) ),
+                _mm_cmpeq_epi8( block, backslashes ) );
+            uint32_t specialMask = notPlainMask | (uint32_t)_mm_movemask_epi8( isSpecial );
+
+            if( 0 != specialMask )
+            {
+                index += IndexOfFirstSetBit( specialMask );
+                moreToScan = false;
+            }
+            else
+            {
+                index += 16;
+            }
+        }
+    }
+#endif
+
+    if( moreToScan )
+    {
+        while( index < StringLength && IsPlainAsciiChar( String[index], QuoteChar ) )
+        {
+            index += 1;
+        }
+    }
+
+    return index;
+}
@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JsonLib
+//
+//  This module provides the scanning functions used by the parser and the JSON output to move quickly over runs of
+//  bytes that need no individual handling. Where SSE2 is available 16 bytes are classified at a time, otherwise a byte
+//  at a time.
+//
+//  This is free and unencumbered software released into the public domain - November 2019 waterjuice.org
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  IMPORTS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stddef.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlScanWhiteSpace
+//
+//  Returns the number of bytes at the start of String that are JSON white space (space, tab, carriage return, or
+//  line feed). Reads no further than StringLength bytes. Json5 white space and comments are not included, these are
+//  left for the caller to handle.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t
+    JlScanWhiteSpace
+    (
+        char const*     String,
+        size_t          StringLength
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlScanStringRun
+//
+//  Returns the number of bytes at the start of String, which is the inside of a quoted string, that can be copied as
+//  they are. The run ends at the first backslash, control character (below 0x20), or QuoteChar. Reads no further
+//  than StringLength bytes.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t
+    JlScanStringRun
+    (
+        char const*     String,
+        size_t          StringLength,
+        char            QuoteChar
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlScanPlainAscii
+//
+//  Returns the number of bytes at the start of String that can be written out inside a JSON string quoted with
+//  QuoteChar without escaping. These are the ASCII characters from 0x20 to 0x7f other than backslash, double quote,
+//  and QuoteChar. Reads no further than StringLength bytes.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t
+    JlScanPlainAscii
+    (
+        char const*     String,
+        size_t          StringLength,
+        char            QuoteChar
+    );
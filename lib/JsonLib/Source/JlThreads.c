@@ -0,0 +1,453 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JsonLib
+//
+//  This module provides the small amount of threading that JsonLib uses: threads, mutexes, and condition variables.
+//  It uses pthreads, or the Win32 API when built for Windows.
+//
+//  This is free and unencumbered software released into the public domain - November 2019 waterjuice.org
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  IMPORTS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "JlThreads.h"
+#include "JlMemory.h"
+#include "JlStatus.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined( _WIN32 )
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <unistd.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TYPES
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct JlThread
+{
+#if defined( _WIN32 )
+    HANDLE                  Handle;
+#else
+    pthread_t               Handle;
+#endif
+    JL_THREAD_FUNCTION      Function;
+    void*                   Context;
+};
+
+struct JlMutex
+{
+#if defined( _WIN32 )
+    CRITICAL_SECTION        Lock;
+#else
+    pthread_mutex_t         Lock;
+#endif
+};
+
+struct JlCondition
+{
+#if defined( _WIN32 )
+    CONDITION_VARIABLE      Condition;
+#else
+    pthread_cond_t          Condition;
+#endif
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PRIVATE FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ThreadStart
+//
+//  Entry point of the new thread, calls the function given to JlThreadCreate.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+#if defined( _WIN32 )
+static
+DWORD WINAPI
+    ThreadStart
+    (
+        LPVOID          Parameter
+    )
+{
+    JlThread* thread = (JlThread*)Parameter;
+    thread->Function( thread->Context );
+    return 0;
+}
+#else
+static
+void*
+    ThreadStart
+    (
+        void*           Parameter
+    )
+{
+    JlThread* thread = (JlThread*)Parameter;
+    thread->Function( thread->Context );
+    return NULL;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlThreadCreate
+//
+//  Starts a new thread running Function( Context ). The thread must be waited for with JlThreadWait.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlThreadCreate
+    (
+        JL_THREAD_FUNCTION  Function,
+        void*               Context,
+        JlThread**          pThread
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != Function
+        &&  NULL != pThread )
+    {
+        JlThread* thread = JlNew( JlThread );
+        if( NULL != thread )
+        {
+            thread->Function = Function;
+            thread->Context = Context;
+
+#if defined( _WIN32 )
+            thread->Handle = CreateThread( NULL, 0, ThreadStart, thread, 0, NULL );
+            if( NULL != thread->Handle )
+#else
+            if( 0 == pthread_create( &thread->Handle, NULL, ThreadStart, thread ) )
+#endif
+            {
+                *pThread = thread;
+                jlStatus = JL_STATUS_SUCCESS;
+            }
+            else
+            {
+                // Running out of threads is treated the same as running out of memory
+                JlFree( thread );
+                jlStatus = JL_STATUS_OUT_OF_MEMORY;
+            }
+        }
+        else
+        {
+            jlStatus = JL_STATUS_OUT_OF_MEMORY;
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlThreadWait
+//
+//  Waits for a thread created with JlThreadCreate to finish and then frees it. *pThread will be set to NULL.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlThreadWait
+    (
+        JlThread**          pThread
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != pThread
+        &&  NULL != *pThread )
+    {
+#if defined( _WIN32 )
+        WaitForSingleObject( (*pThread)->Handle, INFINITE );
+        CloseHandle( (*pThread)->Handle );
+#else
+        pthread_join( (*pThread)->Handle, NULL );
+#endif
+        JlFree( *pThread );
+        *pThread = NULL;
+        jlStatus = JL_STATUS_SUCCESS;
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlThreadGetProcessorCount
+//
+//  Returns the number of processors available, or 1 if it can not be found.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+uint32_t
+    JlThreadGetProcessorCount
+    (
+        void
+    )
+{
+    uint32_t count = 1;
+
+#if defined( _WIN32 )
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo( &systemInfo );
+    if( systemInfo.dwNumberOfProcessors > 0 )
+    {
+        count = (uint32_t)systemInfo.dwNumberOfProcessors;
+    }
+#else
+    long processors = sysconf( _SC_NPROCESSORS_ONLN );
+    if( processors > 0 )
+    {
+        count = (uint32_t)processors;
+    }
+#endif
+
+    return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlMutexCreate
+//
+//  Creates a mutex. Free with JlMutexFree.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlMutexCreate
+    (
+        JlMutex**           pMutex
+    )
+{
+    JL_STATUS jlStatus;
+
+    if( NULL != pMutex )
+    {
+        JlMutex* mutex = JlNew( JlMutex );
+        if( NULL != mutex )
+        {
+#if defined( _WIN32 )
+            InitializeCriticalSection( &mutex->Lock );
+            *pMutex = mutex;
+            jlStatus = JL_STATUS_SUCCESS;
+#else
+            if( 0 == pthread_mutex_init( &mutex->Lock, NULL ) )
+            {
+                *pMutex = mutex;
+                jlStatus = JL_STATUS_SUCCESS;
+            }
+            else
+            {
+                JlFree( mutex );
+                jlStatus = JL_STATUS_OUT_OF_MEMORY;
+            }
+#endif
+        }
+        else
+        {
+            jlStatus = JL_STATUS_OUT_OF_MEMORY;
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlMutexFree
+//
+//  Frees a mutex created with JlMutexCreate. It must not be locked. *pMutex will be set to NULL.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlMutexFree
+    (
+        JlMutex**           pMutex
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != pMutex
+        &&  NULL != *pMutex )
+    {
+#if defined( _WIN32 )
+        DeleteCriticalSection( &(*pMutex)->Lock );
+#else
+        pthread_mutex_destroy( &(*pMutex)->Lock );
+#endif
+        JlFree( *pMutex );
+        *pMutex = NULL;
+        jlStatus = JL_STATUS_SUCCESS;
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlMutexLock
+//
+//  Locks the mutex, waiting for any other thread holding it to unlock it first.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+    JlMutexLock
+    (
+        JlMutex*            Mutex
+    )
+{
+#if defined( _WIN32 )
+    EnterCriticalSection( &Mutex->Lock );
+#else
+    pthread_mutex_lock( &Mutex->Lock );
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlMutexUnlock
+//
+//  Unlocks a mutex locked with JlMutexLock.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+    JlMutexUnlock
+    (
+        JlMutex*            Mutex
+    )
+{
+#if defined( _WIN32 )
+    LeaveCriticalSection( &Mutex->Lock );
+#else
+    pthread_mutex_unlock( &Mutex->Lock );
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlConditionCreate
+//
+//  Creates a condition variable. Free with JlConditionFree.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlConditionCreate
+    (
+        JlCondition**       pCondition
+    )
+{
+    JL_STATUS jlStatus;
+
+    if( NULL != pCondition )
+    {
+        JlCondition* condition = JlNew( JlCondition );
+        if( NULL != condition )
+        {
+#if defined( _WIN32 )
+            InitializeConditionVariable( &condition->Condition );
+            *pCondition = condition;
+            jlStatus = JL_STATUS_SUCCESS;
+#else
+            if( 0 == pthread_cond_init( &condition->Condition, NULL ) )
+            {
+                *pCondition = condition;
+                jlStatus = JL_STATUS_SUCCESS;
+            }
+            else
+            {
+                JlFree( condition );
+                jlStatus = JL_STATUS_OUT_OF_MEMORY;
+            }
+#endif
+        }
+        else
+        {
+            jlStatus = JL_STATUS_OUT_OF_MEMORY;
+        }
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlConditionFree
+//
+//  Frees a condition variable created with JlConditionCreate. No threads may be waiting on it. *pCondition will be set
+//  to NULL.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlConditionFree
+    (
+        JlCondition**       pCondition
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != pCondition
+        &&  NULL != *pCondition )
+    {
+#if !defined( _WIN32 )
+        // Win32 condition variables do not need to be destroyed
+        pthread_cond_destroy( &(*pCondition)->Condition );
+#endif
+        JlFree( *pCondition );
+        *pCondition = NULL;
+        jlStatus = JL_STATUS_SUCCESS;
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlConditionWait
+//
+//  Unlocks Mutex, which must be locked by the caller, and waits for the condition to be signalled. Mutex is locked
+//  again before returning.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+    JlConditionWait
+    (
+        JlCondition*        Condition,
+        JlMutex*            Mutex
+    )
+{
+#if defined( _WIN32 )
+    SleepConditionVariableCS( &Condition->Condition, &Mutex->Lock, INFINITE );
+#else
+    pthread_cond_wait( &Condition->Condition, &Mutex->Lock );
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlConditionSignalAll
+//
+//  Wakes all threads waiting on the condition.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+    JlConditionSignalAll
+    (
+        JlCondition*        Condition
+    )
+{
+#if defined( _WIN32 )
+    WakeAllConditionVariable( &Condition->Condition );
+#else
+    pthread_cond_broadcast( &Condition->Condition );
+#endif
+}
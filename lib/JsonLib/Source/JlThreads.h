@@ -0,0 +1,165 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JsonLib
+//
+//  This module provides the small amount of threading that JsonLib uses: threads, mutexes, and condition variables.
+//  It uses pthreads, or the Win32 API when built for Windows. The objects are allocated with JlAlloc so that the
+//  platform headers are not needed by the rest of the library.
+//
+//  This is free and unencumbered software released into the public domain - November 2019 waterjuice.org
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  IMPORTS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "JlStatus.h"
+#include <stdint.h>
+#include <stddef.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TYPES
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef struct JlThread JlThread;
+typedef struct JlMutex JlMutex;
+typedef struct JlCondition JlCondition;
+
+typedef
+void
+    (*JL_THREAD_FUNCTION)
+    (
+        void*   Context
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlThreadCreate
+//
+//  Starts a new thread running Function( Context ). The thread must be waited for with JlThreadWait.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlThreadCreate
+    (
+        JL_THREAD_FUNCTION  Function,
+        void*               Context,
+        JlThread**          pThread
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlThreadWait
+//
+//  Waits for a thread created with JlThreadCreate to finish and then frees it. *pThread will be set to NULL.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlThreadWait
+    (
+        JlThread**          pThread
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlThreadGetProcessorCount
+//
+//  Returns the number of processors available, or 1 if it can not be found.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+uint32_t
+    JlThreadGetProcessorCount
+    (
+        void
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlMutexCreate
+//
+//  Creates a mutex. Free with JlMutexFree.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlMutexCreate
+    (
+        JlMutex**           pMutex
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlMutexFree
+//
+//  Frees a mutex created with JlMutexCreate. It must not be locked. *pMutex will be set to NULL.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlMutexFree
+    (
+        JlMutex**           pMutex
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlMutexLock
+//
+//  Locks the mutex, waiting for any other thread holding it to unlock it first.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+    JlMutexLock
+    (
+        JlMutex*            Mutex
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlMutexUnlock
+//
+//  Unlocks a mutex locked with JlMutexLock.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+    JlMutexUnlock
+    (
+        JlMutex*            Mutex
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlConditionCreate
+//
+//  Creates a condition variable. Free with JlConditionFree.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlConditionCreate
+    (
+        JlCondition**       pCondition
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlConditionFree
+//
+//  Frees a condition variable created with JlConditionCreate. No threads may be waiting on it. *pCondition will be set
+//  to NULL.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlConditionFree
+    (
+        JlCondition**       pCondition
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlConditionWait
+//
+//  Unlocks Mutex, which must be locked by the caller, and waits for the condition to be signalled. Mutex is locked
+//  again before returning. As with any condition variable the wait can end without a signal, so the caller must check
+//  what it is waiting for in a loop.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+    JlConditionWait
+    (
+        JlCondition*        Condition,
+        JlMutex*            Mutex
+    );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlConditionSignalAll
+//
+//  Wakes all threads waiting on the condition.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+    JlConditionSignalAll
+    (
+        JlCondition*        Condition
+    );
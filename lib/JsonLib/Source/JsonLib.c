@@ -12,6 +12,7 @@
 
 #include "JsonLib.h"
 #include "JlMemory.h"
+#include <string.h>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  PUBLIC FUNCTIONS
@@ -92,14 +93,53 @@ JL_STATUS
 {
     JL_STATUS jlStatus;
 
-    if(     NULL != JsonString
+    if( NULL != JsonString )
+    {
+        jlStatus = JlJsonBufferToStruct(
+            JsonString, strlen( JsonString ),
+            StructDescription, StructDescriptionCount,
+            IgnoreExistingValuesInStruct,
+            AllowJson5,
+            Structure,
+            pErrorAtPos );
+    }
+    else
+    {
+        jlStatus = JL_STATUS_INVALID_PARAMETER;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JlJsonBufferToStruct
+//
+//  Same as JlJsonToStructEx except the JSON is provided as a buffer of JsonBufferLength bytes which does not need to
+//  be zero terminated. No bytes beyond JsonBufferLength will be read.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+JL_STATUS
+    JlJsonBufferToStruct
+    (
+        char const*                 JsonBuffer,                     // [in]
+        size_t                      JsonBufferLength,               // [in]
+        JlMarshallElement const*    StructDescription,              // [in]
+        size_t                      StructDescriptionCount,         // [in]
+        bool                        IgnoreExistingValuesInStruct,   // [in]
+        bool                        AllowJson5,                     // [in]
+        void*                       Structure,                      // [in,out]
+        size_t*                     pErrorAtPos                     // [out] [OPTIONAL]
+    )
+{
+    JL_STATUS jlStatus;
+
+    if(     NULL != JsonBuffer
         &&  NULL != StructDescription
         &&  0 != StructDescriptionCount
         &&  NULL != Structure )
     {
         JlDataObject* objectTree = NULL;
 
-        jlStatus = JlParseJsonEx( JsonString, AllowJson5, &objectTree, pErrorAtPos );
+        jlStatus = JlParseJsonBuffer( JsonBuffer, JsonBufferLength, AllowJson5, &objectTree, pErrorAtPos );
         if( JL_STATUS_SUCCESS == jlStatus )
         {
             jlStatus = JlUnmarshallToStructEx(
@@ -115,6 +115,20 @@ void
         void*       Memory
     );
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  WjTestLib_Memory_GetStats
+//
+//  Gets the total number of allocations and frees that have happened so far with the functions above. Tests can use
+//  this to check that code makes no allocations.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+    WjTestLib_Memory_GetStats
+    (
+        uint64_t*           pTotalAllocs,           // OPTIONAL
+        uint64_t*           pTotalFrees,            // OPTIONAL
+        uint64_t*           pTotalOutstanding       // OPTIONAL
+    );
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  PUBLIC FUNCTIONS
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
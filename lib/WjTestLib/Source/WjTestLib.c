@@ -11,7 +11,6 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "WjTestLib.h"
-#include "WjTestLib_Memory.h"
 #include "WjTestLib_Asserts.h"
 #include <stdint.h>
 #include <stdlib.h>
@@ -4,7 +4,8 @@
 //  A simple unit test framework.
 //  This module handles memory tracking. It contains alternatives to malloc, calloc, and free that can be used which
 //  will have tracking. The test library automatically will check for leaks if these functions are used.
-//  Note: The functions WjTestLib_Calloc, WjTestLib_Malloc and WjTestLib_Free are declared in WjTestLib.h
+//  Note: The functions WjTestLib_Calloc, WjTestLib_Malloc, WjTestLib_Free, and WjTestLib_Memory_GetStats are declared
+//  in WjTestLib.h
 //
 //  This is free and unencumbered software released into the public domain - November 2019 waterjuice.org
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -20,6 +21,24 @@
 #include <string.h>
 #include <stdbool.h>
 
+#if defined( _WIN32 )
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  MACROS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The counters are updated atomically as the library under test may allocate from several threads at once.
+#if defined( _WIN32 )
+    #define AtomicIncrement( pValue )   ( (uint64_t)InterlockedIncrement64( (LONG64 volatile*)(pValue) ) )
+    #define AtomicRead( pValue )        ( (uint64_t)InterlockedCompareExchange64( (LONG64 volatile*)(pValue), 0, 0 ) )
+#else
+    #define AtomicIncrement( pValue )   __atomic_add_fetch( (pValue), 1, __ATOMIC_SEQ_CST )
+    #define AtomicRead( pValue )        __atomic_load_n( (pValue), __ATOMIC_SEQ_CST )
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  TYPES
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -54,7 +73,7 @@ void*
     void* allocation = calloc( NumOfElements, SizeOfElements );
     if( NULL != allocation )
     {
-        gTotalNumAllocations += 1;
+        (void)AtomicIncrement( &gTotalNumAllocations );
     }
     return allocation;
 }
@@ -77,7 +96,7 @@ void*
     void* allocation = malloc( Size );
     if( NULL != allocation )
     {
-        gTotalNumAllocations += 1;
+        (void)AtomicIncrement( &gTotalNumAllocations );
     }
     return allocation;
 }
@@ -116,9 +135,10 @@ void
 {
     if( NULL != Memory )
     {
+        uint64_t numFrees;
         free( Memory );
-        gTotalNumFrees += 1;
-        if( gTotalNumFrees > gTotalNumAllocations )
+        numFrees = AtomicIncrement( &gTotalNumFrees );
+        if( numFrees > AtomicRead( &gTotalNumAllocations ) )
         {
             fprintf( stderr, "***** MEMORY ERROR (MORE FREES THAN ALLOCS) *****\n" );
         }
@@ -146,16 +166,19 @@ void
         uint64_t*           pTotalOutstanding       // OPTIONAL
     )
 {
+    uint64_t totalNumFrees = AtomicRead( &gTotalNumFrees );
+    uint64_t totalNumAllocations = AtomicRead( &gTotalNumAllocations );
+
     if( NULL != pTotalAllocs)
     {
-        *pTotalAllocs = gTotalNumAllocations;
+        *pTotalAllocs = totalNumAllocations;
     }
     if( NULL != pTotalFrees)
     {
-        *pTotalFrees = gTotalNumFrees;
+        *pTotalFrees = totalNumFrees;
     }
     if( NULL != pTotalOutstanding)
     {
-        *pTotalOutstanding = gTotalNumAllocations - gTotalNumFrees;
+        *pTotalOutstanding = totalNumAllocations - totalNumFrees;
     }
 }
@@ -42,19 +42,19 @@ bool
     if( NULL != file )
     {
         fseek( file, 0, SEEK_END );
-        int fileLen = ftell( file );
+        long fileLen = ftell( file );
         fseek( file, 0, SEEK_SET );
 
         if( fileLen > 0 )
         {
             // allocate buffer
-            char* buffer = malloc( fileLen + 1 );
+            char* buffer = malloc( (size_t)fileLen + 1 );
             if( NULL != buffer )
             {
-                int amount;
-                amount = (int)fread( buffer, 1, fileLen, file );
+                size_t amount;
+                amount = fread( buffer, 1, (size_t)fileLen, file );
 
-                if( amount <= fileLen && amount > 0 )
+                if( amount <= (size_t)fileLen && amount > 0 )
                 {
                     buffer[amount] = 0;     // zero terminate
                     *pStringData = buffer;
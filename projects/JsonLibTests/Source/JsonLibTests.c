@@ -26,6 +26,7 @@ void JsonLibTests_Unmarshall_Register( void );
 void JsonLibTests_Marshall_Register( void );
 void JsonLibTests_RoundTrip_Register( void );
 void JsonLibTests_Base64_Register( void );
+void JsonLibTests_Events_Register( void );
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  PUBLIC FUNCTIONS
@@ -52,6 +53,7 @@ main
     JsonLibTests_Marshall_Register( );
     JsonLibTests_RoundTrip_Register( );
     JsonLibTests_Base64_Register( );
+    JsonLibTests_Events_Register( );
 
     // Run tests
     result = WjTestLib_Run( ArgC, ArgV );
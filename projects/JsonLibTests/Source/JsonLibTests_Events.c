@@ -0,0 +1,982 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JsonLibTests
+//
+//  Unit tests for JsonLib - Events
+//  Tests parsing JSON with callbacks (JlParseJsonEvents) rather than building an object tree, and reading
+//  tokens with JlReader
+//
+//  This is free and unencumbered software released into the public domain - November 2019 waterjuice.org
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  IMPORTS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "JsonLib.h"
+#include "JsonLibTests.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  MACROS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define NumElements( Array )    ( sizeof(Array) / sizeof((Array)[0]) )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TYPES
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Records the events as text so they can be compared with the expected sequence
+typedef struct
+{
+    char        Trace[1024];
+    size_t      TraceLength;
+    size_t      NumEvents;
+    size_t      LastTextLength;
+    char const* StopAtNumber;           // If set then OnNumber fails when it sees this number
+} EventTrace;
+
+// Builds a JlDataObject tree from the events so the result can be compared with JlParseJsonBuffer
+typedef struct
+{
+    JlDataObject*   Stack[MAX_JSON_DEPTH+2];
+    int             Depth;
+    JlDataObject*   Root;
+    char            Key[256];
+} EventTreeBuilder;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  INTERNAL FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  AddToTrace
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    AddToTrace
+    (
+        EventTrace*     Trace,
+        char const*     Type,
+        char const*     Text,       // OPTIONAL
+        size_t          Offset
+    )
+{
+    int amount = snprintf(
+        Trace->Trace + Trace->TraceLength,
+        sizeof(Trace->Trace) - Trace->TraceLength,
+        "%s%s%s%s@%u",
+        Trace->TraceLength > 0 ? " " : "",
+        Type,
+        NULL != Text ? ":" : "",
+        NULL != Text ? Text : "",
+        (unsigned)Offset );
+    if( amount > 0 && (size_t)amount < sizeof(Trace->Trace) - Trace->TraceLength )
+    {
+        Trace->TraceLength += (size_t)amount;
+    }
+    Trace->NumEvents += 1;
+
+    return JL_STATUS_SUCCESS;
+}
+
+static JL_STATUS TraceBeginDictionary( void* Context, size_t Offset ) { return AddToTrace( Context, "{", NULL, Offset ); }
+static JL_STATUS TraceEndDictionary( void* Context, size_t Offset ) { return AddToTrace( Context, "}", NULL, Offset ); }
+static JL_STATUS TraceBeginList( void* Context, size_t Offset ) { return AddToTrace( Context, "[", NULL, Offset ); }
+static JL_STATUS TraceEndList( void* Context, size_t Offset ) { return AddToTrace( Context, "]", NULL, Offset ); }
+static JL_STATUS TraceNull( void* Context, size_t Offset ) { return AddToTrace( Context, "null", NULL, Offset ); }
+
+static
+JL_STATUS
+    TraceKey
+    (
+        void*           Context,
+        char const*     Text,
+        size_t          TextLength,
+        size_t          Offset
+    )
+{
+    ((EventTrace*)Context)->LastTextLength = TextLength;
+    return AddToTrace( Context, "K", Text, Offset );
+}
+
+static
+JL_STATUS
+    TraceString
+    (
+        void*           Context,
+        char const*     Text,
+        size_t          TextLength,
+        size_t          Offset
+    )
+{
+    ((EventTrace*)Context)->LastTextLength = TextLength;
+    return AddToTrace( Context, "S", Text, Offset );
+}
+
+static
+JL_STATUS
+    TraceNumber
+    (
+        void*           Context,
+        char const*     Text,
+        size_t          TextLength,
+        size_t          Offset
+    )
+{
+    EventTrace* trace = Context;
+    JL_STATUS jlStatus;
+
+    trace->LastTextLength = TextLength;
+    if(     NULL != trace->StopAtNumber
+        &&  strcmp( Text, trace->StopAtNumber ) == 0 )
+    {
+        jlStatus = JL_STATUS_NOT_FOUND;
+    }
+    else
+    {
+        jlStatus = AddToTrace( Context, "N", Text, Offset );
+    }
+
+    return jlStatus;
+}
+
+static
+JL_STATUS
+    TraceBool
+    (
+        void*           Context,
+        bool            Value,
+        size_t          Offset
+    )
+{
+    return AddToTrace( Context, "B", Value ? "true" : "false", Offset );
+}
+
+static JlParseCallbacks const gTraceCallbacks =
+{
+    TraceBeginDictionary,
+    TraceEndDictionary,
+    TraceBeginList,
+    TraceEndList,
+    TraceKey,
+    TraceString,
+    TraceNumber,
+    TraceBool,
+    TraceNull,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  BuilderAddObject
+//
+//  Adds an object to the list or dictionary at the top of the builder's stack, or makes it the root
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    BuilderAddObject
+    (
+        EventTreeBuilder*   Builder,
+        JlDataObject*       Object
+    )
+{
+    JL_STATUS jlStatus;
+
+    if( 0 == Builder->Depth )
+    {
+        Builder->Root = Object;
+        jlStatus = JL_STATUS_SUCCESS;
+    }
+    else
+    {
+        JlDataObject* parent = Builder->Stack[Builder->Depth-1];
+        if( JL_DATA_TYPE_LIST == JlGetObjectType( parent ) )
+        {
+            jlStatus = JlAttachObjectToListObject( parent, Object );
+        }
+        else
+        {
+            jlStatus = JlAttachObjectToDictionaryObject( parent, Builder->Key, Object );
+        }
+
+        if( JL_STATUS_SUCCESS != jlStatus )
+        {
+            (void) JlFreeObjectTree( &Object );
+        }
+    }
+
+    return jlStatus;
+}
+
+static
+JL_STATUS
+    BuilderBegin
+    (
+        EventTreeBuilder*   Builder,
+        JL_DATA_TYPE        Type
+    )
+{
+    JlDataObject* object = NULL;
+    JL_STATUS jlStatus = JlCreateObject( Type, &object );
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        jlStatus = BuilderAddObject( Builder, object );
+    }
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        Builder->Stack[Builder->Depth] = object;
+        Builder->Depth += 1;
+    }
+    return jlStatus;
+}
+
+static
+JL_STATUS
+    BuilderEnd
+    (
+        void*           Context,
+        size_t          Offset
+    )
+{
+    EventTreeBuilder* builder = Context;
+    (void)Offset;
+    builder->Depth -= 1;
+    return JL_STATUS_SUCCESS;
+}
+
+static JL_STATUS BuilderBeginDictionary( void* Context, size_t Offset ) { (void)Offset; return BuilderBegin( Context, JL_DATA_TYPE_DICTIONARY ); }
+static JL_STATUS BuilderBeginList( void* Context, size_t Offset ) { (void)Offset; return BuilderBegin( Context, JL_DATA_TYPE_LIST ); }
+
+static
+JL_STATUS
+    BuilderKey
+    (
+        void*           Context,
+        char const*     Text,
+        size_t          TextLength,
+        size_t          Offset
+    )
+{
+    EventTreeBuilder* builder = Context;
+    (void)Offset;
+    if( TextLength < sizeof(builder->Key) )
+    {
+        memcpy( builder->Key, Text, TextLength + 1 );
+    }
+    return JL_STATUS_SUCCESS;
+}
+
+static
+JL_STATUS
+    BuilderString
+    (
+        void*           Context,
+        char const*     Text,
+        size_t          TextLength,
+        size_t          Offset
+    )
+{
+    JlDataObject* object = NULL;
+    JL_STATUS jlStatus = JlCreateObject( JL_DATA_TYPE_STRING, &object );
+    (void)TextLength;
+    (void)Offset;
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        jlStatus = JlSetObjectString( object, Text );
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            jlStatus = BuilderAddObject( Context, object );
+        }
+        else
+        {
+            (void) JlFreeObjectTree( &object );
+        }
+    }
+    return jlStatus;
+}
+
+static
+JL_STATUS
+    BuilderNumber
+    (
+        void*           Context,
+        char const*     Text,
+        size_t          TextLength,
+        size_t          Offset
+    )
+{
+    JlDataObject* object = NULL;
+    JL_STATUS jlStatus = JlCreateObject( JL_DATA_TYPE_NUMBER, &object );
+    (void)TextLength;
+    (void)Offset;
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        jlStatus = JlSetObjectNumberString( object, Text );
+        if( JL_STATUS_SUCCESS == jlStatus )
+        {
+            jlStatus = BuilderAddObject( Context, object );
+        }
+        else
+        {
+            (void) JlFreeObjectTree( &object );
+        }
+    }
+    return jlStatus;
+}
+
+static
+JL_STATUS
+    BuilderBool
+    (
+        void*           Context,
+        bool            Value,
+        size_t          Offset
+    )
+{
+    JlDataObject* object = NULL;
+    JL_STATUS jlStatus = JlCreateObject( JL_DATA_TYPE_BOOL, &object );
+    (void)Offset;
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        (void) JlSetObjectBool( object, Value );
+        jlStatus = BuilderAddObject( Context, object );
+    }
+    return jlStatus;
+}
+
+static
+JL_STATUS
+    BuilderNull
+    (
+        void*           Context,
+        size_t          Offset
+    )
+{
+    JlDataObject* object = NULL;
+    JL_STATUS jlStatus = JlCreateObject( JL_DATA_TYPE_STRING, &object );
+    (void)Offset;
+    if( JL_STATUS_SUCCESS == jlStatus )
+    {
+        jlStatus = BuilderAddObject( Context, object );
+    }
+    return jlStatus;
+}
+
+static JlParseCallbacks const gBuilderCallbacks =
+{
+    BuilderBeginDictionary,
+    BuilderEnd,
+    BuilderBeginList,
+    BuilderEnd,
+    BuilderKey,
+    BuilderString,
+    BuilderNumber,
+    BuilderBool,
+    BuilderNull,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  AddTokenToTrace
+//
+//  Adds a token from JlReaderNext to a trace in the form <type>[:text]/<depth>@<offset>
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+void
+    AddTokenToTrace
+    (
+        EventTrace*     Trace,
+        JlToken const*  Token
+    )
+{
+    char const* names[] = { "?", "{", "}", "[", "]", "K", "S", "N", "B", "null" };
+    char const* name = ( (size_t)Token->Type < NumElements( names ) ) ? names[Token->Type] : "?";
+    char const* text = Token->Text;
+
+    if( JL_TOKEN_TYPE_BOOL == Token->Type )
+    {
+        text = Token->BoolValue ? "true" : "false";
+    }
+
+    Trace->TraceLength += snprintf(
+        Trace->Trace + Trace->TraceLength,
+        sizeof(Trace->Trace) - Trace->TraceLength,
+        "%s%s%s%s/%u@%u",
+        ( 0 == Trace->NumEvents ) ? "" : " ",
+        name,
+        ( NULL != text ) ? ":" : "",
+        ( NULL != text ) ? text : "",
+        (unsigned)Token->Depth,
+        (unsigned)Token->Offset );
+    Trace->NumEvents += 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ReadAllTokens
+//
+//  Reads the rest of the tokens from a reader into a trace. Returns the status of the final JlReaderNext call
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    ReadAllTokens
+    (
+        JlReader*       Reader,
+        EventTrace*     Trace
+    )
+{
+    JL_STATUS jlStatus;
+    JlToken token;
+
+    for( ;; )
+    {
+        jlStatus = JlReaderNext( Reader, &token, NULL );
+        if( JL_STATUS_SUCCESS != jlStatus )
+        {
+            break;
+        }
+        AddTokenToTrace( Trace, &token );
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  CheckEventsMatchTree
+//
+//  Builds a tree from the events for Json and checks that it outputs the same as the tree from JlParseJsonBuffer
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    CheckEventsMatchTree
+    (
+        bool            IsJson5,
+        char const*     Json
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    EventTreeBuilder builder;
+    JlDataObject* expectedTree = NULL;
+    char* expectedJson = NULL;
+    char* outputJson = NULL;
+
+    memset( &builder, 0, sizeof(builder) );
+    JL_ASSERT_SUCCESS( JlParseJsonBuffer( Json, strlen( Json ), IsJson5, &expectedTree, NULL ) );
+    JL_ASSERT_SUCCESS( JlOutputJson( expectedTree, false, &expectedJson ) );
+
+    JL_ASSERT_SUCCESS( JlParseJsonEvents( Json, strlen( Json ), IsJson5, &gBuilderCallbacks, &builder, NULL ) );
+    JL_ASSERT( 0 == builder.Depth );
+    JL_ASSERT_NOT_NULL( builder.Root );
+    JL_ASSERT_SUCCESS( JlOutputJson( builder.Root, false, &outputJson ) );
+    JL_ASSERT( NULL != outputJson  &&  NULL != expectedJson  &&  strcmp( outputJson, expectedJson ) == 0 );
+
+    JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &outputJson ) );
+    JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &expectedJson ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &builder.Root ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &expectedTree ) );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TEST FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestEventSequence
+//
+//  Tests the events and offsets sent for a document
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestEventSequence
+    (
+        void
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    EventTrace trace;
+    JlParseCallbacks noCallbacks = {0};
+    char const json1[] = "{\"a\":1,\"l\":[\"x\",true,null]}";
+    char const json5[] = "// x\n{a:0x1F, 'b':+5, c:[.5,],}";
+
+    memset( &trace, 0, sizeof(trace) );
+    JL_ASSERT_STATUS( JlParseJsonEvents( NULL, 0, false, &gTraceCallbacks, &trace, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParseJsonEvents( json1, sizeof(json1)-1, false, NULL, &trace, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserParseEvents( NULL, json1, sizeof(json1)-1, &gTraceCallbacks, &trace, NULL ), JL_STATUS_INVALID_PARAMETER );
+
+    JL_ASSERT_SUCCESS( JlParseJsonEvents( json1, sizeof(json1)-1, false, &gTraceCallbacks, &trace, NULL ) );
+    JL_ASSERT( strcmp( trace.Trace, "{@0 K:a@1 N:1@5 K:l@7 [@11 S:x@12 B:true@16 null@21 ]@25 }@26" ) == 0 );
+
+    memset( &trace, 0, sizeof(trace) );
+    JL_ASSERT_SUCCESS( JlParseJsonEvents( json5, sizeof(json5)-1, true, &gTraceCallbacks, &trace, NULL ) );
+    JL_ASSERT( strcmp( trace.Trace, "{@5 K:a@6 N:0x1F@8 K:b@14 N:5@18 K:c@22 [@24 N:.5@25 ]@28 }@30" ) == 0 );
+
+    // Root values
+    memset( &trace, 0, sizeof(trace) );
+    JL_ASSERT_SUCCESS( JlParseJsonEvents( " -12.5e3 ", 9, false, &gTraceCallbacks, &trace, NULL ) );
+    JL_ASSERT( strcmp( trace.Trace, "N:-12.5e3@1" ) == 0 );
+    JL_ASSERT( 7 == trace.LastTextLength );
+
+    // Strings are unescaped
+    memset( &trace, 0, sizeof(trace) );
+    JL_ASSERT_SUCCESS( JlParseJsonEvents( "[\"a\\u0000b\"]", 12, false, &gTraceCallbacks, &trace, NULL ) );
+    JL_ASSERT( 4 == trace.LastTextLength );
+    memset( &trace, 0, sizeof(trace) );
+    JL_ASSERT_SUCCESS( JlParseJsonEvents( "{\"k\\n\":\"\\u0041\"}", 16, false, &gTraceCallbacks, &trace, NULL ) );
+    JL_ASSERT( strcmp( trace.Trace, "{@0 K:k\n@1 S:A@7 }@15" ) == 0 );
+
+    // Repeated keys are passed through as there is no tree to detect them in
+    memset( &trace, 0, sizeof(trace) );
+    JL_ASSERT_SUCCESS( JlParseJsonEvents( "{\"a\":1,\"a\":2}", 13, false, &gTraceCallbacks, &trace, NULL ) );
+    JL_ASSERT( 6 == trace.NumEvents );
+
+    // Callbacks can be left out
+    JL_ASSERT_SUCCESS( JlParseJsonEvents( json1, sizeof(json1)-1, false, &noCallbacks, NULL, NULL ) );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestEventErrors
+//
+//  Tests that errors are reported the same as when building a tree, and that a callback can stop the parse
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestEventErrors
+    (
+        void
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    EventTrace trace;
+    JlDataObject* objectTree = NULL;
+    size_t errorAtPos = 0;
+    size_t expectedErrorAtPos = 0;
+    char const* invalid[] = {
+        "{\"a\":[1,2,}",
+        "[1,2",
+        "{\"a\" 1}",
+        "\"abc\\q\"",
+        "[tru]",
+        "[1] [2]",
+        "{,}",
+        "",
+        "[-]",
+        "[1e]",
+        "[1.]",
+        "[.5]",
+    };
+
+    memset( &trace, 0, sizeof(trace) );
+    for( size_t i=0; i<NumElements( invalid ); i++ )
+    {
+        size_t length = strlen( invalid[i] );
+        JL_STATUS expectedStatus = JlParseJsonBuffer( invalid[i], length, false, &objectTree, &expectedErrorAtPos );
+        JL_ASSERT( JL_STATUS_SUCCESS != expectedStatus );
+        JL_ASSERT_STATUS( JlParseJsonEvents( invalid[i], length, false, &gTraceCallbacks, &trace, &errorAtPos ), expectedStatus );
+        JL_ASSERT( errorAtPos == expectedErrorAtPos );
+    }
+
+    // Callback stops the parse
+    memset( &trace, 0, sizeof(trace) );
+    trace.StopAtNumber = "2";
+    JL_ASSERT_STATUS( JlParseJsonEvents( "[1,2,3]", 7, false, &gTraceCallbacks, &trace, &errorAtPos ), JL_STATUS_NOT_FOUND );
+    JL_ASSERT( 3 == errorAtPos );
+    JL_ASSERT( strcmp( trace.Trace, "[@0 N:1@1" ) == 0 );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestEventsMatchTree
+//
+//  Tests that the events describe the same data as the tree parser produces
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestEventsMatchTree
+    (
+        void
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    char const* documents[] = {
+        "{\"a\":[1,-2.5e+3,true,false,null],\"key\\\"x\":\"esc \\\\ \\/ \\n \\u0041\\ud83d\\ude00\",\"n\":{\"deep\":[[],{}]}}",
+        "[12345678901234, 0.000001, -1, \"\", \"null\"]",
+        "[[[[[[[[[[\"nested\"]]]]]]]]]]",
+        "123",
+        "null",
+    };
+    char const* documents5[] = {
+        "{a:1, 'b':'single \\\r\n quoted', /* c */ c:[0x1F, +5, .5, 5.,], // end\n d:\"\\t\"}",
+        "// comment\n[1,2,3,] /* trailing */",
+        "{$_x1:'\\u0041', list:[{},[],{a:[]}]}",
+    };
+
+    for( size_t i=0; i<NumElements( documents ); i++ )
+    {
+        JL_ASSERT_SUCCESS( CheckEventsMatchTree( false, documents[i] ) );
+        JL_ASSERT_SUCCESS( CheckEventsMatchTree( true, documents[i] ) );
+    }
+    for( size_t i=0; i<NumElements( documents5 ); i++ )
+    {
+        JL_ASSERT_SUCCESS( CheckEventsMatchTree( true, documents5[i] ) );
+    }
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestEventsNoAllocation
+//
+//  Tests that parsing with events on a parser that has already been used makes no allocations
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestEventsNoAllocation
+    (
+        void
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlParser* parser = NULL;
+    EventTrace trace;
+    uint64_t allocsBefore = 0;
+    uint64_t allocsAfter = 0;
+    char const json[] = "{\"list\":[1,2,3,{\"a\":\"a string value\",\"b\":[true,false,null]}],\"n\":-1.5e10,\"s\":\"\\u0041\"}";
+
+    memset( &trace, 0, sizeof(trace) );
+    JL_ASSERT_SUCCESS( JlParserCreate( JL_PARSE_FLAGS_NONE, &parser ) );
+
+    // First parse sizes the scratch buffers
+    JL_ASSERT_SUCCESS( JlParserParseEvents( parser, json, sizeof(json)-1, &gTraceCallbacks, &trace, NULL ) );
+
+    WjTestLib_Memory_GetStats( &allocsBefore, NULL, NULL );
+    for( int i=0; i<10; i++ )
+    {
+        memset( &trace, 0, sizeof(trace) );
+        JL_ASSERT_SUCCESS( JlParserParseEvents( parser, json, sizeof(json)-1, &gTraceCallbacks, &trace, NULL ) );
+        JL_ASSERT( 22 == trace.NumEvents );
+    }
+    WjTestLib_Memory_GetStats( &allocsAfter, NULL, NULL );
+    JL_ASSERT( allocsBefore == allocsAfter );
+
+    JL_ASSERT_SUCCESS( JlParserFree( &parser ) );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestReaderTokens
+//
+//  Tests the tokens, depths, and offsets returned by JlReaderNext
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestReaderTokens
+    (
+        void
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlReader* reader = NULL;
+    JlReader* reader5 = NULL;
+    EventTrace trace;
+    JlToken token;
+    char const json1[] = "{\"a\":1,\"l\":[\"x\",true,null,{}]}";
+    char const json5[] = "// x\n{a:0x1F, 'b':[+5,], }";
+
+    memset( &trace, 0, sizeof(trace) );
+    JL_ASSERT_STATUS( JlReaderCreate( JL_PARSE_FLAGS_NONE, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_SUCCESS( JlReaderCreate( JL_PARSE_FLAGS_NONE, &reader ) );
+    JL_ASSERT_SUCCESS( JlReaderCreate( JL_PARSE_FLAGS_JSON5, &reader5 ) );
+    JL_ASSERT_STATUS( JlReaderStart( NULL, json1, 1 ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlReaderStart( reader, NULL, 1 ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlReaderNext( NULL, &token, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlReaderNext( reader, NULL, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlReaderSkipValue( NULL, NULL ), JL_STATUS_INVALID_PARAMETER );
+
+    // Nothing to read before JlReaderStart
+    JL_ASSERT_STATUS( JlReaderNext( reader, &token, NULL ), JL_STATUS_END_OF_DATA );
+
+    JL_ASSERT_SUCCESS( JlReaderStart( reader, json1, sizeof(json1)-1 ) );
+    JL_ASSERT_STATUS( ReadAllTokens( reader, &trace ), JL_STATUS_END_OF_DATA );
+    JL_ASSERT( strcmp( trace.Trace, "{/0@0 K:a/1@1 N:1/1@5 K:l/1@7 [/1@11 S:x/2@12 B:true/2@16 null/2@21 {/2@26 }/2@27 ]/1@28 }/0@29" ) == 0 );
+    JL_ASSERT_STATUS( JlReaderNext( reader, &token, NULL ), JL_STATUS_END_OF_DATA );
+
+    memset( &trace, 0, sizeof(trace) );
+    JL_ASSERT_SUCCESS( JlReaderStart( reader5, json5, sizeof(json5)-1 ) );
+    JL_ASSERT_STATUS( ReadAllTokens( reader5, &trace ), JL_STATUS_END_OF_DATA );
+    JL_ASSERT( strcmp( trace.Trace, "{/0@5 K:a/1@6 N:0x1F/1@8 K:b/1@14 [/1@18 N:5/2@19 ]/1@22 }/0@25" ) == 0 );
+
+    // Root values. The buffer does not need to be terminated
+    memset( &trace, 0, sizeof(trace) );
+    JL_ASSERT_SUCCESS( JlReaderStart( reader, " \"abc\"XXXX", 6 ) );
+    JL_ASSERT_STATUS( ReadAllTokens( reader, &trace ), JL_STATUS_END_OF_DATA );
+    JL_ASSERT( strcmp( trace.Trace, "S:abc/0@1" ) == 0 );
+    memset( &trace, 0, sizeof(trace) );
+    JL_ASSERT_SUCCESS( JlReaderStart( reader, "-12.5e3", 7 ) );
+    JL_ASSERT_STATUS( ReadAllTokens( reader, &trace ), JL_STATUS_END_OF_DATA );
+    JL_ASSERT( strcmp( trace.Trace, "N:-12.5e3/0@0" ) == 0 );
+
+    // Starting again abandons the current document
+    memset( &trace, 0, sizeof(trace) );
+    JL_ASSERT_SUCCESS( JlReaderStart( reader, json1, sizeof(json1)-1 ) );
+    JL_ASSERT_SUCCESS( JlReaderNext( reader, &token, NULL ) );
+    JL_ASSERT_SUCCESS( JlReaderNext( reader, &token, NULL ) );
+    JL_ASSERT_SUCCESS( JlReaderStart( reader, "[1]", 3 ) );
+    JL_ASSERT_STATUS( ReadAllTokens( reader, &trace ), JL_STATUS_END_OF_DATA );
+    JL_ASSERT( strcmp( trace.Trace, "[/0@0 N:1/1@1 ]/0@2" ) == 0 );
+
+    JL_ASSERT_SUCCESS( JlReaderFree( &reader ) );
+    JL_ASSERT( NULL == reader );
+    JL_ASSERT_SUCCESS( JlReaderFree( &reader5 ) );
+    JL_ASSERT_STATUS( JlReaderFree( &reader ), JL_STATUS_INVALID_PARAMETER );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestReaderSkipValue
+//
+//  Tests skipping values with JlReaderSkipValue
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestReaderSkipValue
+    (
+        void
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlReader* reader = NULL;
+    EventTrace trace;
+    JlToken token;
+    char const json[] = "{\"a\":{\"x\":[1,[2]],\"y\":2},\"b\":[3,4],\"c\":5}";
+    char const nested[] = "{\"s\":{\"k\\\"]\":[\"}\\\\\",[\"][\",\"[{\"]]},\"t\":{\"z\":[[]]},\"n\":7}";
+
+    memset( &trace, 0, sizeof(trace) );
+    JL_ASSERT_SUCCESS( JlReaderCreate( JL_PARSE_FLAGS_NONE, &reader ) );
+
+    // Skip the value of a key just read
+    JL_ASSERT_SUCCESS( JlReaderStart( reader, json, sizeof(json)-1 ) );
+    JL_ASSERT_SUCCESS( JlReaderNext( reader, &token, NULL ) );
+    JL_ASSERT_SUCCESS( JlReaderNext( reader, &token, NULL ) );
+    JL_ASSERT( JL_TOKEN_TYPE_KEY == token.Type );
+    JL_ASSERT_SUCCESS( JlReaderSkipValue( reader, NULL ) );
+    JL_ASSERT_STATUS( ReadAllTokens( reader, &trace ), JL_STATUS_END_OF_DATA );
+    JL_ASSERT( strcmp( trace.Trace, "K:b/1@25 [/1@29 N:3/2@30 N:4/2@32 ]/1@33 K:c/1@35 N:5/1@39 }/0@40" ) == 0 );
+
+    // Skip a key and its value
+    memset( &trace, 0, sizeof(trace) );
+    JL_ASSERT_SUCCESS( JlReaderStart( reader, json, sizeof(json)-1 ) );
+    JL_ASSERT_SUCCESS( JlReaderNext( reader, &token, NULL ) );
+    JL_ASSERT_SUCCESS( JlReaderNext( reader, &token, NULL ) );
+    JL_ASSERT_SUCCESS( JlReaderSkipValue( reader, NULL ) );
+    JL_ASSERT_SUCCESS( JlReaderSkipValue( reader, NULL ) );
+    JL_ASSERT_STATUS( ReadAllTokens( reader, &trace ), JL_STATUS_END_OF_DATA );
+    JL_ASSERT( strcmp( trace.Trace, "K:c/1@35 N:5/1@39 }/0@40" ) == 0 );
+
+    // Skip the rest of a container that has been started
+    memset( &trace, 0, sizeof(trace) );
+    JL_ASSERT_SUCCESS( JlReaderStart( reader, json, sizeof(json)-1 ) );
+    JL_ASSERT_SUCCESS( JlReaderNext( reader, &token, NULL ) );
+    JL_ASSERT_SUCCESS( JlReaderNext( reader, &token, NULL ) );
+    JL_ASSERT_SUCCESS( JlReaderNext( reader, &token, NULL ) );
+    JL_ASSERT( JL_TOKEN_TYPE_BEGIN_DICTIONARY == token.Type );
+    JL_ASSERT_SUCCESS( JlReaderSkipValue( reader, NULL ) );
+    JL_ASSERT_SUCCESS( JlReaderNext( reader, &token, NULL ) );
+    JL_ASSERT( JL_TOKEN_TYPE_KEY == token.Type && strcmp( token.Text, "b" ) == 0 );
+
+    // Nothing to skip at the end of a list. The end token is still returned
+    JL_ASSERT_SUCCESS( JlReaderNext( reader, &token, NULL ) );
+    JL_ASSERT_SUCCESS( JlReaderNext( reader, &token, NULL ) );
+    JL_ASSERT_SUCCESS( JlReaderSkipValue( reader, NULL ) );
+    JL_ASSERT_STATUS( JlReaderSkipValue( reader, NULL ), JL_STATUS_NOT_FOUND );
+    JL_ASSERT_STATUS( JlReaderSkipValue( reader, NULL ), JL_STATUS_NOT_FOUND );
+    JL_ASSERT_SUCCESS( JlReaderNext( reader, &token, NULL ) );
+    JL_ASSERT( JL_TOKEN_TYPE_END_LIST == token.Type && 33 == token.Offset );
+
+    // Brackets and escaped quotes in the strings of a skipped value do not end it early, and reading carries on at the
+    // right position and depth
+    JL_ASSERT_SUCCESS( JlReaderStart( reader, nested, sizeof(nested)-1 ) );
+    JL_ASSERT_SUCCESS( JlReaderNext( reader, &token, NULL ) );
+    JL_ASSERT_SUCCESS( JlReaderNext( reader, &token, NULL ) );
+    JL_ASSERT_SUCCESS( JlReaderSkipValue( reader, NULL ) );
+    JL_ASSERT_SUCCESS( JlReaderNext( reader, &token, NULL ) );
+    JL_ASSERT( JL_TOKEN_TYPE_KEY == token.Type && 34 == token.Offset && 1 == token.Depth );
+    JL_ASSERT_SUCCESS( JlReaderNext( reader, &token, NULL ) );
+    JL_ASSERT( JL_TOKEN_TYPE_BEGIN_DICTIONARY == token.Type && 38 == token.Offset && 1 == token.Depth );
+    JL_ASSERT_SUCCESS( JlReaderSkipValue( reader, NULL ) );
+    JL_ASSERT_SUCCESS( JlReaderNext( reader, &token, NULL ) );
+    JL_ASSERT( JL_TOKEN_TYPE_KEY == token.Type && 49 == token.Offset && 1 == token.Depth );
+    JL_ASSERT_SUCCESS( JlReaderNext( reader, &token, NULL ) );
+    JL_ASSERT( JL_TOKEN_TYPE_NUMBER == token.Type && 53 == token.Offset && 1 == token.Depth );
+    JL_ASSERT_SUCCESS( JlReaderNext( reader, &token, NULL ) );
+    JL_ASSERT( JL_TOKEN_TYPE_END_DICTIONARY == token.Type && 54 == token.Offset && 0 == token.Depth );
+    JL_ASSERT_STATUS( JlReaderNext( reader, &token, NULL ), JL_STATUS_END_OF_DATA );
+
+    // Skipping the whole root value
+    JL_ASSERT_SUCCESS( JlReaderStart( reader, json, sizeof(json)-1 ) );
+    JL_ASSERT_SUCCESS( JlReaderSkipValue( reader, NULL ) );
+    JL_ASSERT_STATUS( JlReaderNext( reader, &token, NULL ), JL_STATUS_END_OF_DATA );
+    JL_ASSERT_STATUS( JlReaderSkipValue( reader, NULL ), JL_STATUS_END_OF_DATA );
+
+    JL_ASSERT_SUCCESS( JlReaderFree( &reader ) );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestReaderErrors
+//
+//  Tests that the reader reports errors in the same place as JlParseJsonBuffer, and keeps reporting them
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestReaderErrors
+    (
+        void
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlReader* reader = NULL;
+    EventTrace trace;
+    JlToken token;
+    JlDataObject* object = NULL;
+    size_t errorAtPos = 0;
+    size_t readerErrorAtPos = 0;
+    char const* badDocuments[] = {
+        "{\"a\":1,}",
+        "[1,2",
+        "{\"a\" 1}",
+        "[1,2] [3]",
+        "{\"a\":tru}",
+        "",
+        "[\"abc",
+        "{'a':1}",
+        "[-]",
+        "[1e]",
+        "{\"a\":1.}",
+        "[.5]",
+    };
+
+    memset( &trace, 0, sizeof(trace) );
+    JL_ASSERT_SUCCESS( JlReaderCreate( JL_PARSE_FLAGS_NONE, &reader ) );
+
+    for( size_t i=0; i<NumElements( badDocuments ); i++ )
+    {
+        size_t length = strlen( badDocuments[i] );
+        JL_STATUS jlStatus;
+
+        JL_ASSERT( JL_STATUS_SUCCESS != JlParseJsonBuffer( badDocuments[i], length, false, &object, &errorAtPos ) );
+        JL_ASSERT_SUCCESS( JlReaderStart( reader, badDocuments[i], length ) );
+        do
+        {
+            jlStatus = JlReaderNext( reader, &token, &readerErrorAtPos );
+        } while( JL_STATUS_SUCCESS == jlStatus );
+        JL_ASSERT( JL_STATUS_SUCCESS != jlStatus );
+        JL_ASSERT( JL_STATUS_END_OF_DATA != jlStatus );
+        JL_ASSERT( errorAtPos == readerErrorAtPos );
+
+        // The error is sticky
+        readerErrorAtPos = 0;
+        JL_ASSERT_STATUS( JlReaderNext( reader, &token, &readerErrorAtPos ), jlStatus );
+        JL_ASSERT( errorAtPos == readerErrorAtPos );
+        JL_ASSERT_STATUS( JlReaderSkipValue( reader, NULL ), jlStatus );
+    }
+
+    // Tokens before the error are returned
+    JL_ASSERT_SUCCESS( JlReaderStart( reader, "[1,2", 4 ) );
+    JL_ASSERT_STATUS( ReadAllTokens( reader, &trace ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT( strcmp( trace.Trace, "[/0@0 N:1/1@1 N:2/1@3" ) == 0 );
+
+    // Errors found while skipping are returned. Only the strings and brackets of a skipped value are checked, so
+    // anything else wrong within it is not found.
+    JL_ASSERT_SUCCESS( JlReaderStart( reader, "[[1,\"ab]", 8 ) );
+    JL_ASSERT_SUCCESS( JlReaderNext( reader, &token, NULL ) );
+    JL_ASSERT_STATUS( JlReaderSkipValue( reader, &readerErrorAtPos ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT( 8 == readerErrorAtPos );
+    JL_ASSERT_STATUS( JlReaderNext( reader, &token, NULL ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT_SUCCESS( JlReaderStart( reader, "{\"a\":[1,[2]", 12 ) );
+    JL_ASSERT_SUCCESS( JlReaderNext( reader, &token, NULL ) );
+    JL_ASSERT_STATUS( JlReaderSkipValue( reader, &readerErrorAtPos ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT( 12 == readerErrorAtPos );
+    JL_ASSERT_SUCCESS( JlReaderStart( reader, "[[1,}]", 6 ) );
+    JL_ASSERT_SUCCESS( JlReaderNext( reader, &token, NULL ) );
+    JL_ASSERT_SUCCESS( JlReaderSkipValue( reader, NULL ) );
+    JL_ASSERT_STATUS( JlReaderNext( reader, &token, NULL ), JL_STATUS_END_OF_DATA );
+
+    JL_ASSERT_SUCCESS( JlReaderFree( &reader ) );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestReaderNoAllocation
+//
+//  Tests that reading with a reader that has already been used makes no allocations
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestReaderNoAllocation
+    (
+        void
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlReader* reader = NULL;
+    EventTrace trace;
+    uint64_t allocsBefore = 0;
+    uint64_t allocsAfter = 0;
+    char const json[] = "{\"list\":[1,2,3,{\"a\":\"a string value\",\"b\":[true,false,null]}],\"n\":-1.5e10,\"s\":\"\\u0041\"}";
+
+    memset( &trace, 0, sizeof(trace) );
+    JL_ASSERT_SUCCESS( JlReaderCreate( JL_PARSE_FLAGS_NONE, &reader ) );
+
+    // First read sizes the scratch buffers
+    JL_ASSERT_SUCCESS( JlReaderStart( reader, json, sizeof(json)-1 ) );
+    JL_ASSERT_STATUS( ReadAllTokens( reader, &trace ), JL_STATUS_END_OF_DATA );
+
+    WjTestLib_Memory_GetStats( &allocsBefore, NULL, NULL );
+    for( int i=0; i<10; i++ )
+    {
+        memset( &trace, 0, sizeof(trace) );
+        JL_ASSERT_SUCCESS( JlReaderStart( reader, json, sizeof(json)-1 ) );
+        JL_ASSERT_STATUS( ReadAllTokens( reader, &trace ), JL_STATUS_END_OF_DATA );
+        JL_ASSERT( 22 == trace.NumEvents );
+    }
+    WjTestLib_Memory_GetStats( &allocsAfter, NULL, NULL );
+    JL_ASSERT( allocsBefore == allocsAfter );
+
+    JL_ASSERT_SUCCESS( JlReaderFree( &reader ) );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  PUBLIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  JsonLibTests_Events_Register
+//
+//  Registers the tests with WjTestLib
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+    JsonLibTests_Events_Register
+    (
+        void
+    )
+{
+    WjTestLib_NewGroup( "Events" );
+    WjTestLib_AddTest( TestEventSequence, "Event sequence" );
+    WjTestLib_AddTest( TestEventErrors, "Event errors" );
+    WjTestLib_AddTest( TestEventsMatchTree, "Events match tree" );
+    WjTestLib_AddTest( TestEventsNoAllocation, "Events without allocation" );
+    WjTestLib_AddTest( TestReaderTokens, "Reader tokens" );
+    WjTestLib_AddTest( TestReaderSkipValue, "Reader skip value" );
+    WjTestLib_AddTest( TestReaderErrors, "Reader errors" );
+    WjTestLib_AddTest( TestReaderNoAllocation, "Reader without allocation" );
+}
@@ -545,6 +545,61 @@ WJTL_STATUS
     return TestReturn;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestEscaping
+//
+//  Tests that strings and key names are escaped when needed, and copied as they are when not
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestEscaping
+    (
+        void
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+
+    JlDataObject* dictionaryObject = NULL;
+    JlDataObject* stringObject = NULL;
+
+    JL_ASSERT_SUCCESS( JlCreateObject( JL_DATA_TYPE_DICTIONARY, &dictionaryObject ) );
+    JL_ASSERT_SUCCESS( JlAddStringToDictionaryObject( dictionaryObject, "plain key",
+        "a plain string longer than a block" ) );
+    JL_ASSERT_SUCCESS( JlAddStringToDictionaryObject( dictionaryObject, "quote\"key", "it's" ) );
+    JL_ASSERT_SUCCESS( JlAddStringToDictionaryObject( dictionaryObject, "tab\tkey",
+        "caf\xc3\xa9 \"x\" then a long plain run" ) );
+
+    JL_ASSERT_SUCCESS( CreateJsonAndVerifyEx( dictionaryObject, JL_OUTPUT_FLAGS_NONE,
+        "{\"plain key\":\"a plain string longer than a block\","
+        "\"quote\\\"key\":\"it's\","
+        "\"tab\\tkey\":\"caf\xc3\xa9 \\\"x\\\" then a long plain run\"}" ) );
+
+    JL_ASSERT_SUCCESS( CreateJsonAndVerifyEx( dictionaryObject, JL_OUTPUT_FLAGS_J5_SINGLE_QUOTES,
+        "{'plain key':'a plain string longer than a block',"
+        "'quote\\\"key':'it\\'s',"
+        "'tab\\tkey':'caf\xc3\xa9 \\\"x\\\" then a long plain run'}" ) );
+
+    JL_ASSERT_SUCCESS( CreateJsonAndVerifyEx( dictionaryObject, JL_OUTPUT_FLAGS_ASCII,
+        "{\"plain key\":\"a plain string longer than a block\","
+        "\"quote\\\"key\":\"it's\","
+        "\"tab\\tkey\":\"caf\\u00e9 \\\"x\\\" then a long plain run\"}" ) );
+
+    // Setting a string again changes whether it needs escaping
+    JL_ASSERT_SUCCESS( JlGetObjectFromDictionaryByKey( dictionaryObject, "plain key", &stringObject ) );
+    JL_ASSERT_SUCCESS( JlSetObjectString( stringObject, "now with a \\ backslash" ) );
+    JL_ASSERT_SUCCESS( JlGetObjectFromDictionaryByKey( dictionaryObject, "quote\"key", &stringObject ) );
+    JL_ASSERT_SUCCESS( JlSetObjectString( stringObject, "its" ) );
+
+    JL_ASSERT_SUCCESS( CreateJsonAndVerifyEx( dictionaryObject, JL_OUTPUT_FLAGS_J5_SINGLE_QUOTES,
+        "{'plain key':'now with a \\\\ backslash',"
+        "'quote\\\"key':'its',"
+        "'tab\\tkey':'caf\xc3\xa9 \\\"x\\\" then a long plain run'}" ) );
+
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &dictionaryObject ) );
+
+    return TestReturn;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  PUBLIC FUNCTIONS
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -567,4 +622,5 @@ void
     WjTestLib_AddTest( TestLists, "Lists" );
     WjTestLib_AddTest( TestDictionaries, "Dictionaries" );
     WjTestLib_AddTest( TestOutputFormats, "OutputFormats" );
+    WjTestLib_AddTest( TestEscaping, "Escaping" );
 }
@@ -14,9 +14,43 @@
 #include <stdlib.h>
 #include <float.h>
 #include <math.h>
+#include <string.h>
 #include "JsonLib.h"
 #include "JsonLibTests.h"
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  MACROS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define NumElements( Array )    ( sizeof(Array) / sizeof((Array)[0]) )
+
+// Every NDJSON_BAD_LINE_INTERVAL lines of the NDJSON test data is invalid
+#define NDJSON_NUM_LINES            25000
+#define NDJSON_BAD_LINE_INTERVAL    997
+
+// Written and removed again by TestParseFile
+#define PARSE_FILE_TEST_FILENAME    "JsonLibTests_ParseFile.json"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TYPES
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Records the documents passed to the JlParseNdjsonParallel callback. The test data has lines all of LineLength
+// bytes with the line number as the "id" so each document can be checked against its position.
+typedef struct
+{
+    size_t          LineLength;
+    bool            InOrder;
+    size_t          StopAfter;              // If not 0 then the callback fails once this many documents are seen
+    size_t          NumDocuments;
+    size_t          NumErrors;
+    size_t          LastOffset;
+    bool            OutOfOrder;
+    bool            Mismatch;
+    bool            Seen[NDJSON_NUM_LINES];
+    JlDataObject*   KeptObject;             // The first good document is taken by the callback
+} NdjsonRecord;
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  TEST FUNCTIONS
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -145,6 +179,28 @@ WJTL_STATUS
     JL_ASSERT_SUCCESS( VerifyJsonParsesAsStringObject( IsJson5, "\"\\uD83D\\uDE01\"", "\xF0\x9F\x98\x81" ) );    // smiley face emoji
     JL_ASSERT_SUCCESS( VerifyJsonParsesAsStringObject( IsJson5, "null", NULL ) );
 
+    // UTF8 characters are passed through as they are
+    JL_ASSERT_SUCCESS( VerifyJsonParsesAsStringObject( IsJson5, "\"caf\xc3\xa9 \xF0\x9F\x98\x81\"", "caf\xc3\xa9 \xF0\x9F\x98\x81" ) );
+
+    // Long strings are scanned in blocks. Put an escape, and then a control character, at every position within
+    // several blocks to check the blocks end in the right place.
+    for( size_t pos=0; pos<40; pos++ )
+    {
+        char json[64] = {0};
+        char expected[64] = {0};
+        memset( json, 'a', 49 );
+        memset( expected, 'a', 47 );
+        json[0] = '\"';
+        json[1+pos] = '\\';
+        json[2+pos] = '\"';
+        json[49] = '\"';
+        expected[pos] = '\"';
+        JL_ASSERT_SUCCESS( VerifyJsonParsesAsStringObject( IsJson5, json, expected ) );
+
+        json[1+pos] = '\t';
+        JL_ASSERT_SUCCESS( VerifyJsonUnableToParse( IsJson5, json, 1+pos ) );
+    }
+
     // Test valid objects that are not strings
     JL_ASSERT_SUCCESS( VerifyJsonNotString( IsJson5, "1234" ) );
     JL_ASSERT_SUCCESS( VerifyJsonNotString( IsJson5, "true" ) );
@@ -157,6 +213,7 @@ WJTL_STATUS
     {
         JL_ASSERT_SUCCESS( VerifyJsonParsesAsStringObject( IsJson5, "'SingleString'", "SingleString" ) );
         JL_ASSERT_SUCCESS( VerifyJsonParsesAsStringObject( IsJson5, "'Single\"String'", "Single\"String" ) );
+        JL_ASSERT_SUCCESS( VerifyJsonParsesAsStringObject( IsJson5, "'A \"long\" single quoted string, with \\'quotes\\' inside'", "A \"long\" single quoted string, with 'quotes' inside" ) );
         JL_ASSERT_SUCCESS( VerifyJsonParsesAsStringObject( IsJson5, "\"Split\\\nString\"", "SplitString" ) );  // escaped new line in string
         JL_ASSERT_SUCCESS( VerifyJsonParsesAsStringObject( IsJson5, "\"Split\\\r\\\nString\"", "SplitString" ) );  // fully escaped cr and lf in string
         JL_ASSERT_SUCCESS( VerifyJsonParsesAsStringObject( IsJson5, "\"Windows\\\r\nNewLine\"", "WindowsNewLine" ) );  // windows escaped crlf
@@ -361,6 +418,19 @@ WJTL_STATUS
     JL_ASSERT_SUCCESS( VerifyJsonParsesAsNumberObjectFloat( IsJson5, "1.7976931348623158e308", DBL_MAX ) );
     JL_ASSERT_SUCCESS( VerifyJsonParsesAsNumberObjectFloat( IsJson5, "1.7976931348623158e+308", DBL_MAX ) );
     JL_ASSERT_SUCCESS( VerifyJsonParsesAsNumberObjectFloat( IsJson5, "2.2250738585072014e-308", DBL_MIN ) );
+    JL_ASSERT_SUCCESS( VerifyJsonParsesAsNumberObjectFloat( IsJson5, "4.9406564584124654e-324", 4.9406564584124654e-324 ) );
+
+    // Floats must be correctly rounded, including values that need more digits than fit in 64 bits
+    JL_ASSERT_SUCCESS( VerifyJsonParsesAsNumberObjectFloat( IsJson5, "0.1", 0.1 ) );
+    JL_ASSERT_SUCCESS( VerifyJsonParsesAsNumberObjectFloat( IsJson5, "0.30000000000000004", 0.30000000000000004 ) );
+    JL_ASSERT_SUCCESS( VerifyJsonParsesAsNumberObjectFloat( IsJson5, "-122.419416", -122.419416 ) );
+    JL_ASSERT_SUCCESS( VerifyJsonParsesAsNumberObjectFloat( IsJson5, "1e22", 1e22 ) );
+    JL_ASSERT_SUCCESS( VerifyJsonParsesAsNumberObjectFloat( IsJson5, "1e23", 1e23 ) );
+    JL_ASSERT_SUCCESS( VerifyJsonParsesAsNumberObjectFloat( IsJson5, "9007199254740993.0", 9007199254740992.0 ) );   // Halfway, rounds to even
+    JL_ASSERT_SUCCESS( VerifyJsonParsesAsNumberObjectFloat( IsJson5, "9007199254740993.0000000000000000001", 9007199254740994.0 ) );
+    JL_ASSERT_SUCCESS( VerifyJsonParsesAsNumberObjectFloat( IsJson5, "0.1000000000000000055511151231257827021181583404541015625", 0.1 ) );
+    JL_ASSERT_SUCCESS( VerifyJsonParsesAsNumberObjectFloat( IsJson5, "1234567890123456789012345678901234567890", 1234567890123456789012345678901234567890.0 ) );
+    JL_ASSERT_SUCCESS( VerifyJsonParsesAsNumberObjectUnsigned( IsJson5, "9007199254740993", 9007199254740993ULL ) );
 
     // Very large integers will be treated as floating point if they can't be represented in a uint64_t or int64_t.
     // Verify that it gets rounded to correct float
@@ -1109,6 +1179,15 @@ WJTL_STATUS
     JL_ASSERT_NULL( object );
     JL_ASSERT( 0 == errorAtPos );
 
+    // Unfinished dictionary with no key is reported at the opening bracket
+    JL_ASSERT_STATUS( JlParseJsonEx( "  {  ", IsJson5, &object, &errorAtPos ), JL_STATUS_END_OF_DATA );
+    JL_ASSERT_NULL( object );
+    JL_ASSERT( 2 == errorAtPos );
+
+    JL_ASSERT_STATUS( JlParseJsonEx( "[1,{", IsJson5, &object, &errorAtPos ), JL_STATUS_END_OF_DATA );
+    JL_ASSERT_NULL( object );
+    JL_ASSERT( 3 == errorAtPos );
+
     return TestReturn;
 }
 
@@ -1280,6 +1359,35 @@ WJTL_STATUS
         JL_ASSERT_SUCCESS( VerifyJsonUnableToParse( IsJson5, " 1\xef\xbb\xbf", 1 ) );   // Byte order mark
     }
 
+    // Runs of white space of every length up to several 16 byte blocks, so that runs end at every position within a
+    // block and in the remainder after the last whole block.
+    for( size_t runLength=0; runLength<=40; runLength++ )
+    {
+        char json[256] = {0};
+        size_t length = 0;
+
+        json[length++] = '[';
+        for( size_t i=0; i<runLength; i++ )
+        {
+            json[length++] = " \t\r\n"[i%4];
+        }
+        json[length++] = '1';
+        json[length++] = ',';
+        memset( json+length, ' ', runLength );
+        length += runLength;
+        json[length++] = '2';
+        memset( json+length, '\n', runLength );
+        length += runLength;
+        json[length++] = ']';
+        memset( json+length, ' ', runLength );
+        length += runLength;
+        JL_ASSERT_SUCCESS( VerifyJsonParsesAsListOfNumbers( IsJson5, json, (uint64_t[]){1,2}, 2 ) );
+
+        // Error positions after a run are still correct
+        json[length++] = 'x';
+        JL_ASSERT_SUCCESS( VerifyJsonUnableToParse( IsJson5, json+length-runLength-1, runLength ) );
+    }
+
     // Now try a more complicated object with all the white spaces used
     #define WSP1 " \t\r\n"
     #define WSP5 " \t\r\n\xc2\xa0 \xe2\x80\xa8 \xe2\x80\xa9 \xef\xbb\xbf"
@@ -1364,6 +1472,2377 @@ WJTL_STATUS
     return TestReturn;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ParseFromExactBuffer
+//
+//  Copies the first BufferLength bytes of Json into an allocation of exactly that size (no zero terminator) and
+//  parses it with JlParseJsonBuffer.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    ParseFromExactBuffer
+    (
+        bool            IsJson5,
+        char const*     Json,
+        size_t          BufferLength,
+        JlDataObject**  pObject
+    )
+{
+    JL_STATUS jlStatus;
+    size_t errorAtPos = 0;
+    char* buffer = malloc( BufferLength > 0 ? BufferLength : 1 );
+
+    if( NULL != buffer )
+    {
+        memcpy( buffer, Json, BufferLength );
+        jlStatus = JlParseJsonBuffer( buffer, BufferLength, IsJson5, pObject, &errorAtPos );
+        free( buffer );
+    }
+    else
+    {
+        jlStatus = JL_STATUS_OUT_OF_MEMORY;
+    }
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestParseBuffer
+//
+//  Tests parsing from a length delimited buffer that is not zero terminated
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestParseBuffer
+    (
+        bool        IsJson5
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlDataObject* objectTree = NULL;
+    JlDataObject* object = NULL;
+    uint64_t u64 = 0;
+    char const* stringPtr = NULL;
+    size_t errorAtPos = 100;
+    char const json[] = "{\"a\":[1,2,3],\"b\":\"x\\u0041y\",\"c\":true}";
+
+    JL_ASSERT_STATUS( JlParseJsonBuffer( NULL, 0, IsJson5, &objectTree, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParseJsonBuffer( json, sizeof( json ) - 1, IsJson5, NULL, NULL ), JL_STATUS_INVALID_PARAMETER );
+
+    // Whole document in an exact sized buffer
+    JL_ASSERT_SUCCESS( ParseFromExactBuffer( IsJson5, json, sizeof( json ) - 1, &objectTree ) );
+    JL_ASSERT_NOT_NULL( objectTree );
+    JL_ASSERT_SUCCESS( JlGetObjectFromDictionaryByKey( objectTree, "b", &object ) );
+    JL_ASSERT_SUCCESS( JlGetObjectString( object, &stringPtr ) );
+    JL_ASSERT( strcmp( stringPtr, "xAy" ) == 0 );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+    // Length shorter than the text. Only the given bytes are parsed
+    JL_ASSERT_SUCCESS( ParseFromExactBuffer( IsJson5, "12345", 3, &objectTree ) );
+    JL_ASSERT_SUCCESS( JlGetObjectNumberU64( objectTree, &u64 ) );
+    JL_ASSERT( 123 == u64 );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+    JL_ASSERT_SUCCESS( JlParseJsonBuffer( "[1] garbage", 4, IsJson5, &objectTree, &errorAtPos ) );
+    JL_ASSERT_NOT_NULL( objectTree );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+    // Every truncation of the document must fail cleanly without reading beyond the buffer
+    for( size_t len=0; len<sizeof( json ) - 1; len++ )
+    {
+        JL_ASSERT( JL_STATUS_SUCCESS != ParseFromExactBuffer( IsJson5, json, len, &objectTree ) );
+        JL_ASSERT_NULL( objectTree );
+    }
+
+    // Truncated tokens
+    JL_ASSERT_STATUS( ParseFromExactBuffer( IsJson5, "\"abc\"", 4, &objectTree ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT_STATUS( ParseFromExactBuffer( IsJson5, "true", 3, &objectTree ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT_STATUS( ParseFromExactBuffer( IsJson5, "null", 2, &objectTree ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT_STATUS( ParseFromExactBuffer( IsJson5, "\"\\u0041\"", 6, &objectTree ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT_STATUS( ParseFromExactBuffer( IsJson5, "\"\\u0041\"", 7, &objectTree ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT_NULL( objectTree );
+
+    if( IsJson5 )
+    {
+        JL_ASSERT_SUCCESS( ParseFromExactBuffer( IsJson5, "1 // comment", 12, &objectTree ) );
+        JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+        JL_ASSERT_SUCCESS( ParseFromExactBuffer( IsJson5, "1 /* comment */", 15, &objectTree ) );
+        JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+    }
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestParserReuse
+//
+//  Tests using a single JlParser for multiple documents
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestParserReuse
+    (
+        void
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlParser* parser = NULL;
+    JlParser* parser5 = NULL;
+    JlDataObject* objectTree = NULL;
+    JlDataObject* object = NULL;
+    char const* stringPtr = NULL;
+    uint64_t u64 = 0;
+    size_t errorAtPos = 100;
+    size_t errorAtPos2 = 100;
+    char const json1[] = "{\"a\":{\"b\":{\"c\":\"d\"}},\"e\":[{\"f\":1},{\"g\":\"\\u0041\\n\"}],\"h\":12345678901234}";
+    char const json2[] = "[\"a long string that is larger than the first string so that the buffer needs to grow\", 1e10]";
+    char const invalid[] = "{\"a\":[1,2,}";
+
+    JL_ASSERT_STATUS( JlParserCreate( JL_PARSE_FLAGS_NONE, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserFree( NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserFree( &parser ), JL_STATUS_INVALID_PARAMETER );
+
+    JL_ASSERT_SUCCESS( JlParserCreate( JL_PARSE_FLAGS_NONE, &parser ) );
+    JL_ASSERT_NOT_NULL( parser );
+    JL_ASSERT_SUCCESS( JlParserCreate( JL_PARSE_FLAGS_JSON5, &parser5 ) );
+    JL_ASSERT_NOT_NULL( parser5 );
+
+    JL_ASSERT_STATUS( JlParserParse( NULL, json1, sizeof(json1)-1, &objectTree, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserParse( parser, NULL, 0, &objectTree, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserParse( parser, json1, sizeof(json1)-1, NULL, NULL ), JL_STATUS_INVALID_PARAMETER );
+
+    for( int i=0; i<3; i++ )
+    {
+        JL_ASSERT_SUCCESS( JlParserParse( parser, json1, sizeof(json1)-1, &objectTree, &errorAtPos ) );
+        JL_ASSERT_NOT_NULL( objectTree );
+        JL_ASSERT_SUCCESS( JlGetObjectFromDictionaryByKey( objectTree, "a", &object ) );
+        JL_ASSERT_SUCCESS( JlGetObjectFromDictionaryByKey( object, "b", &object ) );
+        JL_ASSERT_SUCCESS( JlGetStringFromDictionaryByKey( object, "c", &stringPtr ) );
+        JL_ASSERT( strcmp( stringPtr, "d" ) == 0 );
+        JL_ASSERT_SUCCESS( JlGetObjectFromDictionaryByKey( objectTree, "h", &object ) );
+        JL_ASSERT_SUCCESS( JlGetObjectNumberU64( object, &u64 ) );
+        JL_ASSERT( 12345678901234ULL == u64 );
+        JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+        JL_ASSERT_SUCCESS( JlParserParse( parser, json2, sizeof(json2)-1, &objectTree, &errorAtPos ) );
+        JL_ASSERT_NOT_NULL( objectTree );
+        JL_ASSERT( 2 == JlGetListCount( objectTree ) );
+        JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+        // Errors are reported the same as the one shot function and do not affect the following parse
+        JL_ASSERT_STATUS( JlParseJsonBuffer( invalid, sizeof(invalid)-1, false, &objectTree, &errorAtPos2 ), JL_STATUS_INVALID_DATA );
+        JL_ASSERT_STATUS( JlParserParse( parser, invalid, sizeof(invalid)-1, &objectTree, &errorAtPos ), JL_STATUS_INVALID_DATA );
+        JL_ASSERT_NULL( objectTree );
+        JL_ASSERT( errorAtPos == errorAtPos2 );
+    }
+
+    // Json5 is controlled by the parse flags
+    JL_ASSERT_STATUS( JlParserParse( parser, "{a:1}", 5, &objectTree, &errorAtPos ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT_SUCCESS( JlParserParse( parser5, "{a:1}", 5, &objectTree, &errorAtPos ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+    JL_ASSERT_SUCCESS( JlParserFree( &parser ) );
+    JL_ASSERT_NULL( parser );
+    JL_ASSERT_SUCCESS( JlParserFree( &parser5 ) );
+    JL_ASSERT_NULL( parser5 );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  AllocString
+//
+//  Returns a copy of String allocated with JlAlloc
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+char*
+    AllocString
+    (
+        char const*     String
+    )
+{
+    char* newString = JlAlloc( strlen( String ) + 1 );
+    if( NULL != newString )
+    {
+        strcpy( newString, String );
+    }
+
+    return newString;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestStringOwnership
+//
+//  Tests setting strings and dictionary keys by handing over allocated strings, and that the parser uses this so
+//  each string and key in the tree is allocated once.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestStringOwnership
+    (
+        void
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlDataObject* dictionary = NULL;
+    JlDataObject* stringObject = NULL;
+    JlDataObject* numberObject = NULL;
+    JlDataObject* objectTree = NULL;
+    char const* stringPtr = NULL;
+    char* string = NULL;
+    char* keyName = NULL;
+    uint64_t allocsBefore = 0;
+    uint64_t allocsAfter = 0;
+    char const json[] = "{\"key\":\"value\",\"k2\":\"esc\\u0041ped\\n\"}";
+
+    JL_ASSERT_SUCCESS( JlCreateObject( JL_DATA_TYPE_STRING, &stringObject ) );
+    JL_ASSERT_SUCCESS( JlCreateObject( JL_DATA_TYPE_NUMBER, &numberObject ) );
+    JL_ASSERT_SUCCESS( JlCreateObject( JL_DATA_TYPE_DICTIONARY, &dictionary ) );
+
+    // String object takes the string without copying it
+    string = AllocString( "first" );
+    JL_ASSERT_NOT_NULL( string );
+    JL_ASSERT_STATUS( JlSetObjectStringTakeOwnership( NULL, string ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlSetObjectStringTakeOwnership( numberObject, string ), JL_STATUS_WRONG_TYPE );
+    JL_ASSERT_SUCCESS( JlSetObjectStringTakeOwnership( stringObject, string ) );
+    JL_ASSERT_SUCCESS( JlGetObjectString( stringObject, &stringPtr ) );
+    JL_ASSERT( stringPtr == string );
+
+    // Replacing frees the previous string, and an empty string is not stored
+    string = AllocString( "" );
+    JL_ASSERT_NOT_NULL( string );
+    JL_ASSERT_SUCCESS( JlSetObjectStringTakeOwnership( stringObject, string ) );
+    JL_ASSERT_SUCCESS( JlGetObjectString( stringObject, &stringPtr ) );
+    JL_ASSERT_NULL( stringPtr );
+    JL_ASSERT_SUCCESS( JlSetObjectStringTakeOwnership( stringObject, NULL ) );
+
+    // Dictionary takes the key without copying it. If it fails the key still belongs to the caller
+    keyName = AllocString( "key" );
+    JL_ASSERT_NOT_NULL( keyName );
+    JL_ASSERT_STATUS( JlAttachObjectToDictionaryObjectTakeKey( numberObject, keyName, stringObject ), JL_STATUS_WRONG_TYPE );
+    JL_ASSERT_SUCCESS( JlAttachObjectToDictionaryObjectTakeKey( dictionary, keyName, stringObject ) );
+    stringObject = NULL;
+    keyName = AllocString( "key" );
+    JL_ASSERT_NOT_NULL( keyName );
+    JL_ASSERT_STATUS( JlAttachObjectToDictionaryObjectTakeKey( dictionary, keyName, numberObject ), JL_STATUS_DICTIONARY_ITEM_REPEATED );
+    JlFree( keyName );
+    keyName = AllocString( "" );
+    JL_ASSERT_NOT_NULL( keyName );
+    JL_ASSERT_STATUS( JlAttachObjectToDictionaryObjectTakeKey( dictionary, keyName, numberObject ), JL_STATUS_INVALID_PARAMETER );
+    JlFree( keyName );
+    JL_ASSERT_SUCCESS( JlGetObjectFromDictionaryByKey( dictionary, "key", &stringObject ) );
+    stringObject = NULL;
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &dictionary ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &numberObject ) );
+
+    // Parsing allocates the parser, then for the tree 3 objects, 2 dictionary items, 2 keys, and 2 strings.
+    WjTestLib_Memory_GetStats( &allocsBefore, NULL, NULL );
+    JL_ASSERT_SUCCESS( JlParseJsonBuffer( json, sizeof(json)-1, false, &objectTree, NULL ) );
+    WjTestLib_Memory_GetStats( &allocsAfter, NULL, NULL );
+    JL_ASSERT( 10 == allocsAfter - allocsBefore );
+    JL_ASSERT_SUCCESS( JlGetStringFromDictionaryByKey( objectTree, "key", &stringPtr ) );
+    JL_ASSERT( strcmp( stringPtr, "value" ) == 0 );
+    JL_ASSERT_SUCCESS( JlGetStringFromDictionaryByKey( objectTree, "k2", &stringPtr ) );
+    JL_ASSERT( strcmp( stringPtr, "escAped\n" ) == 0 );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ParseInChunks
+//
+//  Parses the JSON by feeding it to the parser in pieces. If ChunkSize is 0 then it is split into two at SplitPos,
+//  otherwise it is fed ChunkSize bytes at a time. Each chunk is copied into a temporary buffer which is overwritten
+//  after feeding, to make sure the parser does not hold on to it. Returns the result of JlParserFinish.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    ParseInChunks
+    (
+        JlParser*       Parser,
+        char const*     Json,
+        size_t          JsonLength,
+        size_t          SplitPos,
+        size_t          ChunkSize,
+        JlDataObject**  pRootObject,
+        size_t*         pErrorAtPos
+    )
+{
+    JL_STATUS jlStatus = JL_STATUS_SUCCESS;
+    size_t pos = 0;
+
+    while( pos < JsonLength )
+    {
+        size_t amount = ChunkSize > 0 ? ChunkSize : ( pos < SplitPos ? SplitPos : JsonLength - pos );
+        if( amount > JsonLength - pos )
+        {
+            amount = JsonLength - pos;
+        }
+
+        char* chunk = malloc( amount + 1 );
+        memcpy( chunk, Json + pos, amount );
+        (void) JlParserFeed( Parser, chunk, amount, NULL );
+        memset( chunk, '#', amount + 1 );
+        free( chunk );
+
+        pos += amount;
+    }
+
+    jlStatus = JlParserFinish( Parser, pRootObject, pErrorAtPos );
+
+    return jlStatus;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  CheckChunkedParse
+//
+//  Checks that parsing Json split at every position, and one byte at a time, gives the same result as parsing it in
+//  one go.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    CheckChunkedParse
+    (
+        JlParser*       Parser,
+        bool            IsJson5,
+        char const*     Json
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlDataObject* expectedTree = NULL;
+    JlDataObject* objectTree = NULL;
+    char* expectedJson = NULL;
+    char* outputJson = NULL;
+    size_t expectedErrorAtPos = 0;
+    size_t errorAtPos = 0;
+    size_t jsonLength = strlen( Json );
+    JL_STATUS expectedStatus;
+
+    expectedStatus = JlParseJsonBuffer( Json, jsonLength, IsJson5, &expectedTree, &expectedErrorAtPos );
+    if( JL_STATUS_SUCCESS == expectedStatus )
+    {
+        JL_ASSERT_SUCCESS( JlOutputJson( expectedTree, false, &expectedJson ) );
+    }
+
+    for( size_t i=0; i<=jsonLength+1; i++ )
+    {
+        // The last pass feeds a byte at a time
+        size_t splitPos = i <= jsonLength ? i : 0;
+        size_t chunkSize = i <= jsonLength ? 0 : 1;
+
+        errorAtPos = 0;
+        JL_ASSERT_STATUS( ParseInChunks( Parser, Json, jsonLength, splitPos, chunkSize, &objectTree, &errorAtPos ), expectedStatus );
+        if( JL_STATUS_SUCCESS == expectedStatus )
+        {
+            JL_ASSERT_NOT_NULL( objectTree );
+            JL_ASSERT_SUCCESS( JlOutputJson( objectTree, false, &outputJson ) );
+            JL_ASSERT( strcmp( outputJson, expectedJson ) == 0 );
+            JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &outputJson ) );
+            JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+        }
+        else
+        {
+            JL_ASSERT_NULL( objectTree );
+            JL_ASSERT( errorAtPos == expectedErrorAtPos );
+        }
+    }
+
+    if( NULL != expectedTree )
+    {
+        JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &expectedJson ) );
+        JL_ASSERT_SUCCESS( JlFreeObjectTree( &expectedTree ) );
+    }
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  VerifyValidateMatchesParse
+//
+//  Checks that JlValidateJson gives the same result as parsing the JSON into an object tree, and reports errors at
+//  the same position. Duplicate keys are not detected by validation so those documents are not compared.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    VerifyValidateMatchesParse
+    (
+        bool            IsJson5,
+        char const*     Json,
+        size_t          JsonLength
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlDataObject* objectTree = NULL;
+    size_t parseErrorAtPos = 0;
+    size_t validateErrorAtPos = 0;
+    JL_STATUS parseStatus;
+    JL_STATUS validateStatus;
+
+    parseStatus = JlParseJsonBuffer( Json, JsonLength, IsJson5, &objectTree, &parseErrorAtPos );
+    if( NULL != objectTree )
+    {
+        JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+    }
+    if( JL_STATUS_INVALID_PARAMETER == parseStatus )
+    {
+        // Tree parsing fails to attach an empty key, validation reports it as invalid data
+        parseStatus = JL_STATUS_INVALID_DATA;
+    }
+
+    validateStatus = JlValidateJson( Json, JsonLength, IsJson5, &validateErrorAtPos );
+    if( JL_STATUS_DICTIONARY_ITEM_REPEATED != parseStatus )
+    {
+        JL_ASSERT_STATUS( validateStatus, parseStatus );
+        JL_ASSERT( parseErrorAtPos == validateErrorAtPos );
+    }
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestValidate
+//
+//  Tests validating JSON without building an object tree. Each document is also checked with every truncated length
+//  and with each character replaced by characters that are significant to the parser.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestValidate
+    (
+        bool        IsJson5
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    size_t errorAtPos = 0;
+    uint64_t allocsBefore = 0;
+    uint64_t allocsAfter = 0;
+    char json [256];
+    char const replacements[] = " \"\\{}[],:0e.-+/'x\x01";
+    char const* documents[] = {
+        "{\"a\":[1,-2.5e+3,true,false,null],\"bb\":\"esc \\\\ \\/ \\n \\u0041\\ud83d\\ude00\",\"ccc\":{\"d\":[[],{}]}}",
+        "  [ 12345678901234 , 0.000001 , 1e-400 , \"\" , \"null\" ]  ",
+        " 123 ",
+        "\"string\"",
+        "[true,false,null]",
+        "{\"a\":{\"bb\":{\"ccc\":[1e308,1e309]}}}",
+        "{a:1, 'bb':'single \\\r\n quoted', /* c */ ccc:[0x1F, +5, .5, 5.,], // end\n dddd:\"\\t\"}",
+        "// comment\n[1,2,3,] /* trailing */",
+        "\xef\xbb\xbf[ \xc2\xa0 1 \xe2\x80\xa8 -inf, nan ]",
+    };
+
+    JL_ASSERT_STATUS( JlValidateJson( NULL, 0, IsJson5, &errorAtPos ), JL_STATUS_INVALID_PARAMETER );
+
+    JL_ASSERT_SUCCESS( JlValidateJson( "{\"a\":[1,2]}", 11, IsJson5, &errorAtPos ) );
+    JL_ASSERT( 0 == errorAtPos );
+    JL_ASSERT_STATUS( JlValidateJson( "{\"a\":[1,2}", 10, IsJson5, &errorAtPos ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT( 9 == errorAtPos );
+    JL_ASSERT_STATUS( JlValidateJson( "{\"\":1}", 6, IsJson5, &errorAtPos ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT( 1 == errorAtPos );
+    JL_ASSERT_SUCCESS( JlValidateJson( "{\"a\":1,\"a\":2}", 13, IsJson5, NULL ) );
+    JL_ASSERT_STATUS( JlValidateJson( "[0.0]", 5, IsJson5, NULL ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT_STATUS( JlValidateJson( "", 0, IsJson5, NULL ), JL_STATUS_END_OF_DATA );
+
+    for( size_t d=0; d<NumElements(documents); d++ )
+    {
+        size_t length = strlen( documents[d] );
+        JL_ASSERT( length < sizeof(json) );
+
+        // Validation must not allocate anything
+        WjTestLib_Memory_GetStats( &allocsBefore, NULL, NULL );
+        (void) JlValidateJson( documents[d], length, IsJson5, NULL );
+        WjTestLib_Memory_GetStats( &allocsAfter, NULL, NULL );
+        JL_ASSERT( allocsBefore == allocsAfter );
+
+        TestReturn = VerifyValidateMatchesParse( IsJson5, documents[d], length );
+        for( size_t i=0; i<length && WJTL_STATUS_SUCCESS == TestReturn; i++ )
+        {
+            TestReturn = VerifyValidateMatchesParse( IsJson5, documents[d], i );
+            for( size_t r=0; r<sizeof(replacements)-1 && WJTL_STATUS_SUCCESS == TestReturn; r++ )
+            {
+                memcpy( json, documents[d], length );
+                json[i] = replacements[r];
+                TestReturn = VerifyValidateMatchesParse( IsJson5, json, length );
+            }
+        }
+        JL_ASSERT( WJTL_STATUS_SUCCESS == TestReturn );
+    }
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  VerifyInSituMatchesParse
+//
+//  Checks that parsing a copy of the JSON in-situ gives the same result as parsing it normally, and reports errors at
+//  the same position.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    VerifyInSituMatchesParse
+    (
+        bool            IsJson5,
+        char const*     Json,
+        size_t          JsonLength
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlDataObject* expectedTree = NULL;
+    JlDataObject* objectTree = NULL;
+    char* expectedJson = NULL;
+    char* outputJson = NULL;
+    char* buffer = NULL;
+    size_t expectedErrorAtPos = 0;
+    size_t errorAtPos = 0;
+    JL_STATUS expectedStatus;
+
+    // Copy into an allocation of exactly the JSON length so that any write beyond it is caught
+    buffer = JlAlloc( JsonLength > 0 ? JsonLength : 1 );
+    JL_ASSERT_NOT_NULL( buffer );
+    memcpy( buffer, Json, JsonLength );
+
+    expectedStatus = JlParseJsonBuffer( Json, JsonLength, IsJson5, &expectedTree, &expectedErrorAtPos );
+    JL_ASSERT_STATUS( JlParseJsonInSitu( buffer, JsonLength, IsJson5, &objectTree, &errorAtPos ), expectedStatus );
+    if( JL_STATUS_SUCCESS == expectedStatus )
+    {
+        JL_ASSERT_SUCCESS( JlOutputJson( expectedTree, false, &expectedJson ) );
+        JL_ASSERT_SUCCESS( JlOutputJson( objectTree, false, &outputJson ) );
+        JL_ASSERT( strcmp( outputJson, expectedJson ) == 0 );
+        JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &outputJson ) );
+        JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &expectedJson ) );
+        JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+        JL_ASSERT_SUCCESS( JlFreeObjectTree( &expectedTree ) );
+    }
+    else
+    {
+        JL_ASSERT_NULL( objectTree );
+        JL_ASSERT( errorAtPos == expectedErrorAtPos );
+    }
+
+    JlFree( buffer );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestInSitu
+//
+//  Tests parsing in-situ, where strings and keys are unescaped within the JSON buffer and the tree points at them.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestInSitu
+    (
+        bool        IsJson5
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlDataObject* objectTree = NULL;
+    JlDataObject* stringObject = NULL;
+    JlDataObject* numberObject = NULL;
+    JlParser* parser = NULL;
+    JlDictionaryItem* enumerator = NULL;
+    char const* stringPtr = NULL;
+    char const* keyName = NULL;
+    uint64_t allocsBefore = 0;
+    uint64_t allocsAfter = 0;
+    char buffer [64];
+    char const json[] = "{\"key\":\"value\",\"k2\":\"esc\\u0041ped\\n\",\"k3\":\"\"}";
+    char const* documents[] = {
+        "{\"a\":[1,-2.5e+3,true,false,null],\"bb\":\"esc \\\\ \\/ \\n \\u0041\\ud83d\\ude00\",\"ccc\":{\"d\":[[],{}]}}",
+        "[\"\\u0000\",\"\\\"\\\"\",\"\\u00e9\\u4e2d\",\"\",\"plain\",\"\\b\\f\\r\\t\"]",
+        "{\"\\u0041\":\"\\u0042\",\"B\":{\"\\n\":\"x\"}}",
+        "{\"a\":1,\"a\":2}",
+        "\"string\"",
+        "{a:1, 'bb':'single \\\r\n quoted', \\u0063cc:'\\'', /* c */ dddd:[\"\\t\",],}",
+    };
+
+    JL_ASSERT_STATUS( JlParseJsonInSitu( NULL, 0, IsJson5, &objectTree, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParseJsonInSitu( buffer, 0, IsJson5, NULL, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserParseInSitu( NULL, buffer, 0, &objectTree, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlSetObjectStringReference( NULL, "x" ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlAttachObjectToDictionaryObjectReferenceKey( NULL, "x", NULL ), JL_STATUS_INVALID_PARAMETER );
+
+    // Parsing allocates the parser, then for the tree 4 objects and 3 dictionary items. The strings and keys are
+    // left in the buffer.
+    memcpy( buffer, json, sizeof(json) );
+    WjTestLib_Memory_GetStats( &allocsBefore, NULL, NULL );
+    JL_ASSERT_SUCCESS( JlParseJsonInSitu( buffer, sizeof(json)-1, IsJson5, &objectTree, NULL ) );
+    WjTestLib_Memory_GetStats( &allocsAfter, NULL, NULL );
+    JL_ASSERT( 8 == allocsAfter - allocsBefore );
+    JL_ASSERT_SUCCESS( JlGetStringFromDictionaryByKey( objectTree, "key", &stringPtr ) );
+    JL_ASSERT( strcmp( stringPtr, "value" ) == 0 );
+    JL_ASSERT( stringPtr == buffer + 8 );
+    JL_ASSERT_SUCCESS( JlGetStringFromDictionaryByKey( objectTree, "k2", &stringPtr ) );
+    JL_ASSERT( strcmp( stringPtr, "escAped\n" ) == 0 );
+    JL_ASSERT( stringPtr == buffer + 21 );
+    JL_ASSERT_SUCCESS( JlGetStringFromDictionaryByKey( objectTree, "k3", &stringPtr ) );
+    JL_ASSERT_NULL( stringPtr );
+    JL_ASSERT_SUCCESS( JlGetObjectDictionaryNextItem( objectTree, &stringObject, &keyName, &enumerator ) );
+    JL_ASSERT( keyName == buffer + 2 );
+
+    // The tree can still be changed. Strings and keys in the buffer are replaced or removed without being freed
+    JL_ASSERT_SUCCESS( JlSetObjectString( stringObject, "changed" ) );
+    JL_ASSERT_SUCCESS( JlGetObjectString( stringObject, &stringPtr ) );
+    JL_ASSERT( stringPtr != buffer + 8 );
+    JL_ASSERT_SUCCESS( JlGetObjectFromDictionaryByKey( objectTree, "k2", &stringObject ) );
+    JL_ASSERT_SUCCESS( JlDetachObjectFromDictionaryObject( objectTree, "k2" ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &stringObject ) );
+    JL_ASSERT_SUCCESS( JlCreateObject( JL_DATA_TYPE_NUMBER, &numberObject ) );
+    JL_ASSERT_SUCCESS( JlAttachObjectToDictionaryObjectReferenceKey( objectTree, "static", numberObject ) );
+    JL_ASSERT_SUCCESS( JlGetObjectFromDictionaryByKey( objectTree, "static", &numberObject ) );
+    numberObject = NULL;
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+    // A reused parser goes back to allocating strings for normal parses
+    JL_ASSERT_SUCCESS( JlParserCreate( IsJson5 ? JL_PARSE_FLAGS_JSON5 : JL_PARSE_FLAGS_NONE, &parser ) );
+    memcpy( buffer, json, sizeof(json) );
+    JL_ASSERT_SUCCESS( JlParserParseInSitu( parser, buffer, sizeof(json)-1, &objectTree, NULL ) );
+    JL_ASSERT_SUCCESS( JlGetStringFromDictionaryByKey( objectTree, "key", &stringPtr ) );
+    JL_ASSERT( stringPtr == buffer + 8 );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+    memcpy( buffer, json, sizeof(json) );
+    JL_ASSERT_SUCCESS( JlParserParse( parser, buffer, sizeof(json)-1, &objectTree, NULL ) );
+    JL_ASSERT_SUCCESS( JlGetStringFromDictionaryByKey( objectTree, "key", &stringPtr ) );
+    JL_ASSERT( stringPtr != buffer + 8 );
+    JL_ASSERT( strcmp( buffer, json ) == 0 );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+    JL_ASSERT_SUCCESS( JlParserFree( &parser ) );
+
+    // Every document and each truncation of it gives the same result as a normal parse
+    for( size_t d=0; d<NumElements(documents); d++ )
+    {
+        size_t length = strlen( documents[d] );
+        for( size_t i=0; i<=length && WJTL_STATUS_SUCCESS == TestReturn; i++ )
+        {
+            TestReturn = VerifyInSituMatchesParse( IsJson5, documents[d], i );
+        }
+        JL_ASSERT( WJTL_STATUS_SUCCESS == TestReturn );
+    }
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  VerifyLazyMatchesParse
+//
+//  Checks that parsing the JSON lazily and then using every list and dictionary (by outputting the tree) gives the
+//  same result as parsing it normally. Errors within lists and dictionaries below the root are only found when they
+//  are used, so a document that fails to parse must either fail the lazy parse (not necessarily with the same status
+//  as the lazy parse only matches brackets), or fail with the same status when it is output.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    VerifyLazyMatchesParse
+    (
+        bool            IsJson5,
+        char const*     Json,
+        size_t          JsonLength
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlDataObject* expectedTree = NULL;
+    JlDataObject* objectTree = NULL;
+    char* expectedJson = NULL;
+    char* outputJson = NULL;
+    size_t expectedErrorAtPos = 0;
+    size_t errorAtPos = 0;
+    JL_STATUS expectedStatus;
+    JL_STATUS status;
+
+    expectedStatus = JlParseJsonBuffer( Json, JsonLength, IsJson5, &expectedTree, &expectedErrorAtPos );
+    status = JlParseJsonLazy( Json, JsonLength, IsJson5, &objectTree, &errorAtPos );
+    if( JL_STATUS_SUCCESS == expectedStatus )
+    {
+        JL_ASSERT_SUCCESS( status );
+        JL_ASSERT_SUCCESS( JlOutputJson( expectedTree, false, &expectedJson ) );
+        JL_ASSERT_SUCCESS( JlOutputJson( objectTree, false, &outputJson ) );
+        JL_ASSERT( strcmp( outputJson, expectedJson ) == 0 );
+        JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &outputJson ) );
+        JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &expectedJson ) );
+        JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+        JL_ASSERT_SUCCESS( JlFreeObjectTree( &expectedTree ) );
+    }
+    else if( JL_STATUS_SUCCESS == status )
+    {
+        JL_ASSERT_STATUS( JlOutputJson( objectTree, false, &outputJson ), expectedStatus );
+        JL_ASSERT_NULL( outputJson );
+        JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+    }
+    else
+    {
+        JL_ASSERT_NULL( objectTree );
+    }
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestLazy
+//
+//  Tests lazy parsing, where lists and dictionaries below the root are parsed the first time they are used.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestLazy
+    (
+        bool        IsJson5
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlDataObject* objectTree = NULL;
+    JlDataObject* listObject = NULL;
+    JlDataObject* object = NULL;
+    JlDataObject* numberObject = NULL;
+    JlListItem* enumerator = NULL;
+    char* jsonText = NULL;
+    char const* stringPtr = NULL;
+    uint64_t value = 0;
+    uint64_t allocsBefore = 0;
+    uint64_t allocsAfter = 0;
+    size_t errorAtPos = 0;
+    char const json[] = "{\"a\":[1,{\"b\":\"x\"},[2]],\"c\":{\"d\":[[3]],\"e\":{\"f\":4}},\"g\":\"str\"}";
+    char const* documents[] = {
+        "{\"a\":[1,-2.5e+3,true,false,null],\"bb\":\"esc \\\\ \\/ \\n \\u0041\\ud83d\\ude00\",\"ccc\":{\"d\":[[],{}]}}",
+        "[[\"]\",\"[\\\"{\",{\"}\":\"\\\\\"}],[],{}]",
+        "[{\"a\":1,\"a\":2}]",
+        "[[1,2],[3,{\"x\":[4,5]}]]",
+        "{a:[1,'],[\\'',/* ] */ 2, // ]\n 3], 'bb':{c:[{},],},}",
+        "[[0.0],[\"a\"x]]",
+    };
+
+    JL_ASSERT_STATUS( JlParseJsonLazy( NULL, 0, IsJson5, &objectTree, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParseJsonLazy( json, sizeof(json)-1, IsJson5, NULL, NULL ), JL_STATUS_INVALID_PARAMETER );
+
+    // Only the root dictionary and its three values are created by the parse (plus the parser, and the dictionary
+    // items, keys, and string).
+    WjTestLib_Memory_GetStats( &allocsBefore, NULL, NULL );
+    JL_ASSERT_SUCCESS( JlParseJsonLazy( json, sizeof(json)-1, IsJson5, &objectTree, NULL ) );
+    WjTestLib_Memory_GetStats( &allocsAfter, NULL, NULL );
+    JL_ASSERT( 12 == allocsAfter - allocsBefore );
+    JL_ASSERT_SUCCESS( JlGetStringFromDictionaryByKey( objectTree, "g", &stringPtr ) );
+    JL_ASSERT( strcmp( stringPtr, "str" ) == 0 );
+
+    // Using a list parses it, leaving the dictionary and list inside it for later
+    JL_ASSERT_SUCCESS( JlGetObjectFromDictionaryByKey( objectTree, "a", &listObject ) );
+    JL_ASSERT( JL_DATA_TYPE_LIST == JlGetObjectType( listObject ) );
+    JL_ASSERT( 5 == JlGetObjectTag( listObject ) );
+    JL_ASSERT( 3 == JlGetListCount( listObject ) );
+    JL_ASSERT_SUCCESS( JlGetObjectListNextItem( listObject, &object, &enumerator ) );
+    JL_ASSERT_SUCCESS( JlGetObjectNumberU64( object, &value ) );
+    JL_ASSERT( 1 == value );
+    JL_ASSERT_SUCCESS( JlGetObjectListNextItem( listObject, &object, &enumerator ) );
+    JL_ASSERT( 8 == JlGetObjectTag( object ) );
+    JL_ASSERT_SUCCESS( JlGetStringFromDictionaryByKey( object, "b", &stringPtr ) );
+    JL_ASSERT( strcmp( stringPtr, "x" ) == 0 );
+    JL_ASSERT_SUCCESS( JlGetObjectListNextItem( listObject, &object, &enumerator ) );
+    JL_ASSERT( JL_DATA_TYPE_LIST == JlGetObjectType( object ) );
+    JL_ASSERT_STATUS( JlGetObjectListNextItem( listObject, &object, &enumerator ), JL_STATUS_END_OF_DATA );
+
+    // Changing a lazy dictionary parses it first
+    JL_ASSERT_SUCCESS( JlGetObjectFromDictionaryByKey( objectTree, "c", &object ) );
+    JL_ASSERT_SUCCESS( JlCreateObject( JL_DATA_TYPE_NUMBER, &numberObject ) );
+    JL_ASSERT_STATUS( JlAttachObjectToDictionaryObject( object, "e", numberObject ), JL_STATUS_DICTIONARY_ITEM_REPEATED );
+    JL_ASSERT_SUCCESS( JlAttachObjectToDictionaryObject( object, "n", numberObject ) );
+    numberObject = NULL;
+    JL_ASSERT_SUCCESS( JlGetObjectFromDictionaryByKey( object, "e", &object ) );
+    JL_ASSERT_SUCCESS( JlGetObjectFromDictionaryByKey( object, "f", &object ) );
+    JL_ASSERT_SUCCESS( JlGetObjectNumberU64( object, &value ) );
+    JL_ASSERT( 4 == value );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+    // An error inside a list is returned when the list is used, and the list stays unparsed.
+    JL_ASSERT_SUCCESS( JlParseJsonLazy( "[[1,]]", 6, false, &objectTree, &errorAtPos ) );
+    enumerator = NULL;
+    JL_ASSERT_SUCCESS( JlGetObjectListNextItem( objectTree, &listObject, &enumerator ) );
+    enumerator = NULL;
+    JL_ASSERT_STATUS( JlGetObjectListNextItem( listObject, &object, &enumerator ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT( 0 == JlGetListCount( listObject ) );
+    JL_ASSERT_STATUS( JlAttachObjectToListObject( listObject, objectTree ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+    // Unmatched brackets are found by the lazy parse
+    JL_ASSERT_STATUS( JlParseJsonLazy( "[[1,\"]]", 7, false, &objectTree, &errorAtPos ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT_NULL( objectTree );
+
+    // The nesting limit is the same as for a normal parse
+    JL_ASSERT_SUCCESS( GenerateNestedJsonList( MAX_JSON_DEPTH, &jsonText ) );
+    JL_ASSERT_SUCCESS( JlParseJsonLazy( jsonText, strlen( jsonText ), IsJson5, &objectTree, NULL ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+    JlFree( jsonText );
+    JL_ASSERT_SUCCESS( GenerateNestedJsonList( MAX_JSON_DEPTH+1, &jsonText ) );
+    JL_ASSERT_STATUS( JlParseJsonLazy( jsonText, strlen( jsonText ), IsJson5, &objectTree, NULL ), JL_STATUS_JSON_NESTING_TOO_DEEP );
+    JL_ASSERT_NULL( objectTree );
+    JlFree( jsonText );
+    JL_ASSERT_SUCCESS( GenerateNestedJsonDictionary( MAX_JSON_DEPTH+1, &jsonText ) );
+    JL_ASSERT_STATUS( JlParseJsonLazy( jsonText, strlen( jsonText ), IsJson5, &objectTree, NULL ), JL_STATUS_JSON_NESTING_TOO_DEEP );
+    JL_ASSERT_NULL( objectTree );
+    JlFree( jsonText );
+    jsonText = NULL;
+
+    // Every document and each truncation of it gives the same result as a normal parse once it has all been used
+    for( size_t d=0; d<NumElements(documents); d++ )
+    {
+        size_t length = strlen( documents[d] );
+        for( size_t i=0; i<=length && WJTL_STATUS_SUCCESS == TestReturn; i++ )
+        {
+            TestReturn = VerifyLazyMatchesParse( IsJson5, documents[d], i );
+        }
+        JL_ASSERT( WJTL_STATUS_SUCCESS == TestReturn );
+    }
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  VerifyProjection
+//
+//  Parses the JSON with the projection Paths and checks the tree output as ExpectedJson. The same document is also
+//  parsed with a lazy parser and in-situ with the same projection, which must give the same tree.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    VerifyProjection
+    (
+        bool                IsJson5,
+        char const*         Json,
+        char const* const*  Paths,
+        size_t              NumPaths,
+        char const*         ExpectedJson
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlParser* parser = NULL;
+    JlDataObject* objectTree = NULL;
+    char* outputJson = NULL;
+    char* buffer = NULL;
+    size_t jsonLength = strlen( Json );
+    JL_PARSE_FLAGS flags = IsJson5 ? JL_PARSE_FLAGS_JSON5 : JL_PARSE_FLAGS_NONE;
+
+    JL_ASSERT_SUCCESS( JlParseJsonProjection( Json, jsonLength, IsJson5, Paths, NumPaths, &objectTree, NULL ) );
+    JL_ASSERT_SUCCESS( JlOutputJson( objectTree, false, &outputJson ) );
+    JL_ASSERT( strcmp( outputJson, ExpectedJson ) == 0 );
+    JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &outputJson ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+    JL_ASSERT_SUCCESS( JlParserCreate( flags | JL_PARSE_FLAGS_LAZY, &parser ) );
+    JL_ASSERT_SUCCESS( JlParserSetProjection( parser, Paths, NumPaths ) );
+    JL_ASSERT_SUCCESS( JlParserParse( parser, Json, jsonLength, &objectTree, NULL ) );
+    JL_ASSERT_SUCCESS( JlOutputJson( objectTree, false, &outputJson ) );
+    JL_ASSERT( strcmp( outputJson, ExpectedJson ) == 0 );
+    JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &outputJson ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+    JL_ASSERT_SUCCESS( JlParserFree( &parser ) );
+
+    buffer = AllocString( Json );
+    JL_ASSERT_NOT_NULL( buffer );
+    JL_ASSERT_SUCCESS( JlParserCreate( flags, &parser ) );
+    JL_ASSERT_SUCCESS( JlParserSetProjection( parser, Paths, NumPaths ) );
+    JL_ASSERT_SUCCESS( JlParserParseInSitu( parser, buffer, jsonLength, &objectTree, NULL ) );
+    JL_ASSERT_SUCCESS( JlOutputJson( objectTree, false, &outputJson ) );
+    JL_ASSERT( strcmp( outputJson, ExpectedJson ) == 0 );
+    JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &outputJson ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+    JL_ASSERT_SUCCESS( JlParserFree( &parser ) );
+    JlFree( buffer );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestProjection
+//
+//  Tests parsing with a projection, where only the values on a set of JSON Pointer paths are put in the tree.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestProjection
+    (
+        bool        IsJson5
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlParser* parser = NULL;
+    JlDataObject* objectTree = NULL;
+    JlDataObject* fullTree = NULL;
+    char* jsonText = NULL;
+    uint64_t allocsBefore = 0;
+    uint64_t allocsAfter = 0;
+    size_t errorAtPos = 0;
+    char const json[] =
+        "{\"user\":{\"id\":5,\"name\":\"n\\u0041me\",\"tags\":[\"a\",\"]\"]},"
+        "\"items\":[{\"price\":1.5,\"qty\":2},{\"qty\":3},{\"price\":7,\"extra\":{\"price\":9}}],"
+        "\"a/b\":{\"~\":true},\"0\":[10,20]}";
+    char const* userId[] = { "/user/id" };
+    char const* itemPrices[] = { "/user/id", "/items/*/price" };
+    char const* secondItem[] = { "/items/1" };
+    char const* escaped[] = { "/a~1b/~0" };
+    char const* indexes[] = { "/0/1", "/0/01", "/0/x" };
+    char const* emptyKey[] = { "/" };
+    char const* whole[] = { "", "/user" };
+    char const* wildcard[] = { "/*/id" };
+    char const* throughValue[] = { "/user/id/x", "/user/name/0" };
+    char const* missing[] = { "/nothing" };
+    char const* invalid[] = { "/user", "user" };
+    char const* invalidEscape[] = { "/a~2" };
+    char const* nullPath[] = { "/user", NULL };
+    char const* json5Paths[] = { "/b/c", "/f" };
+    char const* tooMany[JL_MAX_PROJECTION_PATHS+1];
+
+    for( size_t i=0; i<NumElements(tooMany); i++ )
+    {
+        tooMany[i] = "/user";
+    }
+
+    JL_ASSERT_SUCCESS( JlParserCreate( IsJson5 ? JL_PARSE_FLAGS_JSON5 : JL_PARSE_FLAGS_NONE, &parser ) );
+    JL_ASSERT_STATUS( JlParserSetProjection( NULL, userId, 1 ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserSetProjection( parser, NULL, 1 ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserSetProjection( parser, tooMany, NumElements(tooMany) ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserSetProjection( parser, invalid, NumElements(invalid) ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserSetProjection( parser, invalidEscape, 1 ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserSetProjection( parser, nullPath, NumElements(nullPath) ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParseJsonProjection( NULL, 0, IsJson5, userId, 1, &objectTree, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParseJsonProjection( json, sizeof(json)-1, IsJson5, userId, 1, NULL, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_SUCCESS( JlParserSetProjection( parser, tooMany, JL_MAX_PROJECTION_PATHS ) );
+
+    // A failed set leaves no projection
+    JL_ASSERT_STATUS( JlParserSetProjection( parser, invalid, NumElements(invalid) ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_SUCCESS( JlParserParse( parser, json, sizeof(json)-1, &objectTree, NULL ) );
+    JL_ASSERT_SUCCESS( JlGetObjectFromDictionaryByKey( objectTree, "items", &fullTree ) );
+    JL_ASSERT( 3 == JlGetListCount( fullTree ) );
+    fullTree = NULL;
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+    // Only the kept values and the dictionaries leading to them are allocated (once the parser's scratch buffers have
+    // grown to fit the key names)
+    JL_ASSERT_SUCCESS( JlParserSetProjection( parser, userId, 1 ) );
+    JL_ASSERT_SUCCESS( JlParserParse( parser, json, sizeof(json)-1, &objectTree, NULL ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+    WjTestLib_Memory_GetStats( &allocsBefore, NULL, NULL );
+    JL_ASSERT_SUCCESS( JlParserParse( parser, json, sizeof(json)-1, &objectTree, NULL ) );
+    WjTestLib_Memory_GetStats( &allocsAfter, NULL, NULL );
+    JL_ASSERT( 7 == allocsAfter - allocsBefore );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+    // Removing the projection parses everything again
+    JL_ASSERT_SUCCESS( JlParserSetProjection( parser, NULL, 0 ) );
+    JL_ASSERT_SUCCESS( JlParserParse( parser, json, sizeof(json)-1, &objectTree, NULL ) );
+    JL_ASSERT_SUCCESS( JlGetObjectFromDictionaryByKey( objectTree, "0", &fullTree ) );
+    JL_ASSERT( 2 == JlGetListCount( fullTree ) );
+    fullTree = NULL;
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+    JL_ASSERT_SUCCESS( VerifyProjection( IsJson5, json, userId, NumElements(userId), "{\"user\":{\"id\":5}}" ) );
+    JL_ASSERT_SUCCESS( VerifyProjection( IsJson5, json, itemPrices, NumElements(itemPrices),
+        "{\"user\":{\"id\":5},\"items\":[{\"price\":1.5},{},{\"price\":7}]}" ) );
+    JL_ASSERT_SUCCESS( VerifyProjection( IsJson5, json, secondItem, NumElements(secondItem), "{\"items\":[{\"qty\":3}]}" ) );
+    JL_ASSERT_SUCCESS( VerifyProjection( IsJson5, json, escaped, NumElements(escaped), "{\"a/b\":{\"~\":true}}" ) );
+    JL_ASSERT_SUCCESS( VerifyProjection( IsJson5, json, indexes, NumElements(indexes), "{\"0\":[20]}" ) );
+    JL_ASSERT_SUCCESS( VerifyProjection( IsJson5, "{\"a\":1}", emptyKey, NumElements(emptyKey), "{}" ) );
+    JL_ASSERT_SUCCESS( VerifyProjection( IsJson5, json, wildcard, NumElements(wildcard), "{\"user\":{\"id\":5},\"items\":[],\"a/b\":{},\"0\":[]}" ) );
+    JL_ASSERT_SUCCESS( VerifyProjection( IsJson5, json, throughValue, NumElements(throughValue), "{\"user\":{}}" ) );
+    JL_ASSERT_SUCCESS( VerifyProjection( IsJson5, json, missing, NumElements(missing), "{}" ) );
+    JL_ASSERT_SUCCESS( VerifyProjection( IsJson5, "[1,{\"a\":2}]", userId, NumElements(userId), "[]" ) );
+    JL_ASSERT_SUCCESS( VerifyProjection( IsJson5, "\"str\"", userId, NumElements(userId), "\"str\"" ) );
+    JL_ASSERT_SUCCESS( VerifyProjection( IsJson5, "[[1,2],[3,4]]", wildcard, NumElements(wildcard), "[[],[]]" ) );
+
+    // The empty pointer keeps the whole document
+    JL_ASSERT_SUCCESS( JlParseJsonBuffer( json, sizeof(json)-1, IsJson5, &fullTree, NULL ) );
+    JL_ASSERT_SUCCESS( JlOutputJson( fullTree, false, &jsonText ) );
+    JL_ASSERT_SUCCESS( VerifyProjection( IsJson5, json, whole, NumElements(whole), jsonText ) );
+    JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &jsonText ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &fullTree ) );
+
+    if( IsJson5 )
+    {
+        // Comments and single quoted strings within skipped values
+        JL_ASSERT_SUCCESS( VerifyProjection( IsJson5,
+            "{a:[1,'],[\\'',/* ] */ 2, // ]\n 3], b:{c:'}', d:+inf}, e:.5, /* } */ f:[0x10,],}",
+            json5Paths, NumElements(json5Paths), "{\"b\":{\"c\":\"}\"},\"f\":[16]}" ) );
+    }
+
+    // Errors in kept values are found as usual
+    JL_ASSERT_SUCCESS( JlParserSetProjection( parser, userId, 1 ) );
+    JL_ASSERT_STATUS( JlParserParse( parser, "{\"user\":{\"id\":5,}}", 18, &objectTree, &errorAtPos ), IsJson5 ? JL_STATUS_SUCCESS : JL_STATUS_INVALID_DATA );
+    (void) JlFreeObjectTree( &objectTree );
+    JL_ASSERT_STATUS( JlParserParse( parser, "{\"user\":{\"id\":5,\"id\":6}}", 24, &objectTree, &errorAtPos ), JL_STATUS_DICTIONARY_ITEM_REPEATED );
+    JL_ASSERT_NULL( objectTree );
+    JL_ASSERT_STATUS( JlParserParse( parser, "{\"x\":1 \"user\":2}", 16, &objectTree, &errorAtPos ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT_NULL( objectTree );
+
+    // Within skipped values only unmatched brackets and unterminated strings are found
+    JL_ASSERT_SUCCESS( JlParserParse( parser, "{\"x\":[1,,{\"a\" 2}],\"x\":1}", 24, &objectTree, NULL ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+    JL_ASSERT_STATUS( JlParserParse( parser, "{\"x\":[[1]", 9, &objectTree, &errorAtPos ), JL_STATUS_END_OF_DATA );
+    JL_ASSERT( 9 == errorAtPos );
+    JL_ASSERT_NULL( objectTree );
+    JL_ASSERT_STATUS( JlParserParse( parser, "{\"x\":\"a]}", 9, &objectTree, &errorAtPos ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT_NULL( objectTree );
+
+    // The nesting limit is the same as for a normal parse
+    JL_ASSERT_SUCCESS( GenerateNestedJsonList( MAX_JSON_DEPTH, &jsonText ) );
+    JL_ASSERT_SUCCESS( JlParserParse( parser, jsonText, strlen( jsonText ), &objectTree, NULL ) );
+    JL_ASSERT( 0 == JlGetListCount( objectTree ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+    JlFree( jsonText );
+    JL_ASSERT_SUCCESS( GenerateNestedJsonList( MAX_JSON_DEPTH+1, &jsonText ) );
+    JL_ASSERT_STATUS( JlParserParse( parser, jsonText, strlen( jsonText ), &objectTree, NULL ), JL_STATUS_JSON_NESTING_TOO_DEEP );
+    JL_ASSERT_NULL( objectTree );
+    JlFree( jsonText );
+
+    JL_ASSERT_SUCCESS( JlParserFree( &parser ) );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  VerifyParseKeys
+//
+//  Parses the JSON for the KeyNames and checks the result is ExpectedJson and that ExpectedConsumed bytes were read.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    VerifyParseKeys
+    (
+        JlParser*           Parser,
+        char const*         Json,
+        char const* const*  KeyNames,
+        size_t              NumKeyNames,
+        char const*         ExpectedJson,
+        size_t              ExpectedConsumed
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlDataObject* objectTree = NULL;
+    char* outputJson = NULL;
+    size_t amountConsumed = 0;
+
+    JL_ASSERT_SUCCESS( JlParserParseKeys( Parser, Json, strlen( Json ), KeyNames, NumKeyNames, &objectTree, &amountConsumed, NULL ) );
+    JL_ASSERT( ExpectedConsumed == amountConsumed );
+    JL_ASSERT_SUCCESS( JlOutputJson( objectTree, false, &outputJson ) );
+    JL_ASSERT( strcmp( outputJson, ExpectedJson ) == 0 );
+    JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &outputJson ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestParseKeys
+//
+//  Tests parsing just a few keys from the root dictionary, stopping as soon as they have been read.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestParseKeys
+    (
+        bool        IsJson5
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlParser* parser = NULL;
+    JlDataObject* objectTree = NULL;
+    JlDataObject* object = NULL;
+    size_t amountConsumed = 0;
+    size_t errorAtPos = 0;
+    char const json[] = "{\"type\":\"order\",\"body\":{\"lines\":[1,2,3]},\"tenant\":\"acme\",\"size\":3}";
+    char const* keyNames[] = { "tenant", "type" };
+    char const* starKey[] = { "*" };
+    char const* nullKey[] = { "type", NULL };
+    char const* projection[] = { "/size" };
+    char const* tooMany[JL_MAX_PROJECTION_PATHS+1];
+
+    for( size_t i=0; i<NumElements(tooMany); i++ )
+    {
+        tooMany[i] = "type";
+    }
+
+    JL_ASSERT_SUCCESS( JlParserCreate( IsJson5 ? JL_PARSE_FLAGS_JSON5 : JL_PARSE_FLAGS_NONE, &parser ) );
+    JL_ASSERT_STATUS( JlParserParseKeys( NULL, json, sizeof(json)-1, keyNames, 2, &objectTree, NULL, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserParseKeys( parser, NULL, 0, keyNames, 2, &objectTree, NULL, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserParseKeys( parser, json, sizeof(json)-1, NULL, 2, &objectTree, NULL, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserParseKeys( parser, json, sizeof(json)-1, keyNames, 0, &objectTree, NULL, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserParseKeys( parser, json, sizeof(json)-1, tooMany, NumElements(tooMany), &objectTree, NULL, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserParseKeys( parser, json, sizeof(json)-1, nullKey, 2, &objectTree, NULL, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserParseKeys( parser, json, sizeof(json)-1, keyNames, 2, NULL, NULL, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParseJsonKeys( NULL, 0, IsJson5, keyNames, 2, &objectTree, NULL, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParseJsonKeys( json, sizeof(json)-1, IsJson5, keyNames, 2, NULL, NULL, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_NULL( objectTree );
+
+    // Stops straight after the last key's value. Keys repeated in the list are fine.
+    JL_ASSERT_SUCCESS( JlParseJsonKeys( json, sizeof(json)-1, IsJson5, keyNames, 2, &objectTree, &amountConsumed, NULL ) );
+    JL_ASSERT( strstr( json, "acme\"" ) + 5 - json == (ptrdiff_t)amountConsumed );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+    JL_ASSERT_SUCCESS( VerifyParseKeys( parser, json, keyNames, 2, "{\"type\":\"order\",\"tenant\":\"acme\"}", 56 ) );
+    JL_ASSERT_SUCCESS( VerifyParseKeys( parser, json, tooMany, JL_MAX_PROJECTION_PATHS, "{\"type\":\"order\"}", 15 ) );
+
+    // The rest of the document is not read, even if it is incomplete or invalid
+    JL_ASSERT_SUCCESS( VerifyParseKeys( parser, "{\"type\":{\"a\":[1]},\"tenant\":12", keyNames, 2,
+        "{\"type\":{\"a\":[1]},\"tenant\":12}", 29 ) );
+    JL_ASSERT_SUCCESS( VerifyParseKeys( parser, " {\"tenant\":true,\"type\":null ,,]] \"", keyNames, 2,
+        "{\"tenant\":true,\"type\":null}", 27 ) );
+
+    // If any key is missing the whole document is read
+    JL_ASSERT_SUCCESS( VerifyParseKeys( parser, "{\"type\":\"a\",\"x\":[1]} ", keyNames, 2, "{\"type\":\"a\"}", 21 ) );
+    JL_ASSERT_SUCCESS( VerifyParseKeys( parser, "[{\"type\":1,\"tenant\":2}]", keyNames, 2, "[]", 23 ) );
+    JL_ASSERT_SUCCESS( VerifyParseKeys( parser, "{\"a\":{\"type\":1,\"tenant\":2}}", keyNames, 2, "{}", 27 ) );
+    JL_ASSERT_STATUS( JlParserParseKeys( parser, "{\"type\":1,\"x\":[", 15, keyNames, 2, &objectTree, NULL, &errorAtPos ), JL_STATUS_END_OF_DATA );
+    JL_ASSERT_NULL( objectTree );
+
+    // Key names are not JSON Pointers
+    JL_ASSERT_SUCCESS( VerifyParseKeys( parser, "{\"a\":1,\"*\":2,\"b\":3}", starKey, 1, "{\"*\":2}", 12 ) );
+
+    // Errors before the keys have been found are reported as usual
+    JL_ASSERT_STATUS( JlParserParseKeys( parser, "{\"type\":1 \"tenant\":2}", 21, keyNames, 2, &objectTree, NULL, &errorAtPos ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT( 10 == errorAtPos );
+    JL_ASSERT_NULL( objectTree );
+    JL_ASSERT_STATUS( JlParserParseKeys( parser, "{\"type\":1,\"type\":2,\"tenant\":3}", 30, keyNames, 2, &objectTree, NULL, &errorAtPos ), JL_STATUS_DICTIONARY_ITEM_REPEATED );
+    JL_ASSERT_NULL( objectTree );
+
+    // A projection set on the parser is not used for this, and is still used by JlParserParse afterwards
+    JL_ASSERT_SUCCESS( JlParserSetProjection( parser, projection, 1 ) );
+    JL_ASSERT_SUCCESS( VerifyParseKeys( parser, json, keyNames, 2, "{\"type\":\"order\",\"tenant\":\"acme\"}", 56 ) );
+    JL_ASSERT_SUCCESS( JlParserParse( parser, json, sizeof(json)-1, &objectTree, NULL ) );
+    JL_ASSERT_SUCCESS( JlGetObjectFromDictionaryByKey( objectTree, "size", &object ) );
+    JL_ASSERT_STATUS( JlGetObjectFromDictionaryByKey( objectTree, "type", &object ), JL_STATUS_NOT_FOUND );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+    JL_ASSERT_SUCCESS( JlParserFree( &parser ) );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  VerifyNextDocument
+//
+//  Parses the next document from Json with JlParserParseNextDocument and checks that it is ExpectedJson and ends at
+//  ExpectedOffset.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    VerifyNextDocument
+    (
+        JlParser*       Parser,
+        char const*     Json,
+        size_t*         pOffset,
+        char const*     ExpectedJson,
+        size_t          ExpectedOffset
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlDataObject* objectTree = NULL;
+    char* outputJson = NULL;
+
+    JL_ASSERT_SUCCESS( JlParserParseNextDocument( Parser, Json, strlen( Json ), pOffset, &objectTree, NULL ) );
+    JL_ASSERT( ExpectedOffset == *pOffset );
+    JL_ASSERT_SUCCESS( JlOutputJson( objectTree, false, &outputJson ) );
+    JL_ASSERT( strcmp( outputJson, ExpectedJson ) == 0 );
+    JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &outputJson ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestNextDocument
+//
+//  Tests parsing a series of documents from one buffer, such as NDJSON.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestNextDocument
+    (
+        bool        IsJson5
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlParser* parser = NULL;
+    JlDataObject* objectTree = NULL;
+    size_t offset = 0;
+    size_t errorAtPos = 0;
+    char const ndjson[] = "{\"a\":1}\n[2,3]\r\n\"s\"\n 4 \n{}\n\n";
+    char const concatenated[] = "[1][2]{\"x\":true}\"y\"null";
+    char const withError[] = "{\"a\":1}\n{\"b\" 2}\n[3]\n";
+    char const* projection[] = { "/a" };
+
+    JL_ASSERT_SUCCESS( JlParserCreate( IsJson5 ? JL_PARSE_FLAGS_JSON5 : JL_PARSE_FLAGS_NONE, &parser ) );
+    JL_ASSERT_STATUS( JlParserParseNextDocument( NULL, ndjson, sizeof(ndjson)-1, &offset, &objectTree, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserParseNextDocument( parser, NULL, 0, &offset, &objectTree, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserParseNextDocument( parser, ndjson, sizeof(ndjson)-1, NULL, &objectTree, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserParseNextDocument( parser, ndjson, sizeof(ndjson)-1, &offset, NULL, NULL ), JL_STATUS_INVALID_PARAMETER );
+    offset = sizeof(ndjson);
+    JL_ASSERT_STATUS( JlParserParseNextDocument( parser, ndjson, sizeof(ndjson)-1, &offset, &objectTree, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_NULL( objectTree );
+
+    // Each document in turn, then the end once only white space is left
+    offset = 0;
+    JL_ASSERT_SUCCESS( VerifyNextDocument( parser, ndjson, &offset, "{\"a\":1}", 7 ) );
+    JL_ASSERT_SUCCESS( VerifyNextDocument( parser, ndjson, &offset, "[2,3]", 13 ) );
+    JL_ASSERT_SUCCESS( VerifyNextDocument( parser, ndjson, &offset, "\"s\"", 18 ) );
+    JL_ASSERT_SUCCESS( VerifyNextDocument( parser, ndjson, &offset, "4", 21 ) );
+    JL_ASSERT_SUCCESS( VerifyNextDocument( parser, ndjson, &offset, "{}", 25 ) );
+    JL_ASSERT_STATUS( JlParserParseNextDocument( parser, ndjson, sizeof(ndjson)-1, &offset, &objectTree, NULL ), JL_STATUS_END_OF_DATA );
+    JL_ASSERT( sizeof(ndjson)-1 == offset );
+    JL_ASSERT_NULL( objectTree );
+    JL_ASSERT_STATUS( JlParserParseNextDocument( parser, ndjson, sizeof(ndjson)-1, &offset, &objectTree, NULL ), JL_STATUS_END_OF_DATA );
+    offset = 0;
+    JL_ASSERT_STATUS( JlParserParseNextDocument( parser, ndjson, 0, &offset, &objectTree, NULL ), JL_STATUS_END_OF_DATA );
+    JL_ASSERT_STATUS( JlParserParseNextDocument( parser, " \n\t ", 4, &offset, &objectTree, NULL ), JL_STATUS_END_OF_DATA );
+    JL_ASSERT( 4 == offset );
+
+    // Documents do not need to be separated by anything, and tags are positions within the whole buffer
+    offset = 0;
+    JL_ASSERT_SUCCESS( VerifyNextDocument( parser, concatenated, &offset, "[1]", 3 ) );
+    JL_ASSERT_SUCCESS( JlParserParseNextDocument( parser, concatenated, sizeof(concatenated)-1, &offset, &objectTree, NULL ) );
+    JL_ASSERT( 3 == JlGetObjectTag( objectTree ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+    JL_ASSERT_SUCCESS( VerifyNextDocument( parser, concatenated, &offset, "{\"x\":true}", 16 ) );
+    JL_ASSERT_SUCCESS( VerifyNextDocument( parser, concatenated, &offset, "\"y\"", 19 ) );
+    JL_ASSERT_SUCCESS( VerifyNextDocument( parser, concatenated, &offset, "null", 23 ) );
+    JL_ASSERT_STATUS( JlParserParseNextDocument( parser, concatenated, sizeof(concatenated)-1, &offset, &objectTree, NULL ), JL_STATUS_END_OF_DATA );
+
+    // An error leaves the offset at the start of the bad document, so the caller can skip the line and carry on
+    offset = 0;
+    JL_ASSERT_SUCCESS( VerifyNextDocument( parser, withError, &offset, "{\"a\":1}", 7 ) );
+    JL_ASSERT_STATUS( JlParserParseNextDocument( parser, withError, sizeof(withError)-1, &offset, &objectTree, &errorAtPos ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT( 7 == offset );
+    JL_ASSERT( 13 == errorAtPos );
+    JL_ASSERT_NULL( objectTree );
+    offset = (size_t)( strchr( withError + offset + 1, '\n' ) - withError );
+    JL_ASSERT_SUCCESS( VerifyNextDocument( parser, withError, &offset, "[3]", 19 ) );
+
+    // An incomplete last document is an error rather than the end
+    offset = 0;
+    JL_ASSERT_SUCCESS( VerifyNextDocument( parser, "[1]\n[2,", &offset, "[1]", 3 ) );
+    JL_ASSERT_STATUS( JlParserParseNextDocument( parser, "[1]\n[2,", 7, &offset, &objectTree, &errorAtPos ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT( 3 == offset );
+    JL_ASSERT_NULL( objectTree );
+
+    if( IsJson5 )
+    {
+        offset = 0;
+        JL_ASSERT_SUCCESS( VerifyNextDocument( parser, "1 // one\n/* two */ [2,] // end", &offset, "1", 1 ) );
+        JL_ASSERT_SUCCESS( VerifyNextDocument( parser, "1 // one\n/* two */ [2,] // end", &offset, "[2]", 23 ) );
+        JL_ASSERT_STATUS( JlParserParseNextDocument( parser, "1 // one\n/* two */ [2,] // end", 30, &offset, &objectTree, NULL ), JL_STATUS_END_OF_DATA );
+    }
+
+    // A projection set on the parser applies to each document
+    JL_ASSERT_SUCCESS( JlParserSetProjection( parser, projection, 1 ) );
+    offset = 0;
+    JL_ASSERT_SUCCESS( VerifyNextDocument( parser, "{\"a\":1,\"b\":2}\n{\"b\":3}", &offset, "{\"a\":1}", 13 ) );
+    JL_ASSERT_SUCCESS( VerifyNextDocument( parser, "{\"a\":1,\"b\":2}\n{\"b\":3}", &offset, "{}", 21 ) );
+
+    JL_ASSERT_SUCCESS( JlParserFree( &parser ) );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestParserFeed
+//
+//  Tests parsing a document that is given to the parser in chunks
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestParserFeed
+    (
+        bool        IsJson5
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlParser* parser = NULL;
+    JlDataObject* objectTree = NULL;
+    uint64_t u64 = 0;
+    size_t errorAtPos = 0;
+    char const* documents[] = {
+        "{\"a\":[1,-2.5e+3,true,false,null],\"key\\\"x\":\"esc \\\\ \\/ \\n \\u0041\\ud83d\\ude00\",\"n\":{\"deep\":[[],{}]}}",
+        "  [ 12345678901234 , 0.000001 , -0 , \"\" , \"null\" ]  ",
+        " 123 ",
+        "\"string\"",
+        "true",
+        "false",
+        "null",
+        "[[[[[[[[[[\"nested\"]]]]]]]]]]",
+        "{\"a\":[1,2,}",
+        "[1,2",
+        "{\"a\" 1}",
+        "\"abc\\q\"",
+        "[tru]",
+        "{\"a\":1,\"a\":2}",
+        "[1] [2]",
+        "\"ctrl\x01\"",
+        "\"\\ud83d\\u0041\"",
+        "",
+        "   ",
+    };
+    char const* documents5[] = {
+        "{a:1, 'b':'single \\\r\n quoted', /* c */ c:[0x1F, +5, .5, 5.,], // end\n d:\"\\t\"}",
+        "// comment\n[1,2,3,] /* trailing */",
+        "\xef\xbb\xbf[ \xc2\xa0 1 \xe2\x80\xa8 ]",
+        "-inf",
+        "+inf",
+        "nan",
+        "0xFFFFFFFFFFFFFFFF",
+        "{$_x1:'\\u0041'}",
+        "[0x]",
+        "{a b}",
+    };
+
+    JL_ASSERT_SUCCESS( JlParserCreate( IsJson5 ? JL_PARSE_FLAGS_JSON5 : JL_PARSE_FLAGS_NONE, &parser ) );
+
+    JL_ASSERT_STATUS( JlParserFeed( NULL, "1", 1, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserFeed( parser, NULL, 1, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserFinish( NULL, &objectTree, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserFinish( parser, NULL, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserReset( NULL ), JL_STATUS_INVALID_PARAMETER );
+
+    // Nothing fed is the same as an empty document
+    JL_ASSERT_STATUS( JlParserFinish( parser, &objectTree, NULL ), JL_STATUS_END_OF_DATA );
+    JL_ASSERT_SUCCESS( JlParserFeed( parser, NULL, 0, NULL ) );
+    JL_ASSERT_SUCCESS( JlParserFeed( parser, "7", 1, NULL ) );
+    JL_ASSERT_SUCCESS( JlParserFeed( parser, "", 0, NULL ) );
+    JL_ASSERT_SUCCESS( JlParserFinish( parser, &objectTree, NULL ) );
+    JL_ASSERT_SUCCESS( JlGetObjectNumberU64( objectTree, &u64 ) );
+    JL_ASSERT( 7 == u64 );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+    for( size_t i=0; i<NumElements( documents ); i++ )
+    {
+        JL_ASSERT_SUCCESS( CheckChunkedParse( parser, IsJson5, documents[i] ) );
+    }
+    if( IsJson5 )
+    {
+        for( size_t i=0; i<NumElements( documents5 ); i++ )
+        {
+            JL_ASSERT_SUCCESS( CheckChunkedParse( parser, IsJson5, documents5[i] ) );
+        }
+    }
+
+    // Errors are returned as soon as they are seen, and the position is from the start of the first chunk
+    JL_ASSERT_SUCCESS( JlParserFeed( parser, "[1,2,", 5, &errorAtPos ) );
+    JL_ASSERT_STATUS( JlParserFeed( parser, "3,,4]", 5, &errorAtPos ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT( 7 == errorAtPos );
+    errorAtPos = 0;
+    JL_ASSERT_STATUS( JlParserFeed( parser, "5]", 2, &errorAtPos ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT( 7 == errorAtPos );
+    JL_ASSERT_STATUS( JlParserFinish( parser, &objectTree, &errorAtPos ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT_NULL( objectTree );
+
+    // Reset discards a partial document
+    JL_ASSERT_SUCCESS( JlParserFeed( parser, "{\"a\":[\"abc", 10, NULL ) );
+    JL_ASSERT_SUCCESS( JlParserReset( parser ) );
+    JL_ASSERT_SUCCESS( JlParserFeed( parser, "[\"abc\"]", 7, NULL ) );
+    JL_ASSERT_SUCCESS( JlParserFinish( parser, &objectTree, NULL ) );
+    JL_ASSERT( 1 == JlGetListCount( objectTree ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+    // Partial document discarded by JlParserParse and JlParserFree
+    JL_ASSERT_SUCCESS( JlParserFeed( parser, "{\"a\":[\"abc", 10, NULL ) );
+    JL_ASSERT_SUCCESS( JlParserParse( parser, "[1]", 3, &objectTree, NULL ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+    JL_ASSERT_SUCCESS( JlParserFeed( parser, "{\"a\":[\"abc", 10, NULL ) );
+
+    JL_ASSERT_SUCCESS( JlParserFree( &parser ) );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  NdjsonRecordDocument
+//
+//  JL_NDJSON_DOCUMENT_FUNCTION for TestNdjsonParallel. Checks each document against its line in the test data.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+JL_STATUS
+    NdjsonRecordDocument
+    (
+        void*           Context,
+        size_t          Offset,
+        JL_STATUS       ParseStatus,
+        size_t          ErrorAtPos,
+        JlDataObject**  pRootObject
+    )
+{
+    NdjsonRecord* record = (NdjsonRecord*)Context;
+    size_t line = Offset / record->LineLength;
+    JlDataObject* idObject = NULL;
+    uint64_t id = 0;
+
+    if(     record->InOrder
+        &&  record->NumDocuments > 0
+        &&  Offset <= record->LastOffset )
+    {
+        record->OutOfOrder = true;
+    }
+    record->LastOffset = Offset;
+
+    if(     0 != Offset % record->LineLength
+        ||  line >= NDJSON_NUM_LINES
+        ||  record->Seen[line] )
+    {
+        record->Mismatch = true;
+    }
+    else
+    {
+        record->Seen[line] = true;
+    }
+
+    if( JL_STATUS_SUCCESS == ParseStatus )
+    {
+        if(     JL_STATUS_SUCCESS != JlGetObjectFromDictionaryByKey( *pRootObject, "id", &idObject )
+            ||  JL_STATUS_SUCCESS != JlGetObjectNumberU64( idObject, &id )
+            ||  id != line )
+        {
+            record->Mismatch = true;
+        }
+        if( NULL == record->KeptObject )
+        {
+            record->KeptObject = *pRootObject;
+            *pRootObject = NULL;
+        }
+    }
+    else
+    {
+        record->NumErrors += 1;
+        if(     0 != line % NDJSON_BAD_LINE_INTERVAL
+            ||  NULL != *pRootObject
+            ||  ErrorAtPos <= Offset )
+        {
+            record->Mismatch = true;
+        }
+    }
+
+    record->NumDocuments += 1;
+    return ( record->NumDocuments == record->StopAfter ) ? JL_STATUS_NOT_FOUND : JL_STATUS_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestNdjsonParallel
+//
+//  Tests parsing NDJSON on several threads with JlParseNdjsonParallel, with the documents delivered in order and as
+//  they are ready.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestNdjsonParallel
+    (
+        bool        IsJson5
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    NdjsonRecord* record = NULL;
+    char* ndjson = NULL;
+    size_t lineLength = (size_t)snprintf( NULL, 0, "{\"id\":%-8u,\"v\":[true,\"text\"]}\n", 0u );
+    size_t ndjsonLength = lineLength * NDJSON_NUM_LINES;
+    size_t const numBadLines = ( NDJSON_NUM_LINES + NDJSON_BAD_LINE_INTERVAL - 1 ) / NDJSON_BAD_LINE_INTERVAL;
+    uint32_t const numThreads[] = { 1, 4, 0 };
+
+    record = JlAlloc( sizeof(NdjsonRecord) );
+    ndjson = JlAlloc( ndjsonLength + 1 );
+    JL_ASSERT_NOT_NULL( record );
+    JL_ASSERT_NOT_NULL( ndjson );
+    if( NULL != record && NULL != ndjson )
+    {
+        for( size_t i=0; i<NDJSON_NUM_LINES; i++ )
+        {
+            char const* format = ( 0 == i % NDJSON_BAD_LINE_INTERVAL )
+                ? "{\"id\":%-8u,\"v\":[true,\"text\"]]\n"
+                : "{\"id\":%-8u,\"v\":[true,\"text\"]}\n";
+            snprintf( ndjson + i*lineLength, lineLength + 1, format, (unsigned)i );
+        }
+
+        JL_ASSERT_STATUS( JlParseNdjsonParallel( NULL, 0, IsJson5, 1, true, NdjsonRecordDocument, record ), JL_STATUS_INVALID_PARAMETER );
+        JL_ASSERT_STATUS( JlParseNdjsonParallel( ndjson, ndjsonLength, IsJson5, 1, true, NULL, record ), JL_STATUS_INVALID_PARAMETER );
+
+        // Nothing to parse
+        memset( record, 0, sizeof(NdjsonRecord) );
+        record->LineLength = lineLength;
+        JL_ASSERT_SUCCESS( JlParseNdjsonParallel( ndjson, 0, IsJson5, 4, true, NdjsonRecordDocument, record ) );
+        JL_ASSERT( 0 == record->NumDocuments );
+
+        for( size_t i=0; i<NumElements( numThreads ) * 2; i++ )
+        {
+            bool inOrder = ( 0 == i % 2 );
+
+            // The last line has no newline
+            memset( record, 0, sizeof(NdjsonRecord) );
+            record->LineLength = lineLength;
+            record->InOrder = inOrder;
+            JL_ASSERT_SUCCESS( JlParseNdjsonParallel(
+                ndjson, ndjsonLength-1, IsJson5, numThreads[i/2], inOrder, NdjsonRecordDocument, record ) );
+            JL_ASSERT( NDJSON_NUM_LINES == record->NumDocuments );
+            JL_ASSERT( numBadLines == record->NumErrors );
+            JL_ASSERT( !record->OutOfOrder );
+            JL_ASSERT( !record->Mismatch );
+            JL_ASSERT_NOT_NULL( record->KeptObject );
+            if( NULL != record->KeptObject )
+            {
+                JL_ASSERT_SUCCESS( JlFreeObjectTree( &record->KeptObject ) );
+            }
+
+            // The callback failing stops the parse straight away
+            memset( record, 0, sizeof(NdjsonRecord) );
+            record->LineLength = lineLength;
+            record->InOrder = inOrder;
+            record->StopAfter = 100;
+            JL_ASSERT_STATUS( JlParseNdjsonParallel(
+                ndjson, ndjsonLength, IsJson5, numThreads[i/2], inOrder, NdjsonRecordDocument, record ),
+                JL_STATUS_NOT_FOUND );
+            JL_ASSERT( 100 == record->NumDocuments );
+            JL_ASSERT( !record->OutOfOrder );
+            JL_ASSERT( !record->Mismatch );
+            if( NULL != record->KeptObject )
+            {
+                JL_ASSERT_SUCCESS( JlFreeObjectTree( &record->KeptObject ) );
+            }
+        }
+    }
+
+    if( NULL != ndjson )
+    {
+        JlFree( ndjson );
+    }
+    if( NULL != record )
+    {
+        JlFree( record );
+    }
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  VerifyMatchesParse
+//
+//  Checks that Status, *pObjectTree, and ErrorAtPos from parsing Json in some other way are the same as the result of
+//  JlParseJsonBuffer. The trees must output the same JSON and have the same tags on the root and on the elements of a
+//  root list. On an error *pObjectTree must be NULL and the error must be at the same position. *pObjectTree is freed.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    VerifyMatchesParse
+    (
+        bool            IsJson5,
+        char const*     Json,
+        size_t          JsonLength,
+        JL_STATUS       Status,
+        JlDataObject**  pObjectTree,
+        size_t          ErrorAtPos
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlDataObject* expectedTree = NULL;
+    char* expectedJson = NULL;
+    char* outputJson = NULL;
+    size_t expectedErrorAtPos = 0;
+    JL_STATUS expectedStatus;
+
+    expectedStatus = JlParseJsonBuffer( Json, JsonLength, IsJson5, &expectedTree, &expectedErrorAtPos );
+    JL_ASSERT_STATUS( Status, expectedStatus );
+    if( JL_STATUS_SUCCESS == expectedStatus && JL_STATUS_SUCCESS == Status )
+    {
+        JlListItem* expectedEnumerator = NULL;
+        JlListItem* enumerator = NULL;
+        JlDataObject* expectedItem = NULL;
+        JlDataObject* item = NULL;
+
+        JL_ASSERT_SUCCESS( JlOutputJson( expectedTree, false, &expectedJson ) );
+        JL_ASSERT_SUCCESS( JlOutputJson( *pObjectTree, false, &outputJson ) );
+        JL_ASSERT( NULL != outputJson && NULL != expectedJson && strcmp( outputJson, expectedJson ) == 0 );
+        JL_ASSERT( JlGetObjectTag( *pObjectTree ) == JlGetObjectTag( expectedTree ) );
+        while( JL_STATUS_SUCCESS == JlGetObjectListNextItem( expectedTree, &expectedItem, &expectedEnumerator ) )
+        {
+            JL_ASSERT_SUCCESS( JlGetObjectListNextItem( *pObjectTree, &item, &enumerator ) );
+            JL_ASSERT( JlGetObjectTag( item ) == JlGetObjectTag( expectedItem ) );
+        }
+        JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &outputJson ) );
+        JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &expectedJson ) );
+    }
+    else
+    {
+        JL_ASSERT_NULL( *pObjectTree );
+        JL_ASSERT( ErrorAtPos == expectedErrorAtPos );
+    }
+
+    if( NULL != *pObjectTree )
+    {
+        JL_ASSERT_SUCCESS( JlFreeObjectTree( pObjectTree ) );
+    }
+    if( NULL != expectedTree )
+    {
+        JL_ASSERT_SUCCESS( JlFreeObjectTree( &expectedTree ) );
+    }
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  VerifyParallelMatchesParse
+//
+//  Checks that JlParseJsonParallel gives the same result as JlParseJsonBuffer, with the same tags on the elements of
+//  the root list, and reports errors at the same position.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    VerifyParallelMatchesParse
+    (
+        bool            IsJson5,
+        char const*     Json,
+        size_t          JsonLength,
+        uint32_t        NumThreads
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlDataObject* objectTree = NULL;
+    size_t errorAtPos = 0;
+    JL_STATUS status;
+
+    status = JlParseJsonParallel( Json, JsonLength, IsJson5, NumThreads, &objectTree, &errorAtPos );
+    JL_ASSERT_SUCCESS( VerifyMatchesParse( IsJson5, Json, JsonLength, status, &objectTree, errorAtPos ) );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestParallelList
+//
+//  Tests parsing a large root list on several threads with JlParseJsonParallel, including documents where the split
+//  points are guessed wrongly and the parse has to be done again on one thread.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestParallelList
+    (
+        bool        IsJson5
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    size_t const numRecords = 40000;
+    size_t const bufferSize = numRecords * 100;
+    char* json = JlAlloc( bufferSize );
+    size_t length = 0;
+    JlDataObject* objectTree = NULL;
+    uint32_t const numThreads[] = { 1, 3, 0 };
+
+    JL_ASSERT_NOT_NULL( json );
+    if( NULL != json )
+    {
+        JL_ASSERT_STATUS( JlParseJsonParallel( NULL, 0, IsJson5, 2, &objectTree, NULL ), JL_STATUS_INVALID_PARAMETER );
+        JL_ASSERT_STATUS( JlParseJsonParallel( "[]", 2, IsJson5, 2, NULL, NULL ), JL_STATUS_INVALID_PARAMETER );
+
+        // Small documents, which are not split
+        JL_ASSERT_SUCCESS( VerifyParallelMatchesParse( IsJson5, "[1,2,3]", 7, 2 ) );
+        JL_ASSERT_SUCCESS( VerifyParallelMatchesParse( IsJson5, " {\"a\":[1,2]} ", 13, 2 ) );
+        JL_ASSERT_SUCCESS( VerifyParallelMatchesParse( IsJson5, "[1,2,", 5, 2 ) );
+
+        // Records with commas, brackets, and quotes in strings, one per line
+        length = (size_t)snprintf( json, bufferSize, "[\n" );
+        for( size_t i=0; i<numRecords; i++ )
+        {
+            length += (size_t)snprintf( json + length, bufferSize - length,
+                "%s{\"id\":%u,\"s\":\"a,b],[c\\\"}\",\"l\":[1,[2,-3.5]],\"d\":{\"x\":null}}\n",
+                i > 0 ? "," : "", (unsigned)i );
+        }
+        length += (size_t)snprintf( json + length, bufferSize - length, "]\n" );
+        for( size_t i=0; i<NumElements( numThreads ); i++ )
+        {
+            JL_ASSERT_SUCCESS( VerifyParallelMatchesParse( IsJson5, json, length, numThreads[i] ) );
+        }
+
+        // An error near the end is reported at the same place
+        json[length - 10] = '!';
+        JL_ASSERT_SUCCESS( VerifyParallelMatchesParse( IsJson5, json, length, 3 ) );
+
+        // The records with commas in a comment at the end of each line
+        if( IsJson5 )
+        {
+            length = (size_t)snprintf( json, bufferSize, "[ // records\n" );
+            for( size_t i=0; i<numRecords; i++ )
+            {
+                length += (size_t)snprintf( json + length, bufferSize - length,
+                    "%s{id:%u,s:'a,b],[c\\'\"'} // next, [ or {\n", i > 0 ? "," : "", (unsigned)i );
+            }
+            length += (size_t)snprintf( json + length, bufferSize - length, "] /* end, ] */" );
+            JL_ASSERT_SUCCESS( VerifyParallelMatchesParse( IsJson5, json, length, 3 ) );
+        }
+
+        // A list of numbers, all on one line
+        length = (size_t)snprintf( json, bufferSize, "[" );
+        for( size_t i=0; i<numRecords*10; i++ )
+        {
+            length += (size_t)snprintf( json + length, bufferSize - length, "%s%u", i > 0 ? "," : "", (unsigned)i );
+        }
+        length += (size_t)snprintf( json + length, bufferSize - length, "]" );
+        JL_ASSERT_SUCCESS( VerifyParallelMatchesParse( IsJson5, json, length, 3 ) );
+
+        // A single huge element, where the splits land inside it
+        memmove( json + 1, json, length );
+        json[length + 1] = ']';
+        length += 2;
+        JL_ASSERT_SUCCESS( VerifyParallelMatchesParse( IsJson5, json, length, 3 ) );
+
+        // The root list ends before the only comma, which must not be treated as a split between elements
+        memset( json, ' ', bufferSize );
+        memcpy( json, "[0]\n", 4 );
+        memcpy( json + bufferSize / 3 + 10, ",1]", 3 );
+        JL_ASSERT_SUCCESS( VerifyParallelMatchesParse( IsJson5, json, bufferSize, 3 ) );
+
+        JlFree( json );
+    }
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  VerifyIovMatchesParse
+//
+//  Checks that JlParseJsonIov with Json cut into segments of SegmentSize bytes gives the same result as
+//  JlParseJsonBuffer, and reports errors at the same position.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    VerifyIovMatchesParse
+    (
+        bool            IsJson5,
+        char const*     Json,
+        size_t          SegmentSize
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlDataObject* objectTree = NULL;
+    size_t errorAtPos = 0;
+    size_t jsonLength = strlen( Json );
+    size_t numSegments = ( jsonLength + SegmentSize - 1 ) / SegmentSize;
+    JlIoVec* segments = JlAlloc( ( numSegments + 1 ) * sizeof(JlIoVec) );
+    JL_STATUS status;
+
+    JL_ASSERT_NOT_NULL( segments );
+    if( NULL != segments )
+    {
+        for( size_t i=0; i<numSegments; i++ )
+        {
+            segments[i].Base = Json + i*SegmentSize;
+            segments[i].Length = ( jsonLength - i*SegmentSize < SegmentSize ) ? jsonLength - i*SegmentSize : SegmentSize;
+        }
+
+        status = JlParseJsonIov( segments, numSegments, IsJson5, &objectTree, &errorAtPos );
+        JL_ASSERT_SUCCESS( VerifyMatchesParse( IsJson5, Json, jsonLength, status, &objectTree, errorAtPos ) );
+
+        JlFree( segments );
+    }
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestParseIov
+//
+//  Tests parsing a document held in several separate buffers with JlParseJsonIov
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestParseIov
+    (
+        bool        IsJson5
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlDataObject* objectTree = NULL;
+    size_t errorAtPos = 0;
+    size_t const segmentSizes[] = { 1, 2, 7, 64, 100, 1000, 16384 };
+    size_t const bufferSize = 30000;
+    char* json = JlAlloc( bufferSize );
+    size_t length = 0;
+    JlIoVec segments[] = { { NULL, 0 }, { "[1,", 3 }, { "", 0 }, { "2]", 2 } };
+    JlIoVec badSegments[] = { { "[1,", 3 }, { "2,", 2 }, { "}]", 2 } };
+
+    JL_ASSERT_STATUS( JlParseJsonIov( NULL, 1, IsJson5, &objectTree, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParseJsonIov( segments, 4, IsJson5, NULL, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParseJsonIov( NULL, 0, IsJson5, &objectTree, NULL ), JL_STATUS_END_OF_DATA );
+    JL_ASSERT_NULL( objectTree );
+
+    // Empty segments are skipped over
+    JL_ASSERT_SUCCESS( JlParseJsonIov( segments, 4, IsJson5, &objectTree, NULL ) );
+    JL_ASSERT( 2 == JlGetListCount( objectTree ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+    // Errors are reported at their position counted from the start of the first segment
+    JL_ASSERT_STATUS( JlParseJsonIov( badSegments, 3, IsJson5, &objectTree, &errorAtPos ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT( 5 == errorAtPos );
+    JL_ASSERT_NULL( objectTree );
+
+    // Long strings and numbers, so that tokens run over several segments
+    JL_ASSERT_NOT_NULL( json );
+    if( NULL != json )
+    {
+        length = (size_t)snprintf( json, bufferSize, "{\"list\":[" );
+        for( size_t i=0; i<100; i++ )
+        {
+            length += (size_t)snprintf( json + length, bufferSize - length,
+                "%s{\"n\":%u.%u,\"s\":\"%0*u \\u00e9\\\" x\"}", i > 0 ? "," : "", (unsigned)i, (unsigned)i * 7919, (int)( i * 3 ), 0 );
+        }
+        length += (size_t)snprintf( json + length, bufferSize - length, "],\"end\":true}" );
+        for( size_t i=0; i<NumElements( segmentSizes ); i++ )
+        {
+            JL_ASSERT_SUCCESS( VerifyIovMatchesParse( IsJson5, json, segmentSizes[i] ) );
+        }
+
+        // An error late in the document is reported at the same position
+        json[length - 6] = 'x';
+        for( size_t i=0; i<NumElements( segmentSizes ); i++ )
+        {
+            JL_ASSERT_SUCCESS( VerifyIovMatchesParse( IsJson5, json, segmentSizes[i] ) );
+        }
+
+        if( IsJson5 )
+        {
+            for( size_t i=0; i<NumElements( segmentSizes ); i++ )
+            {
+                JL_ASSERT_SUCCESS( VerifyIovMatchesParse( IsJson5,
+                    "// start\n{a:[0x1F,+5,.5,'single \\' quoted',],/* long comment that goes on for a while */b:nan}",
+                    segmentSizes[i] ) );
+            }
+        }
+
+        JlFree( json );
+    }
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  WriteTestFile
+//
+//  Writes Length bytes of Data to the file used by TestParseFile. Returns false if it could not be written.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+bool
+    WriteTestFile
+    (
+        char const*     Data,
+        size_t          Length
+    )
+{
+    bool success = false;
+    FILE* file = fopen( PARSE_FILE_TEST_FILENAME, "wb" );
+
+    if( NULL != file )
+    {
+        success = ( fwrite( Data, 1, Length, file ) == Length );
+        success = ( 0 == fclose( file ) ) && success;
+    }
+
+    return success;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestParseFile
+//
+//  Tests parsing a file with JlParseJsonFile
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestParseFile
+    (
+        bool        IsJson5
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlDataObject* objectTree = NULL;
+    char* outputJson = NULL;
+    size_t errorAtPos = 0;
+    size_t expectedErrorAtPos = 0;
+    char const* json = "{\"a\":[1,2.5,\"three\"],\"b\":{\"c\":null}}";
+    char const* invalidJson = "{\"a\":[1,2.5,\"three\"],\"b\":{\"c\":nul}}";
+
+    JL_ASSERT_STATUS( JlParseJsonFile( NULL, IsJson5, &objectTree, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParseJsonFile( PARSE_FILE_TEST_FILENAME, IsJson5, NULL, NULL ), JL_STATUS_INVALID_PARAMETER );
+
+    (void) remove( PARSE_FILE_TEST_FILENAME );
+    JL_ASSERT_STATUS( JlParseJsonFile( PARSE_FILE_TEST_FILENAME, IsJson5, &objectTree, &errorAtPos ), JL_STATUS_FILE_ERROR );
+    JL_ASSERT_NULL( objectTree );
+    JL_ASSERT_STATUS( JlParseJsonFile( ".", IsJson5, &objectTree, &errorAtPos ), JL_STATUS_FILE_ERROR );
+
+    // The file is not zero terminated when it is mapped, so the parse must stop at its end
+    JL_ASSERT( WriteTestFile( json, strlen( json ) ) );
+    JL_ASSERT_SUCCESS( JlParseJsonFile( PARSE_FILE_TEST_FILENAME, IsJson5, &objectTree, &errorAtPos ) );
+    JL_ASSERT_SUCCESS( JlOutputJson( objectTree, false, &outputJson ) );
+    JL_ASSERT( strcmp( outputJson, json ) == 0 );
+    JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &outputJson ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+    JL_ASSERT( WriteTestFile( json, 7 ) );
+    JL_ASSERT_STATUS( JlParseJsonFile( PARSE_FILE_TEST_FILENAME, IsJson5, &objectTree, &errorAtPos ), JL_STATUS_END_OF_DATA );
+    JL_ASSERT_NULL( objectTree );
+
+    JL_ASSERT( WriteTestFile( invalidJson, strlen( invalidJson ) ) );
+    JL_ASSERT_STATUS( JlParseJsonFile( PARSE_FILE_TEST_FILENAME, IsJson5, &objectTree, &errorAtPos ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT_NULL( objectTree );
+    JL_ASSERT_STATUS( JlParseJsonBuffer( invalidJson, strlen( invalidJson ), IsJson5, &objectTree, &expectedErrorAtPos ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT( errorAtPos == expectedErrorAtPos );
+
+    // An empty file is the same as an empty buffer
+    JL_ASSERT( WriteTestFile( "", 0 ) );
+    JL_ASSERT_STATUS( JlParseJsonFile( PARSE_FILE_TEST_FILENAME, IsJson5, &objectTree, &errorAtPos ), JL_STATUS_END_OF_DATA );
+    JL_ASSERT_NULL( objectTree );
+
+    JL_ASSERT( 0 == remove( PARSE_FILE_TEST_FILENAME ) );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  VerifyBudgetMatchesParse
+//
+//  Checks that JlParserParseWithBudget with a budget of ByteBudget bytes gives the same result as JlParseJsonBuffer,
+//  and reports errors at the same position. Each call must stop soon after it has used up its budget.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    VerifyBudgetMatchesParse
+    (
+        bool            IsJson5,
+        char const*     Json,
+        size_t          ByteBudget
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlParser* parser = NULL;
+    JlDataObject* objectTree = NULL;
+    size_t errorAtPos = 0;
+    size_t length = strlen( Json );
+    size_t numCalls = 0;
+    JL_STATUS status;
+
+    JL_ASSERT_SUCCESS( JlParserCreate( IsJson5 ? JL_PARSE_FLAGS_JSON5 : JL_PARSE_FLAGS_NONE, &parser ) );
+    do
+    {
+        status = JlParserParseWithBudget( parser, Json, length, ByteBudget, &objectTree, &errorAtPos );
+        numCalls += 1;
+    } while( JL_STATUS_IN_PROGRESS == status && numCalls <= length );
+
+    // A call can run past its budget by the length of one value, the longest in the test documents is under 400 bytes
+    JL_ASSERT( numCalls >= length / ( ByteBudget + 400 ) );
+    JL_ASSERT_SUCCESS( VerifyMatchesParse( IsJson5, Json, length, status, &objectTree, errorAtPos ) );
+    JL_ASSERT_SUCCESS( JlParserFree( &parser ) );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestParseWithBudget
+//
+//  Tests parsing a document a piece at a time with JlParserParseWithBudget
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestParseWithBudget
+    (
+        bool        IsJson5
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlParser* parser = NULL;
+    JlDataObject* objectTree = NULL;
+    size_t errorAtPos = 0;
+    size_t const budgets[] = { 1, 10, 100, 1000, 100000 };
+    size_t const bufferSize = 30000;
+    char* json = JlAlloc( bufferSize );
+    size_t length = 0;
+    char const* small = "[1,2,3,4,5,6,7,8,9]";
+
+    JL_ASSERT_SUCCESS( JlParserCreate( IsJson5 ? JL_PARSE_FLAGS_JSON5 : JL_PARSE_FLAGS_NONE, &parser ) );
+    JL_ASSERT_STATUS( JlParserParseWithBudget( NULL, small, strlen( small ), 4, &objectTree, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserParseWithBudget( parser, NULL, 0, 4, &objectTree, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserParseWithBudget( parser, small, strlen( small ), 0, &objectTree, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserParseWithBudget( parser, small, strlen( small ), 4, NULL, NULL ), JL_STATUS_INVALID_PARAMETER );
+    JL_ASSERT_STATUS( JlParserParseWithBudget( parser, "", 0, 4, &objectTree, &errorAtPos ), JL_STATUS_END_OF_DATA );
+    JL_ASSERT_NULL( objectTree );
+
+    JL_ASSERT_NOT_NULL( json );
+    if( NULL != json )
+    {
+        length = (size_t)snprintf( json, bufferSize, "{\"list\":[" );
+        for( size_t i=0; i<100; i++ )
+        {
+            length += (size_t)snprintf( json + length, bufferSize - length,
+                "%s{\"n\":%u.%u,\"s\":\"%0*u \\u00e9\\\" x\",\"d\":[[{}],[]]}", i > 0 ? "," : "", (unsigned)i + 1, (unsigned)i * 7919, (int)( i * 3 ), 0 );
+        }
+        length += (size_t)snprintf( json + length, bufferSize - length, "],\"end\":true}" );
+        for( size_t i=0; i<NumElements( budgets ); i++ )
+        {
+            JL_ASSERT_SUCCESS( VerifyBudgetMatchesParse( IsJson5, json, budgets[i] ) );
+        }
+
+        // Switching to another buffer part way through starts again with the new one
+        JL_ASSERT_STATUS( JlParserParseWithBudget( parser, json, length, 1000, &objectTree, NULL ), JL_STATUS_IN_PROGRESS );
+        JL_ASSERT_NULL( objectTree );
+        JL_ASSERT_SUCCESS( JlParserParseWithBudget( parser, small, strlen( small ), 1000, &objectTree, NULL ) );
+        JL_ASSERT( 9 == JlGetListCount( objectTree ) );
+        JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+        // As does any other parse call
+        JL_ASSERT_STATUS( JlParserParseWithBudget( parser, json, length, 1000, &objectTree, NULL ), JL_STATUS_IN_PROGRESS );
+        JL_ASSERT_SUCCESS( JlParserParse( parser, small, strlen( small ), &objectTree, NULL ) );
+        JL_ASSERT( 9 == JlGetListCount( objectTree ) );
+        JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+        JL_ASSERT_STATUS( JlParserParseWithBudget( parser, json, length, 1000, &objectTree, NULL ), JL_STATUS_IN_PROGRESS );
+        JL_ASSERT_SUCCESS( JlParserReset( parser ) );
+        JL_ASSERT_STATUS( JlParserParseWithBudget( parser, json, length, 1000, &objectTree, NULL ), JL_STATUS_IN_PROGRESS );
+
+        // An error late in the document is reported at the same position
+        json[length - 3] = 'X';
+        for( size_t i=0; i<NumElements( budgets ); i++ )
+        {
+            JL_ASSERT_SUCCESS( VerifyBudgetMatchesParse( IsJson5, json, budgets[i] ) );
+        }
+
+        JlFree( json );
+    }
+
+    // Freeing the parser part way through a document frees what has been parsed so far
+    JL_ASSERT_SUCCESS( JlParserFree( &parser ) );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestBudgetThenFeed
+//
+//  Tests that a document abandoned part way through JlParserParseWithBudget does not leave its settings (lazy and
+//  raw values, projection) behind for a document fed in chunks that do not outlive the JlParserFeed call.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestBudgetThenFeed
+    (
+        void
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlParser* parser = NULL;
+    JlDataObject* objectTree = NULL;
+    JlDataObject* stringObject = NULL;
+    char const* string = NULL;
+    char* outputJson = NULL;
+    char* chunk = NULL;
+    char const* budgetJson = "{\"k\":{\"x\":\"budget\\tstring\",\"n\":7},\"s\":\"end\"}";
+    char const* feedJson = "{\"k\":{\"x\":\"fed\\nstring\",\"n\":15}}";
+    char const* paths[] = { "/z" };
+    JL_PARSE_FLAGS const flags = JL_PARSE_FLAGS_LAZY | JL_PARSE_FLAGS_RAW_NUMBERS | JL_PARSE_FLAGS_RAW_STRINGS;
+
+    JL_ASSERT_SUCCESS( JlParserCreate( flags, &parser ) );
+    JL_ASSERT_SUCCESS( JlParserSetProjection( parser, paths, NumElements( paths ) ) );
+
+    // Once with an explicit reset, and once with the reset that JlParserFeed does itself
+    for( int i=0; i<2; i++ )
+    {
+        JL_ASSERT_STATUS( JlParserParseWithBudget( parser, budgetJson, strlen( budgetJson ), 4, &objectTree, NULL ),
+            JL_STATUS_IN_PROGRESS );
+        if( 0 == i )
+        {
+            JL_ASSERT_SUCCESS( JlParserReset( parser ) );
+        }
+
+        chunk = AllocString( feedJson );
+        JL_ASSERT_NOT_NULL( chunk );
+        JL_ASSERT_SUCCESS( JlParserFeed( parser, chunk, strlen( chunk ), NULL ) );
+        JlFree( chunk );
+        chunk = NULL;
+        JL_ASSERT_SUCCESS( JlParserFinish( parser, &objectTree, NULL ) );
+
+        JL_ASSERT_SUCCESS( JlGetObjectFromDictionaryByKey( objectTree, "k", &stringObject ) );
+        JL_ASSERT_SUCCESS( JlGetObjectFromDictionaryByKey( stringObject, "x", &stringObject ) );
+        JL_ASSERT_SUCCESS( JlGetObjectString( stringObject, &string ) );
+        JL_ASSERT( strcmp( string, "fed\nstring" ) == 0 );
+        JL_ASSERT_SUCCESS( JlOutputJson( objectTree, false, &outputJson ) );
+        JL_ASSERT( strcmp( outputJson, "{\"k\":{\"x\":\"fed\\nstring\",\"n\":15}}" ) == 0 );
+        JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &outputJson ) );
+        JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+    }
+
+    JL_ASSERT_SUCCESS( JlParserFree( &parser ) );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestParseLimits
+//
+//  Tests the limits set with JlParserSetLimits
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestParseLimits
+    (
+        bool        IsJson5
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlParser* parser = NULL;
+    JlDataObject* objectTree = NULL;
+    size_t errorAtPos = 0;
+    JlParseLimits limits;
+    JlParseCallbacks callbacks = { 0 };
+    size_t const numZeros = 100000;
+    char* zeros = JlAlloc( numZeros * 2 + 1 );
+    char const* list = "[1,2,3]";
+    char const* longerList = "[1,2,3,4]";
+    char const* lists = "{\"a\":[1,2],\"b\":[1,2,3]}";
+    char const* strings = "[\"abc\",\"de\\u00e9f\"]";
+    char const* key = "{\"abcdef\":1}";
+
+    JL_ASSERT_SUCCESS( JlParserCreate( IsJson5 ? JL_PARSE_FLAGS_JSON5 : JL_PARSE_FLAGS_NONE, &parser ) );
+    JL_ASSERT_STATUS( JlParserSetLimits( NULL, NULL ), JL_STATUS_INVALID_PARAMETER );
+
+    // Number of values, which includes the list itself
+    memset( &limits, 0, sizeof(limits) );
+    limits.MaxValues = 4;
+    JL_ASSERT_SUCCESS( JlParserSetLimits( parser, &limits ) );
+    JL_ASSERT_SUCCESS( JlParserParse( parser, list, strlen( list ), &objectTree, NULL ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+    limits.MaxValues = 3;
+    JL_ASSERT_SUCCESS( JlParserSetLimits( parser, &limits ) );
+    JL_ASSERT_STATUS( JlParserParse( parser, list, strlen( list ), &objectTree, &errorAtPos ), JL_STATUS_LIMIT_EXCEEDED );
+    JL_ASSERT_NULL( objectTree );
+    JL_ASSERT( 5 == errorAtPos );
+
+    // The limits stay set for the next document, and apply to feeding and events
+    JL_ASSERT_STATUS( JlParserParse( parser, list, strlen( list ), &objectTree, NULL ), JL_STATUS_LIMIT_EXCEEDED );
+    JL_ASSERT_SUCCESS( JlParserFeed( parser, longerList, 4, NULL ) );
+    JL_ASSERT_STATUS( JlParserFeed( parser, longerList + 4, strlen( longerList ) - 4, &errorAtPos ), JL_STATUS_LIMIT_EXCEEDED );
+    JL_ASSERT( 5 == errorAtPos );
+    JL_ASSERT_STATUS( JlParserFinish( parser, &objectTree, NULL ), JL_STATUS_LIMIT_EXCEEDED );
+    JL_ASSERT_NULL( objectTree );
+    JL_ASSERT_STATUS( JlParserParseEvents( parser, list, strlen( list ), &callbacks, NULL, NULL ), JL_STATUS_LIMIT_EXCEEDED );
+
+    // Number of values in any one list or dictionary
+    memset( &limits, 0, sizeof(limits) );
+    limits.MaxItems = 3;
+    JL_ASSERT_SUCCESS( JlParserSetLimits( parser, &limits ) );
+    JL_ASSERT_SUCCESS( JlParserParse( parser, lists, strlen( lists ), &objectTree, NULL ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+    limits.MaxItems = 2;
+    JL_ASSERT_SUCCESS( JlParserSetLimits( parser, &limits ) );
+    JL_ASSERT_STATUS( JlParserParse( parser, lists, strlen( lists ), &objectTree, &errorAtPos ), JL_STATUS_LIMIT_EXCEEDED );
+    JL_ASSERT_NULL( objectTree );
+    JL_ASSERT( 20 == errorAtPos );
+
+    // String length is counted after escapes are processed, for both strings and key names
+    memset( &limits, 0, sizeof(limits) );
+    limits.MaxStringLength = 5;
+    JL_ASSERT_SUCCESS( JlParserSetLimits( parser, &limits ) );
+    JL_ASSERT_SUCCESS( JlParserParse( parser, strings, strlen( strings ), &objectTree, NULL ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+    JL_ASSERT_STATUS( JlParserParse( parser, key, strlen( key ), &objectTree, NULL ), JL_STATUS_LIMIT_EXCEEDED );
+    JL_ASSERT_NULL( objectTree );
+    limits.MaxStringLength = 4;
+    JL_ASSERT_SUCCESS( JlParserSetLimits( parser, &limits ) );
+    JL_ASSERT_STATUS( JlParserParse( parser, strings, strlen( strings ), &objectTree, NULL ), JL_STATUS_LIMIT_EXCEEDED );
+    JL_ASSERT_NULL( objectTree );
+
+    // Memory, a long list of zeros is stopped well before the end
+    JL_ASSERT_NOT_NULL( zeros );
+    if( NULL != zeros )
+    {
+        zeros[0] = '[';
+        for( size_t i=0; i<numZeros; i++ )
+        {
+            zeros[i*2+1] = '0';
+            zeros[i*2+2] = ( i+1 < numZeros ) ? ',' : ']';
+        }
+
+        memset( &limits, 0, sizeof(limits) );
+        limits.MaxBytes = 100000;
+        JL_ASSERT_SUCCESS( JlParserSetLimits( parser, &limits ) );
+        JL_ASSERT_STATUS( JlParserParse( parser, zeros, numZeros * 2 + 1, &objectTree, &errorAtPos ), JL_STATUS_LIMIT_EXCEEDED );
+        JL_ASSERT_NULL( objectTree );
+        JL_ASSERT( errorAtPos > 0 && errorAtPos < 100000 );
+
+        // Removing the limits lets it parse
+        JL_ASSERT_SUCCESS( JlParserSetLimits( parser, NULL ) );
+        JL_ASSERT_SUCCESS( JlParserParse( parser, zeros, numZeros * 2 + 1, &objectTree, NULL ) );
+        JL_ASSERT( numZeros == JlGetListCount( objectTree ) );
+        JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+        JlFree( zeros );
+    }
+
+    JL_ASSERT_SUCCESS( JlParserFree( &parser ) );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestRawNumbers
+//
+//  Tests parsing with JL_PARSE_FLAGS_RAW_NUMBERS, which keeps the text of plain numbers and converts it when read
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestRawNumbers
+    (
+        bool        IsJson5
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlParser* parser = NULL;
+    JlDataObject* objectTree = NULL;
+    JlDataObject* object = NULL;
+    JlListItem* enumerator = NULL;
+    char* outputJson = NULL;
+    char const* text = NULL;
+    size_t textLength = 0;
+    uint64_t numU64 = 0;
+    double numF64 = 0.0;
+    char const* json = "[1.50,-12.000,3,1e2,123456789012345678901234567890]";
+    JL_PARSE_FLAGS baseFlags = IsJson5 ? JL_PARSE_FLAGS_JSON5 : JL_PARSE_FLAGS_NONE;
+
+    // Without the flag numbers are converted while parsing and have no text
+    JL_ASSERT_SUCCESS( JlParserCreate( baseFlags, &parser ) );
+    JL_ASSERT_SUCCESS( JlParserParse( parser, json, strlen( json ), &objectTree, NULL ) );
+    JL_ASSERT_SUCCESS( JlGetObjectListNextItem( objectTree, &object, &enumerator ) );
+    JL_ASSERT_STATUS( JlGetObjectNumberText( object, &text, &textLength ), JL_STATUS_NOT_FOUND );
+    JL_ASSERT_STATUS( JlGetObjectNumberText( objectTree, &text, &textLength ), JL_STATUS_WRONG_TYPE );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+    JL_ASSERT_SUCCESS( JlParserFree( &parser ) );
+
+    // With the flag plain numbers are output exactly as they were, the one with an exponent is converted
+    JL_ASSERT_SUCCESS( JlParserCreate( baseFlags | JL_PARSE_FLAGS_RAW_NUMBERS, &parser ) );
+    JL_ASSERT_SUCCESS( JlParserParse( parser, json, strlen( json ), &objectTree, NULL ) );
+    JL_ASSERT_SUCCESS( JlOutputJson( objectTree, false, &outputJson ) );
+    JL_ASSERT( 0 == strcmp( outputJson, "[1.50,-12.000,3,100,123456789012345678901234567890]" ) );
+    JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &outputJson ) );
+
+    // Values are converted when read, and the text is still available afterwards
+    enumerator = NULL;
+    JL_ASSERT_SUCCESS( JlGetObjectListNextItem( objectTree, &object, &enumerator ) );
+    JL_ASSERT_SUCCESS( JlGetObjectNumberText( object, &text, &textLength ) );
+    JL_ASSERT( 4 == textLength && 0 == memcmp( text, "1.50", 4 ) );
+    JL_ASSERT( text == json + 1 );
+    JL_ASSERT_SUCCESS( JlGetObjectNumberF64( object, &numF64 ) );
+    JL_ASSERT( 1.5 == numF64 );
+    JL_ASSERT_SUCCESS( JlGetObjectNumberText( object, &text, &textLength ) );
+    JL_ASSERT( 4 == textLength );
+
+    JL_ASSERT_SUCCESS( JlGetObjectListNextItem( objectTree, &object, &enumerator ) );
+    JL_ASSERT( JL_NUM_TYPE_FLOAT == JlGetObjectNumberType( object ) );
+    JL_ASSERT_SUCCESS( JlGetObjectNumberF64( object, &numF64 ) );
+    JL_ASSERT( -12.0 == numF64 );
+
+    JL_ASSERT_SUCCESS( JlGetObjectListNextItem( objectTree, &object, &enumerator ) );
+    JL_ASSERT( JL_NUM_TYPE_UNSIGNED == JlGetObjectNumberType( object ) );
+    JL_ASSERT_SUCCESS( JlGetObjectNumberU64( object, &numU64 ) );
+    JL_ASSERT( 3 == numU64 );
+
+    // Setting a new value removes the text
+    JL_ASSERT_SUCCESS( JlSetObjectNumberU64( object, 4 ) );
+    JL_ASSERT_STATUS( JlGetObjectNumberText( object, &text, &textLength ), JL_STATUS_NOT_FOUND );
+
+    JL_ASSERT_SUCCESS( JlGetObjectListNextItem( objectTree, &object, &enumerator ) );
+    JL_ASSERT_STATUS( JlGetObjectNumberText( object, &text, &textLength ), JL_STATUS_NOT_FOUND );
+
+    JL_ASSERT_SUCCESS( JlOutputJson( objectTree, false, &outputJson ) );
+    JL_ASSERT( 0 == strcmp( outputJson, "[1.50,-12.000,4,100,123456789012345678901234567890]" ) );
+    JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &outputJson ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+    JL_ASSERT_SUCCESS( JlParserFree( &parser ) );
+
+    return TestReturn;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestRawStrings
+//
+//  Tests parsing with JL_PARSE_FLAGS_RAW_STRINGS, which keeps strings escaped until they are read
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestRawStrings
+    (
+        bool        IsJson5
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+    JlParser* parser = NULL;
+    JlDataObject* objectTree = NULL;
+    JlDataObject* object = NULL;
+    JlListItem* enumerator = NULL;
+    char* outputJson = NULL;
+    char const* string = NULL;
+    size_t errorAtPos = 0;
+    size_t rawErrorAtPos = 0;
+    char const* json = "[\"abc\",\"a\\\"b\\u00e9\\/\",\"\",{\"key\":\"x\\ty\"}]";
+    char const* rawOutput = "[\"abc\",\"a\\\"b\\u00e9\\/\",null,{\"key\":\"x\\ty\"}]";
+    char const* unescapedOutput = "[\"abc\",\"a\\\"b\xc3\xa9/\",null,{\"key\":\"x\\ty\"}]";
+    char const* badJson = "[\"abc\",\"a\\qb\"]";
+    char const* json5 = "['abc',\"a\\\nb\",\"c\"]";
+    JL_PARSE_FLAGS baseFlags = IsJson5 ? JL_PARSE_FLAGS_JSON5 : JL_PARSE_FLAGS_NONE;
+
+    JL_ASSERT_SUCCESS( JlParserCreate( baseFlags | JL_PARSE_FLAGS_RAW_STRINGS, &parser ) );
+
+    // Strings that have not been read are output as they were in the input. Empty strings are not stored. Json5
+    // strings with escapes are always unescaped first as they may have escapes that Json1 does not allow.
+    JL_ASSERT_SUCCESS( JlParserParse( parser, json, strlen( json ), &objectTree, NULL ) );
+    JL_ASSERT_SUCCESS( JlOutputJson( objectTree, false, &outputJson ) );
+    JL_ASSERT( 0 == strcmp( outputJson, IsJson5 ? unescapedOutput : rawOutput ) );
+    JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &outputJson ) );
+
+    // Unless the output flags need them changed
+    JL_ASSERT_SUCCESS( JlOutputJsonEx( objectTree, JL_OUTPUT_FLAGS_ASCII, &outputJson ) );
+    JL_ASSERT( 0 == strcmp( outputJson, "[\"abc\",\"a\\\"b\\u00e9/\",null,{\"key\":\"x\\ty\"}]" ) );
+    JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &outputJson ) );
+
+    // Strings are unescaped when read, and output normally after that
+    JL_ASSERT_SUCCESS( JlGetObjectListNextItem( objectTree, &object, &enumerator ) );
+    JL_ASSERT_SUCCESS( JlGetObjectString( object, &string ) );
+    JL_ASSERT( 0 == strcmp( string, "abc" ) );
+    JL_ASSERT_SUCCESS( JlGetObjectListNextItem( objectTree, &object, &enumerator ) );
+    JL_ASSERT_SUCCESS( JlGetObjectString( object, &string ) );
+    JL_ASSERT( 0 == strcmp( string, "a\"b\xc3\xa9/" ) );
+    JL_ASSERT_SUCCESS( JlGetObjectListNextItem( objectTree, &object, &enumerator ) );
+    JL_ASSERT_SUCCESS( JlGetObjectString( object, &string ) );
+    JL_ASSERT_NULL( string );
+    JL_ASSERT_SUCCESS( JlGetObjectListNextItem( objectTree, &object, &enumerator ) );
+    JL_ASSERT_SUCCESS( JlGetStringFromDictionaryByKey( object, "key", &string ) );
+    JL_ASSERT( 0 == strcmp( string, "x\ty" ) );
+    JL_ASSERT_SUCCESS( JlOutputJson( objectTree, false, &outputJson ) );
+    JL_ASSERT( 0 == strcmp( outputJson, unescapedOutput ) );
+    JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &outputJson ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+    // A string that is set, or freed, before it is read
+    JL_ASSERT_SUCCESS( JlParserParse( parser, json, strlen( json ), &objectTree, NULL ) );
+    enumerator = NULL;
+    JL_ASSERT_SUCCESS( JlGetObjectListNextItem( objectTree, &object, &enumerator ) );
+    JL_ASSERT_SUCCESS( JlSetObjectString( object, "new" ) );
+    JL_ASSERT_SUCCESS( JlOutputJson( objectTree, false, &outputJson ) );
+    JL_ASSERT( 0 == strcmp( outputJson, IsJson5 ? "[\"new\",\"a\\\"b\xc3\xa9/\",null,{\"key\":\"x\\ty\"}]"
+                                                : "[\"new\",\"a\\\"b\\u00e9\\/\",null,{\"key\":\"x\\ty\"}]" ) );
+    JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &outputJson ) );
+    JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+
+    // Invalid escapes are still found while parsing
+    JL_ASSERT_STATUS( JlParserParse( parser, badJson, strlen( badJson ), &objectTree, &rawErrorAtPos ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT_NULL( objectTree );
+    JL_ASSERT_STATUS( JlParseJsonEx( badJson, IsJson5, &objectTree, &errorAtPos ), JL_STATUS_INVALID_DATA );
+    JL_ASSERT( errorAtPos == rawErrorAtPos );
+
+    if( IsJson5 )
+    {
+        // Single quoted strings and Json5 escapes are changed to Json1 when output
+        JL_ASSERT_SUCCESS( JlParserParse( parser, json5, strlen( json5 ), &objectTree, NULL ) );
+        JL_ASSERT_SUCCESS( JlOutputJson( objectTree, false, &outputJson ) );
+        JL_ASSERT( 0 == strcmp( outputJson, "[\"abc\",\"ab\",\"c\"]" ) );
+        JL_ASSERT_SUCCESS( JlFreeJsonStringBuffer( &outputJson ) );
+        JL_ASSERT_SUCCESS( JlFreeObjectTree( &objectTree ) );
+    }
+
+    JL_ASSERT_SUCCESS( JlParserFree( &parser ) );
+
+    return TestReturn;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  STUBS
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1381,6 +3860,38 @@ static WJTL_STATUS TestInvalidValues_Json1( void ) { return TestInvalidValues( f
 static WJTL_STATUS TestInvalidValues_Json5( void ) { return TestInvalidValues( true ); }
 static WJTL_STATUS TestWhiteSpace_Json1( void ) { return TestWhiteSpace( false ); }
 static WJTL_STATUS TestWhiteSpace_Json5( void ) { return TestWhiteSpace( true ); }
+static WJTL_STATUS TestParseBuffer_Json1( void ) { return TestParseBuffer( false ); }
+static WJTL_STATUS TestParseBuffer_Json5( void ) { return TestParseBuffer( true ); }
+static WJTL_STATUS TestParserFeed_Json1( void ) { return TestParserFeed( false ); }
+static WJTL_STATUS TestParserFeed_Json5( void ) { return TestParserFeed( true ); }
+static WJTL_STATUS TestValidate_Json1( void ) { return TestValidate( false ); }
+static WJTL_STATUS TestValidate_Json5( void ) { return TestValidate( true ); }
+static WJTL_STATUS TestInSitu_Json1( void ) { return TestInSitu( false ); }
+static WJTL_STATUS TestInSitu_Json5( void ) { return TestInSitu( true ); }
+static WJTL_STATUS TestLazy_Json1( void ) { return TestLazy( false ); }
+static WJTL_STATUS TestLazy_Json5( void ) { return TestLazy( true ); }
+static WJTL_STATUS TestProjection_Json1( void ) { return TestProjection( false ); }
+static WJTL_STATUS TestProjection_Json5( void ) { return TestProjection( true ); }
+static WJTL_STATUS TestParseKeys_Json1( void ) { return TestParseKeys( false ); }
+static WJTL_STATUS TestParseKeys_Json5( void ) { return TestParseKeys( true ); }
+static WJTL_STATUS TestNextDocument_Json1( void ) { return TestNextDocument( false ); }
+static WJTL_STATUS TestNextDocument_Json5( void ) { return TestNextDocument( true ); }
+static WJTL_STATUS TestNdjsonParallel_Json1( void ) { return TestNdjsonParallel( false ); }
+static WJTL_STATUS TestNdjsonParallel_Json5( void ) { return TestNdjsonParallel( true ); }
+static WJTL_STATUS TestParallelList_Json1( void ) { return TestParallelList( false ); }
+static WJTL_STATUS TestParallelList_Json5( void ) { return TestParallelList( true ); }
+static WJTL_STATUS TestParseIov_Json1( void ) { return TestParseIov( false ); }
+static WJTL_STATUS TestParseIov_Json5( void ) { return TestParseIov( true ); }
+static WJTL_STATUS TestParseFile_Json1( void ) { return TestParseFile( false ); }
+static WJTL_STATUS TestParseFile_Json5( void ) { return TestParseFile( true ); }
+static WJTL_STATUS TestParseWithBudget_Json1( void ) { return TestParseWithBudget( false ); }
+static WJTL_STATUS TestParseWithBudget_Json5( void ) { return TestParseWithBudget( true ); }
+static WJTL_STATUS TestParseLimits_Json1( void ) { return TestParseLimits( false ); }
+static WJTL_STATUS TestParseLimits_Json5( void ) { return TestParseLimits( true ); }
+static WJTL_STATUS TestRawNumbers_Json1( void ) { return TestRawNumbers( false ); }
+static WJTL_STATUS TestRawNumbers_Json5( void ) { return TestRawNumbers( true ); }
+static WJTL_STATUS TestRawStrings_Json1( void ) { return TestRawStrings( false ); }
+static WJTL_STATUS TestRawStrings_Json5( void ) { return TestRawStrings( true ); }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  PUBLIC FUNCTIONS
@@ -1414,4 +3925,39 @@ void
     WjTestLib_AddTest( TestWhiteSpace_Json1, "White Space (Json1)" );
     WjTestLib_AddTest( TestWhiteSpace_Json5, "White Space (Json5)" );
     WjTestLib_AddTest( TestComments, "Comments (Json5)" );
+    WjTestLib_AddTest( TestParseBuffer_Json1, "Parse buffer (Json1)" );
+    WjTestLib_AddTest( TestParseBuffer_Json5, "Parse buffer (Json5)" );
+    WjTestLib_AddTest( TestParserReuse, "Parser reuse" );
+    WjTestLib_AddTest( TestStringOwnership, "String ownership" );
+    WjTestLib_AddTest( TestParserFeed_Json1, "Parser feed (Json1)" );
+    WjTestLib_AddTest( TestParserFeed_Json5, "Parser feed (Json5)" );
+    WjTestLib_AddTest( TestValidate_Json1, "Validate (Json1)" );
+    WjTestLib_AddTest( TestValidate_Json5, "Validate (Json5)" );
+    WjTestLib_AddTest( TestInSitu_Json1, "In-situ (Json1)" );
+    WjTestLib_AddTest( TestInSitu_Json5, "In-situ (Json5)" );
+    WjTestLib_AddTest( TestLazy_Json1, "Lazy (Json1)" );
+    WjTestLib_AddTest( TestLazy_Json5, "Lazy (Json5)" );
+    WjTestLib_AddTest( TestProjection_Json1, "Projection (Json1)" );
+    WjTestLib_AddTest( TestProjection_Json5, "Projection (Json5)" );
+    WjTestLib_AddTest( TestParseKeys_Json1, "Parse keys (Json1)" );
+    WjTestLib_AddTest( TestParseKeys_Json5, "Parse keys (Json5)" );
+    WjTestLib_AddTest( TestNextDocument_Json1, "Next document (Json1)" );
+    WjTestLib_AddTest( TestNextDocument_Json5, "Next document (Json5)" );
+    WjTestLib_AddTest( TestNdjsonParallel_Json1, "NDJSON parallel (Json1)" );
+    WjTestLib_AddTest( TestNdjsonParallel_Json5, "NDJSON parallel (Json5)" );
+    WjTestLib_AddTest( TestParallelList_Json1, "Parallel list (Json1)" );
+    WjTestLib_AddTest( TestParallelList_Json5, "Parallel list (Json5)" );
+    WjTestLib_AddTest( TestParseIov_Json1, "Parse iov (Json1)" );
+    WjTestLib_AddTest( TestParseIov_Json5, "Parse iov (Json5)" );
+    WjTestLib_AddTest( TestParseFile_Json1, "Parse file (Json1)" );
+    WjTestLib_AddTest( TestParseFile_Json5, "Parse file (Json5)" );
+    WjTestLib_AddTest( TestParseWithBudget_Json1, "Parse with budget (Json1)" );
+    WjTestLib_AddTest( TestParseWithBudget_Json5, "Parse with budget (Json5)" );
+    WjTestLib_AddTest( TestBudgetThenFeed, "Parse with budget then feed" );
+    WjTestLib_AddTest( TestParseLimits_Json1, "Parse limits (Json1)" );
+    WjTestLib_AddTest( TestParseLimits_Json5, "Parse limits (Json5)" );
+    WjTestLib_AddTest( TestRawNumbers_Json1, "Raw numbers (Json1)" );
+    WjTestLib_AddTest( TestRawNumbers_Json5, "Raw numbers (Json5)" );
+    WjTestLib_AddTest( TestRawStrings_Json1, "Raw strings (Json1)" );
+    WjTestLib_AddTest( TestRawStrings_Json5, "Raw strings (Json5)" );
 }
@@ -1762,6 +1762,66 @@ WJTL_STATUS
     return TestReturn;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  TestUnmarshallFromBuffer
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static
+WJTL_STATUS
+    TestUnmarshallFromBuffer
+    (
+        void
+    )
+{
+    WJTL_STATUS TestReturn = WJTL_STATUS_SUCCESS;
+
+    typedef struct
+    {
+        uint32_t    Num;
+        char*       Str;
+    } TestStruct;
+
+    JlMarshallElement marshalTestStruct[] =
+    {
+        JlMarshallUnsigned( TestStruct, Num, "Num" ),
+        JlMarshallString( TestStruct, Str, "Str" ),
+    };
+
+    TestStruct theStruct = {0};
+    size_t errorAtPos = 0;
+    char const json[] = "{\"Num\":1234,\"Str\":\"abc\"}{\"Num\":5678}";
+    size_t const firstDocLen = 24;
+
+    // Only the first document is within the supplied length
+    JL_ASSERT_SUCCESS( JlJsonBufferToStruct(
+        json, firstDocLen,
+        marshalTestStruct, NumElements(marshalTestStruct), false, false, &theStruct, &errorAtPos ) );
+    JL_ASSERT( 0 == errorAtPos );
+    JL_ASSERT( 1234 == theStruct.Num );
+    JL_ASSERT_NOT_NULL( theStruct.Str );
+    JL_ASSERT( strcmp( theStruct.Str, "abc" ) == 0 );
+
+    // Second document starts at firstDocLen
+    JL_ASSERT_SUCCESS( JlJsonBufferToStruct(
+        json + firstDocLen, sizeof(json) - 1 - firstDocLen,
+        marshalTestStruct, NumElements(marshalTestStruct), false, false, &theStruct, &errorAtPos ) );
+    JL_ASSERT( 5678 == theStruct.Num );
+    JL_ASSERT_NOT_NULL( theStruct.Str );
+    JL_ASSERT( strcmp( theStruct.Str, "abc" ) == 0 );
+
+    // Truncated
+    JL_ASSERT_STATUS( JlJsonBufferToStruct(
+        json, firstDocLen - 1,
+        marshalTestStruct, NumElements(marshalTestStruct), false, false, &theStruct, &errorAtPos ), JL_STATUS_END_OF_DATA );
+
+    JL_ASSERT_STATUS( JlJsonBufferToStruct(
+        NULL, 0,
+        marshalTestStruct, NumElements(marshalTestStruct), false, false, &theStruct, &errorAtPos ), JL_STATUS_INVALID_PARAMETER );
+
+    JL_ASSERT_SUCCESS( JlUnmarshallFreeStructAllocs( marshalTestStruct, NumElements(marshalTestStruct), &theStruct ) );
+
+    return TestReturn;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  PUBLIC FUNCTIONS
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1793,4 +1853,5 @@ void
     WjTestLib_AddTest( TestUnmarshallPartialFills, "PartialFills" );
     WjTestLib_AddTest( TestUnmarshallLists, "Lists" );
     WjTestLib_AddTest( TestUnmarshallBinary, "BinaryData" );
+    WjTestLib_AddTest( TestUnmarshallFromBuffer, "FromBuffer" );
 }
@@ -62,75 +62,6 @@ bool
     return itemExists;
 }
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//  ReadFileIntoMemory
-//
-//  Reads an entire text file into memory. Allocates the space for it. This will be read as a string and zero
-//  terminated.
-//  Returns true if success.
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-static
-bool
-    ReadFileIntoMemory
-    (
-        char const*     Filename,                   // [in]
-        char**          pStringData                 // [out]
-    )
-{
-    bool success;
-
-    *pStringData = NULL;
-
-    FILE* file = fopen( Filename, "rt" );
-    if( NULL != file )
-    {
-        fseek( file, 0, SEEK_END );
-        int fileLen = ftell( file );
-        fseek( file, 0, SEEK_SET );
-
-        if( fileLen > 0 )
-        {
-            // allocate buffer
-            char* buffer = malloc( fileLen + 1 );
-            if( NULL != buffer )
-            {
-                int amount;
-                amount = (int)fread( buffer, 1, fileLen, file );
-
-                if( amount <= fileLen && amount > 0 )
-                {
-                    buffer[amount] = 0;     // zero terminate
-                    *pStringData = buffer;
-                    success = true;
-                }
-                else
-                {
-                    // Failed to read file
-                    success = false;
-                }
-            }
-            else
-            {
-                // Out of memory
-                success = false;
-            }
-        }
-        else
-        {
-            // Failed to get file length
-            success = false;
-        }
-
-        fclose( file );
-    }
-    else
-    {
-        success = false;
-    }
-
-    return success;
-}
-
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  PUBLIC FUNCTIONS
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -178,8 +109,9 @@ main
     else
     {
         char const* inputFilename = ArgV[1];
-        bool success;
-        char* inputJsonString = NULL;
+        JL_STATUS jlStatus;
+        size_t errorAtPos = 0;
+        JlDataObject* jsonObject = NULL;
 
         // Create output option flags.
         JL_OUTPUT_FLAGS outputFlags =
@@ -191,47 +123,37 @@ main
             |   ( outputSingleQuote ? JL_OUTPUT_FLAGS_J5_SINGLE_QUOTES : 0 )
             |   ( outputJson5 ? JL_OUTPUT_FLAGS_JSON5 : 0 );
 
-        success = ReadFileIntoMemory( inputFilename, &inputJsonString );
-        if( success )
+        // The file is mapped and parsed in place, so there is no limit on its size other than the address space.
+        jlStatus = JlParseJsonFile( inputFilename, true, &jsonObject, &errorAtPos );
+        if( JL_STATUS_SUCCESS == jlStatus )
         {
-            JL_STATUS jlStatus;
-            size_t errorAtPos = 0;
-            JlDataObject* jsonObject = NULL;
-
-            jlStatus = JlParseJson( inputJsonString, &jsonObject, &errorAtPos );
+            char* outputJsonString = NULL;
+            jlStatus = JlOutputJsonEx( jsonObject, outputFlags, &outputJsonString );
             if( JL_STATUS_SUCCESS == jlStatus )
             {
-                char* outputJsonString = NULL;
-                jlStatus = JlOutputJsonEx( jsonObject, outputFlags, &outputJsonString );
-                if( JL_STATUS_SUCCESS == jlStatus )
-                {
-                    // Print out the new formatted Json.
-                    printf( "%s", outputJsonString );
-
-                    JlFreeJsonStringBuffer( &outputJsonString );
-                }
-                else
-                {
-                    printf( "Failed to output json\n" );
-                    result = 4;
-                }
-
-                JlFreeObjectTree( &jsonObject );
+                // Print out the new formatted Json.
+                printf( "%s", outputJsonString );
+
+                JlFreeJsonStringBuffer( &outputJsonString );
             }
             else
             {
-                printf( "Failed to parse json in file: %s Position: %u\n", inputFilename, (uint32_t)errorAtPos );
-                result = 3;
+                printf( "Failed to output json\n" );
+                result = 4;
             }
 
-            free( inputJsonString );
+            JlFreeObjectTree( &jsonObject );
         }
-        else
+        else if( JL_STATUS_FILE_ERROR == jlStatus )
         {
             printf( "Failed to read file: %s\n", inputFilename );
             result = 2;
         }
-
+        else
+        {
+            printf( "Failed to parse json in file: %s Position: %llu\n", inputFilename, (unsigned long long)errorAtPos );
+            result = 3;
+        }
     }
 
     return result;